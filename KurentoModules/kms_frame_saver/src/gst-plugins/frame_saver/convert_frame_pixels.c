@@ -0,0 +1,1323 @@
+/*
+ * ======================================================================================
+ * File:        convert_frame_pixels.c
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Swizzles packed RGB rows by SSSE3 pshufb
+ *              3. 2026-10-17               Y samples as GRAY8 rows and GRAY frame views
+ *              4. 2026-10-17               Scales frames down by box filters
+ *              5. 2026-10-17               Cropped frame views
+ *
+ * Description: Converts planar, semi-planar and packed YUV frames, any RGB layout and
+ *              GRAY frames to RGB24. Non-planar YUV samples are gathered in chunks and
+ *              converted by the same fixed-point kernels as I420. The SSE4.1, AVX2 and
+ *              AVX-512BW kernels are built with per-function target attributes and are
+ *              selected at runtime by cpuid, else the scalar kernel is used.
+ *
+ *              All kernels produce the same bytes as the scalar kernel, which keeps the
+ *              approximations of the original I420 decoder:
+ *
+ *                  D = (88 * Cb + 184 * Cr) >> 8      approx. (0.3455 * Cb) + (0.7169 * Cr)
+ *                  E = (455 * Cb) >> 8                approx. (1.7790 * Cb)
+ *                  F = (360 * Cr) >> 8                approx. (1.4065 * Cr)
+ *
+ *                  G = Y - D,   B = Y + E,   R = Y + F,   each clamped to [0,255]
+ *
+ *              The SIMD kernels compute D as (11 * Cb + 23 * Cr) >> 5, and E,F by the
+ *              high half of (Cb << 8) * 455 and (Cr << 8) * 360, hence all products fit
+ *              in 16-bit lanes while the results remain bit-exact.
+ *
+ *              Packed RGB rows of 3 or 4 bytes per pixel in any order (e.g. BGR, BGRx,
+ *              xRGB) are reordered by one pshufb per 16 loaded bytes --- no frame copy
+ *              is made, and padding or alpha bytes are dropped on the way to RGB24.
+ *
+ *              For grayscale images the Y samples of YUV frames are described as a GRAY
+ *              frame which points into the mapped buffer (no conversion, no chroma), and
+ *              only RGB frames need their luma computed.
+ *
+ *              Frames are scaled down (e.g. to thumbnails) before conversion, in their own
+ *              family: YUV to I420, RGB to RGB24, GRAY to GRAY. Each sample of the scaled
+ *              frame is the mean of the box of samples it covers. The rows of a box are
+ *              summed into 16-bit column sums by the kernel's SIMD adder (at most 257
+ *              rows, hence at most 128:1), then the columns of each box are summed.
+ *
+ *              Frames are cropped (e.g. to a region of interest) by views which point
+ *              into the mapped buffer at the rectangle's first samples --- nothing
+ *              outside of the rectangle is read, converted or copied.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "convert_frame_pixels.h"
+
+#include <string.h>
+
+
+#if defined(__x86_64__) || defined(__i386__)
+
+    // intrinsics of target attributes need GCC 4.9 --- AVX-512BW needs GCC 5
+    #if defined(__clang__) || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))
+        #define _HAS_X86_KERNELS_
+        #include <immintrin.h>
+    #endif
+
+    #if defined(__clang__) || (__GNUC__ >= 5)
+        #define _HAS_AVX512_KERNEL_
+    #endif
+
+#endif
+
+#ifdef _HAS_X86_KERNELS_
+    #define INIT_CPU_FEATURES()     __builtin_cpu_init()
+#else
+    #define INIT_CPU_FEATURES()     do { } while (0)
+#endif
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef void (*ConvertRowFunc_t)(uint8_t       * aRgbPtr,
+                                 const uint8_t * aLumaPtr,
+                                 const uint8_t * aCbPtr,
+                                 const uint8_t * aCrPtr,
+                                 int             aNumCols);
+
+typedef void (*SwizzleRowFunc_t)(uint8_t       * aRgbPtr,
+                                 const uint8_t * aPixelsPtr,
+                                 const int     * aOffsetsArray,
+                                 int             aPstride,
+                                 int             aNumCols);
+
+typedef void (*AddRowFunc_t)(uint16_t      * aSumsPtr,
+                             const uint8_t * aRowPtr,
+                             int             aNumBytes);
+
+typedef struct _PixelsKernel_t
+{
+    const char        * name;
+    int              (* is_usable)(void);
+    ConvertRowFunc_t    I420_row_func;
+    SwizzleRowFunc_t    RGB_row_func;
+    AddRowFunc_t        add_row_func;
+
+} PixelsKernel_t;
+
+typedef struct _PixelsPlane_t
+{
+    const uint8_t     * samples_ptr;            // first sample of the component
+    int                 stride,
+                        pstride,
+                        num_cols,
+                        num_rows;
+
+} PixelsPlane_t;
+
+
+#ifndef MIN
+    #define MIN(A,B)    ( ((A) < (B)) ? (A) : (B) )
+#endif
+
+#ifndef MAX
+    #define MAX(A,B)    ( ((A) > (B)) ? (A) : (B) )
+#endif
+
+#define GATHER_COLS     256     // pixels per gathered chunk --- a multiple of 64
+
+#define CLAMP_8BITS(X)  { X = ((X) < 0) ? 0 : (X);   X = ((X) > 255) ? 255 : (X); }
+
+#define MAX_SCALE_DOWN  128     // a box of 257 rows of 255 still fits 16-bit sums
+
+#define SUMS_ALIGN(N)   ( ((N) + 63) & ~((size_t) 63) )
+
+
+//=======================================================================================
+// synopsis: do_convert_I420_row_scalar(aRgbPtr, aLumaPtr, aCbPtr, aCrPtr, aNumCols)
+//
+// reference kernel --- converts one row of I420 samples to RGB24
+//=======================================================================================
+static void do_convert_I420_row_scalar(uint8_t       * aRgbPtr,
+                                       const uint8_t * aLumaPtr,
+                                       const uint8_t * aCbPtr,
+                                       const uint8_t * aCrPtr,
+                                       int             aNumCols)
+{
+    int col_index;
+
+    for ( col_index = 0;  col_index < aNumCols;  col_index += 2 )
+    {
+        int32_t U = (int32_t) aCbPtr[col_index >> 1] - 128;
+        int32_t V = (int32_t) aCrPtr[col_index >> 1] - 128;
+
+        int32_t D = ( ((88 * U) + (184 * V)) >> 8 );
+        int32_t E = ( (455 * U) >> 8 );
+        int32_t F = ( (360 * V) >> 8 );
+
+        int32_t Y = aLumaPtr[col_index];
+
+        int32_t R = Y + F,   G = Y - D,   B = Y + E;
+
+        CLAMP_8BITS( R );   CLAMP_8BITS( G );   CLAMP_8BITS( B );
+
+        aRgbPtr[0] = (uint8_t) R;
+        aRgbPtr[1] = (uint8_t) G;
+        aRgbPtr[2] = (uint8_t) B;
+
+        if (col_index + 1 == aNumCols)
+        {
+            break;      // odd number of columns
+        }
+
+        Y = aLumaPtr[col_index + 1];
+
+        R = Y + F;   G = Y - D;   B = Y + E;
+
+        CLAMP_8BITS( R );   CLAMP_8BITS( G );   CLAMP_8BITS( B );
+
+        aRgbPtr[3] = (uint8_t) R;
+        aRgbPtr[4] = (uint8_t) G;
+        aRgbPtr[5] = (uint8_t) B;
+
+        aRgbPtr += 6;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_swizzle_RGB_row_scalar(aRgbPtr, aPixelsPtr, aOffsetsArray, aPstride, aNumCols)
+//
+// reference kernel --- copies the R,G,B bytes at the given offsets of each packed pixel
+//=======================================================================================
+static void do_swizzle_RGB_row_scalar(uint8_t       * aRgbPtr,
+                                      const uint8_t * aPixelsPtr,
+                                      const int     * aOffsetsArray,
+                                      int             aPstride,
+                                      int             aNumCols)
+{
+    int R_offset = aOffsetsArray[0],   G_offset = aOffsetsArray[1],   B_offset = aOffsetsArray[2];
+
+    while (--aNumCols >= 0)
+    {
+        aRgbPtr[0] = aPixelsPtr[R_offset];
+        aRgbPtr[1] = aPixelsPtr[G_offset];
+        aRgbPtr[2] = aPixelsPtr[B_offset];
+
+        aRgbPtr    += 3;
+        aPixelsPtr += aPstride;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_add_row_scalar(aSumsPtr, aRowPtr, aNumBytes)
+//
+// reference kernel --- adds each byte of a row to its 16-bit column sum
+//=======================================================================================
+static void do_add_row_scalar(uint16_t * aSumsPtr, const uint8_t * aRowPtr, int aNumBytes)
+{
+    while (--aNumBytes >= 0)
+    {
+        *aSumsPtr++ += *aRowPtr++;
+    }
+}
+
+
+static int do_is_scalar_usable(void)
+{
+    return 1;
+}
+
+
+#ifdef _HAS_X86_KERNELS_
+
+//=======================================================================================
+// synopsis: do_store_RGB24_x16(aRgbPtr, aReds, aGreens, aBlues)
+//
+// interleaves 16 red, green and blue bytes --- stores 48 bytes of RGB24 pixels
+//=======================================================================================
+__attribute__((target("sse4.1")))
+static inline void do_store_RGB24_x16(uint8_t * aRgbPtr, __m128i aReds, __m128i aGreens, __m128i aBlues)
+{
+    const __m128i r_0 = _mm_setr_epi8(   0, -128, -128,    1, -128, -128,    2, -128, -128,    3, -128, -128,    4, -128, -128,    5 );
+    const __m128i r_1 = _mm_setr_epi8(-128, -128,    6, -128, -128,    7, -128, -128,    8, -128, -128,    9, -128, -128,   10, -128 );
+    const __m128i r_2 = _mm_setr_epi8(-128,   11, -128, -128,   12, -128, -128,   13, -128, -128,   14, -128, -128,   15, -128, -128 );
+    const __m128i g_0 = _mm_setr_epi8(-128,    0, -128, -128,    1, -128, -128,    2, -128, -128,    3, -128, -128,    4, -128, -128 );
+    const __m128i g_1 = _mm_setr_epi8(   5, -128, -128,    6, -128, -128,    7, -128, -128,    8, -128, -128,    9, -128, -128,   10 );
+    const __m128i g_2 = _mm_setr_epi8(-128, -128,   11, -128, -128,   12, -128, -128,   13, -128, -128,   14, -128, -128,   15, -128 );
+    const __m128i b_0 = _mm_setr_epi8(-128, -128,    0, -128, -128,    1, -128, -128,    2, -128, -128,    3, -128, -128,    4, -128 );
+    const __m128i b_1 = _mm_setr_epi8(-128,    5, -128, -128,    6, -128, -128,    7, -128, -128,    8, -128, -128,    9, -128, -128 );
+    const __m128i b_2 = _mm_setr_epi8(  10, -128, -128,   11, -128, -128,   12, -128, -128,   13, -128, -128,   14, -128, -128,   15 );
+
+    __m128i out_0 = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8(aReds, r_0), _mm_shuffle_epi8(aGreens, g_0) ), _mm_shuffle_epi8(aBlues, b_0) );
+    __m128i out_1 = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8(aReds, r_1), _mm_shuffle_epi8(aGreens, g_1) ), _mm_shuffle_epi8(aBlues, b_1) );
+    __m128i out_2 = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8(aReds, r_2), _mm_shuffle_epi8(aGreens, g_2) ), _mm_shuffle_epi8(aBlues, b_2) );
+
+    _mm_storeu_si128( (__m128i *) (aRgbPtr +  0), out_0 );
+    _mm_storeu_si128( (__m128i *) (aRgbPtr + 16), out_1 );
+    _mm_storeu_si128( (__m128i *) (aRgbPtr + 32), out_2 );
+}
+
+
+//=======================================================================================
+// synopsis: do_convert_I420_row_sse41(aRgbPtr, aLumaPtr, aCbPtr, aCrPtr, aNumCols)
+//
+// converts 16 pixels per iteration --- the remaining pixels are converted by scalar code
+//=======================================================================================
+__attribute__((target("sse4.1")))
+static void do_convert_I420_row_sse41(uint8_t       * aRgbPtr,
+                                      const uint8_t * aLumaPtr,
+                                      const uint8_t * aCbPtr,
+                                      const uint8_t * aCrPtr,
+                                      int             aNumCols)
+{
+    const __m128i k_128 = _mm_set1_epi16(128);
+    const __m128i k_D_U = _mm_set1_epi16(11);
+    const __m128i k_D_V = _mm_set1_epi16(23);
+    const __m128i k_E_U = _mm_set1_epi16(455);
+    const __m128i k_F_V = _mm_set1_epi16(360);
+
+    int col_index = 0;
+
+    for ( ;  col_index + 16 <= aNumCols;  col_index += 16 )
+    {
+        __m128i luma = _mm_loadu_si128( (const __m128i *) (aLumaPtr + col_index) );
+
+        __m128i u = _mm_sub_epi16( _mm_cvtepu8_epi16( _mm_loadl_epi64((const __m128i *) (aCbPtr + col_index / 2)) ), k_128 );
+        __m128i v = _mm_sub_epi16( _mm_cvtepu8_epi16( _mm_loadl_epi64((const __m128i *) (aCrPtr + col_index / 2)) ), k_128 );
+
+        __m128i d = _mm_srai_epi16( _mm_add_epi16(_mm_mullo_epi16(u, k_D_U), _mm_mullo_epi16(v, k_D_V)), 5 );
+        __m128i e = _mm_mulhi_epi16( _mm_slli_epi16(u, 8), k_E_U );
+        __m128i f = _mm_mulhi_epi16( _mm_slli_epi16(v, 8), k_F_V );
+
+        __m128i y_lo = _mm_cvtepu8_epi16( luma );
+        __m128i y_hi = _mm_cvtepu8_epi16( _mm_srli_si128(luma, 8) );
+
+        __m128i reds   = _mm_packus_epi16( _mm_add_epi16(y_lo, _mm_unpacklo_epi16(f, f)),
+                                           _mm_add_epi16(y_hi, _mm_unpackhi_epi16(f, f)) );
+        __m128i greens = _mm_packus_epi16( _mm_sub_epi16(y_lo, _mm_unpacklo_epi16(d, d)),
+                                           _mm_sub_epi16(y_hi, _mm_unpackhi_epi16(d, d)) );
+        __m128i blues  = _mm_packus_epi16( _mm_add_epi16(y_lo, _mm_unpacklo_epi16(e, e)),
+                                           _mm_add_epi16(y_hi, _mm_unpackhi_epi16(e, e)) );
+
+        do_store_RGB24_x16(aRgbPtr + col_index * 3, reds, greens, blues);
+    }
+
+    do_convert_I420_row_scalar(aRgbPtr + col_index * 3,
+                               aLumaPtr + col_index,
+                               aCbPtr + col_index / 2,
+                               aCrPtr + col_index / 2,
+                               aNumCols - col_index);
+}
+
+
+//=======================================================================================
+// synopsis: do_convert_I420_row_avx2(aRgbPtr, aLumaPtr, aCbPtr, aCrPtr, aNumCols)
+//
+// converts 32 pixels per iteration --- the remaining pixels are converted by scalar code
+//=======================================================================================
+__attribute__((target("avx2")))
+static void do_convert_I420_row_avx2(uint8_t       * aRgbPtr,
+                                     const uint8_t * aLumaPtr,
+                                     const uint8_t * aCbPtr,
+                                     const uint8_t * aCrPtr,
+                                     int             aNumCols)
+{
+    const __m256i k_128 = _mm256_set1_epi16(128);
+    const __m256i k_D_U = _mm256_set1_epi16(11);
+    const __m256i k_D_V = _mm256_set1_epi16(23);
+    const __m256i k_E_U = _mm256_set1_epi16(455);
+    const __m256i k_F_V = _mm256_set1_epi16(360);
+
+    int col_index = 0;
+
+    for ( ;  col_index + 32 <= aNumCols;  col_index += 32 )
+    {
+        __m256i luma = _mm256_loadu_si256( (const __m256i *) (aLumaPtr + col_index) );
+
+        __m256i u = _mm256_sub_epi16( _mm256_cvtepu8_epi16( _mm_loadu_si128((const __m128i *) (aCbPtr + col_index / 2)) ), k_128 );
+        __m256i v = _mm256_sub_epi16( _mm256_cvtepu8_epi16( _mm_loadu_si128((const __m128i *) (aCrPtr + col_index / 2)) ), k_128 );
+
+        __m256i d = _mm256_srai_epi16( _mm256_add_epi16(_mm256_mullo_epi16(u, k_D_U), _mm256_mullo_epi16(v, k_D_V)), 5 );
+        __m256i e = _mm256_mulhi_epi16( _mm256_slli_epi16(u, 8), k_E_U );
+        __m256i f = _mm256_mulhi_epi16( _mm256_slli_epi16(v, 8), k_F_V );
+
+        // unpack works within 128-bit lanes --- so the chroma quads are reordered first
+        d = _mm256_permute4x64_epi64(d, 0xD8);
+        e = _mm256_permute4x64_epi64(e, 0xD8);
+        f = _mm256_permute4x64_epi64(f, 0xD8);
+
+        __m256i y_lo = _mm256_cvtepu8_epi16( _mm256_castsi256_si128(luma) );
+        __m256i y_hi = _mm256_cvtepu8_epi16( _mm256_extracti128_si256(luma, 1) );
+
+        __m256i reds   = _mm256_packus_epi16( _mm256_add_epi16(y_lo, _mm256_unpacklo_epi16(f, f)),
+                                              _mm256_add_epi16(y_hi, _mm256_unpackhi_epi16(f, f)) );
+        __m256i greens = _mm256_packus_epi16( _mm256_sub_epi16(y_lo, _mm256_unpacklo_epi16(d, d)),
+                                              _mm256_sub_epi16(y_hi, _mm256_unpackhi_epi16(d, d)) );
+        __m256i blues  = _mm256_packus_epi16( _mm256_add_epi16(y_lo, _mm256_unpacklo_epi16(e, e)),
+                                              _mm256_add_epi16(y_hi, _mm256_unpackhi_epi16(e, e)) );
+
+        // pack works within 128-bit lanes too --- restore the order of the pixels
+        reds   = _mm256_permute4x64_epi64(reds,   0xD8);
+        greens = _mm256_permute4x64_epi64(greens, 0xD8);
+        blues  = _mm256_permute4x64_epi64(blues,  0xD8);
+
+        do_store_RGB24_x16(aRgbPtr + col_index * 3,
+                           _mm256_castsi256_si128(reds),
+                           _mm256_castsi256_si128(greens),
+                           _mm256_castsi256_si128(blues));
+
+        do_store_RGB24_x16(aRgbPtr + col_index * 3 + 48,
+                           _mm256_extracti128_si256(reds,   1),
+                           _mm256_extracti128_si256(greens, 1),
+                           _mm256_extracti128_si256(blues,  1));
+    }
+
+    do_convert_I420_row_scalar(aRgbPtr + col_index * 3,
+                               aLumaPtr + col_index,
+                               aCbPtr + col_index / 2,
+                               aCrPtr + col_index / 2,
+                               aNumCols - col_index);
+}
+
+
+//=======================================================================================
+// synopsis: do_swizzle_RGB_row_ssse3(aRgbPtr, aPixelsPtr, aOffsetsArray, aPstride, aNumCols)
+//
+// reorders 5 pixels of 3 bytes, or 4 pixels of 4 bytes, per pshufb --- the rest by scalar code
+//=======================================================================================
+__attribute__((target("ssse3")))
+static void do_swizzle_RGB_row_ssse3(uint8_t       * aRgbPtr,
+                                     const uint8_t * aPixelsPtr,
+                                     const int     * aOffsetsArray,
+                                     int             aPstride,
+                                     int             aNumCols)
+{
+    int col_index = 0;
+
+    if ( (aPstride == 3) || (aPstride == 4) )
+    {
+        int num_pixels = (aPstride == 3) ? 5 : 4;     // whole pixels in 16 bytes
+
+        int8_t lanes_array[16];
+
+        int lane;
+
+        for ( lane = 0;  lane < 16;  ++lane )
+        {
+            int pixel = lane / 3;
+
+            lanes_array[lane] = (pixel < num_pixels) ? (int8_t) ((pixel * aPstride) + aOffsetsArray[lane % 3]) : -128;
+        }
+
+        const __m128i lanes = _mm_loadu_si128( (const __m128i *) lanes_array );
+
+        // each store writes 16 bytes --- its last 1 or 4 bytes are overwritten by the next
+        // store, hence loads and stores stop 6 pixels short of the end of the row
+        for ( ;  col_index + 6 <= aNumCols;  col_index += num_pixels )
+        {
+            __m128i pixels = _mm_loadu_si128( (const __m128i *) (aPixelsPtr + (col_index * aPstride)) );
+
+            _mm_storeu_si128( (__m128i *) (aRgbPtr + (col_index * 3)), _mm_shuffle_epi8(pixels, lanes) );
+        }
+    }
+
+    do_swizzle_RGB_row_scalar(aRgbPtr + (col_index * 3),
+                              aPixelsPtr + (col_index * aPstride),
+                              aOffsetsArray,
+                              aPstride,
+                              aNumCols - col_index);
+}
+
+
+//=======================================================================================
+// synopsis: do_add_row_sse41(aSumsPtr, aRowPtr, aNumBytes)
+//
+// adds 16 bytes per step to their column sums --- the rest by scalar code
+//=======================================================================================
+__attribute__((target("sse4.1")))
+static void do_add_row_sse41(uint16_t * aSumsPtr, const uint8_t * aRowPtr, int aNumBytes)
+{
+    const __m128i zeros = _mm_setzero_si128();
+
+    int index = 0;
+
+    for ( ;  index + 16 <= aNumBytes;  index += 16 )
+    {
+        __m128i bytes = _mm_loadu_si128( (const __m128i *) (aRowPtr + index) );
+
+        __m128i * sums_ptr = (__m128i *) (aSumsPtr + index);
+
+        _mm_storeu_si128(sums_ptr,     _mm_add_epi16(_mm_loadu_si128(sums_ptr),     _mm_unpacklo_epi8(bytes, zeros)));
+        _mm_storeu_si128(sums_ptr + 1, _mm_add_epi16(_mm_loadu_si128(sums_ptr + 1), _mm_unpackhi_epi8(bytes, zeros)));
+    }
+
+    do_add_row_scalar(aSumsPtr + index, aRowPtr + index, aNumBytes - index);
+}
+
+
+//=======================================================================================
+// synopsis: do_add_row_avx2(aSumsPtr, aRowPtr, aNumBytes)
+//
+// adds 32 bytes per step to their column sums --- the rest by scalar code
+//=======================================================================================
+__attribute__((target("avx2")))
+static void do_add_row_avx2(uint16_t * aSumsPtr, const uint8_t * aRowPtr, int aNumBytes)
+{
+    int index = 0;
+
+    for ( ;  index + 32 <= aNumBytes;  index += 32 )
+    {
+        __m256i lows  = _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i *) (aRowPtr + index) ) );
+        __m256i highs = _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i *) (aRowPtr + index + 16) ) );
+
+        __m256i * sums_ptr = (__m256i *) (aSumsPtr + index);
+
+        _mm256_storeu_si256(sums_ptr,     _mm256_add_epi16(_mm256_loadu_si256(sums_ptr),     lows));
+        _mm256_storeu_si256(sums_ptr + 1, _mm256_add_epi16(_mm256_loadu_si256(sums_ptr + 1), highs));
+    }
+
+    do_add_row_sse41(aSumsPtr + index, aRowPtr + index, aNumBytes - index);
+}
+
+
+static int do_is_sse41_usable(void)
+{
+    return __builtin_cpu_supports("sse4.1");
+}
+
+
+static int do_is_avx2_usable(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif  // _HAS_X86_KERNELS_
+
+
+#ifdef _HAS_AVX512_KERNEL_
+
+//=======================================================================================
+// synopsis: do_convert_I420_row_avx512(aRgbPtr, aLumaPtr, aCbPtr, aCrPtr, aNumCols)
+//
+// converts 64 pixels per iteration --- the remaining pixels are converted by AVX2 code
+//=======================================================================================
+__attribute__((target("avx512bw")))
+static void do_convert_I420_row_avx512(uint8_t       * aRgbPtr,
+                                       const uint8_t * aLumaPtr,
+                                       const uint8_t * aCbPtr,
+                                       const uint8_t * aCrPtr,
+                                       int             aNumCols)
+{
+    const __m512i k_128 = _mm512_set1_epi16(128);
+    const __m512i k_D_U = _mm512_set1_epi16(11);
+    const __m512i k_D_V = _mm512_set1_epi16(23);
+    const __m512i k_E_U = _mm512_set1_epi16(455);
+    const __m512i k_F_V = _mm512_set1_epi16(360);
+
+    // quad 'n' of the chroma goes to the low half of lane 'n' --- quad 'n+4' to its high half
+    const __m512i quads = _mm512_setr_epi64(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m512i packs = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+
+    int col_index = 0;
+
+    for ( ;  col_index + 64 <= aNumCols;  col_index += 64 )
+    {
+        __m512i luma = _mm512_loadu_si512( (const void *) (aLumaPtr + col_index) );
+
+        __m512i u = _mm512_sub_epi16( _mm512_cvtepu8_epi16( _mm256_loadu_si256((const __m256i *) (aCbPtr + col_index / 2)) ), k_128 );
+        __m512i v = _mm512_sub_epi16( _mm512_cvtepu8_epi16( _mm256_loadu_si256((const __m256i *) (aCrPtr + col_index / 2)) ), k_128 );
+
+        __m512i d = _mm512_srai_epi16( _mm512_add_epi16(_mm512_mullo_epi16(u, k_D_U), _mm512_mullo_epi16(v, k_D_V)), 5 );
+        __m512i e = _mm512_mulhi_epi16( _mm512_slli_epi16(u, 8), k_E_U );
+        __m512i f = _mm512_mulhi_epi16( _mm512_slli_epi16(v, 8), k_F_V );
+
+        d = _mm512_permutexvar_epi64(quads, d);
+        e = _mm512_permutexvar_epi64(quads, e);
+        f = _mm512_permutexvar_epi64(quads, f);
+
+        __m512i y_lo = _mm512_cvtepu8_epi16( _mm512_castsi512_si256(luma) );
+        __m512i y_hi = _mm512_cvtepu8_epi16( _mm512_extracti64x4_epi64(luma, 1) );
+
+        __m512i reds   = _mm512_packus_epi16( _mm512_add_epi16(y_lo, _mm512_unpacklo_epi16(f, f)),
+                                              _mm512_add_epi16(y_hi, _mm512_unpackhi_epi16(f, f)) );
+        __m512i greens = _mm512_packus_epi16( _mm512_sub_epi16(y_lo, _mm512_unpacklo_epi16(d, d)),
+                                              _mm512_sub_epi16(y_hi, _mm512_unpackhi_epi16(d, d)) );
+        __m512i blues  = _mm512_packus_epi16( _mm512_add_epi16(y_lo, _mm512_unpacklo_epi16(e, e)),
+                                              _mm512_add_epi16(y_hi, _mm512_unpackhi_epi16(e, e)) );
+
+        // pack works within 128-bit lanes --- restore the order of the pixels
+        reds   = _mm512_permutexvar_epi64(packs, reds);
+        greens = _mm512_permutexvar_epi64(packs, greens);
+        blues  = _mm512_permutexvar_epi64(packs, blues);
+
+        uint8_t * rgb_ptr = aRgbPtr + col_index * 3;
+
+        do_store_RGB24_x16(rgb_ptr +   0, _mm512_castsi512_si128(reds), _mm512_castsi512_si128(greens), _mm512_castsi512_si128(blues));
+        do_store_RGB24_x16(rgb_ptr +  48, _mm512_extracti32x4_epi32(reds, 1), _mm512_extracti32x4_epi32(greens, 1), _mm512_extracti32x4_epi32(blues, 1));
+        do_store_RGB24_x16(rgb_ptr +  96, _mm512_extracti32x4_epi32(reds, 2), _mm512_extracti32x4_epi32(greens, 2), _mm512_extracti32x4_epi32(blues, 2));
+        do_store_RGB24_x16(rgb_ptr + 144, _mm512_extracti32x4_epi32(reds, 3), _mm512_extracti32x4_epi32(greens, 3), _mm512_extracti32x4_epi32(blues, 3));
+    }
+
+    do_convert_I420_row_avx2(aRgbPtr + col_index * 3,
+                             aLumaPtr + col_index,
+                             aCbPtr + col_index / 2,
+                             aCrPtr + col_index / 2,
+                             aNumCols - col_index);
+}
+
+
+static int do_is_avx512_usable(void)
+{
+    return __builtin_cpu_supports("avx512bw");
+}
+
+#endif  // _HAS_AVX512_KERNEL_
+
+
+// ordered from best to worst --- the scalar kernel is always the last one
+//
+// the AVX-512BW kernel is ranked below AVX2 --- both are bound by the 16-byte RGB24
+// interleave and the wider kernel measured slower, hence it's used only when named
+//
+// all x86 kernels swizzle RGB rows by SSSE3, which is implied by SSE4.1
+static const PixelsKernel_t The_Kernels[] =
+{
+#ifdef _HAS_X86_KERNELS_
+    { "avx2",     do_is_avx2_usable,   do_convert_I420_row_avx2,   do_swizzle_RGB_row_ssse3,  do_add_row_avx2   },
+#endif
+#ifdef _HAS_AVX512_KERNEL_
+    { "avx512bw", do_is_avx512_usable, do_convert_I420_row_avx512, do_swizzle_RGB_row_ssse3,  do_add_row_avx2   },
+#endif
+#ifdef _HAS_X86_KERNELS_
+    { "sse4.1",   do_is_sse41_usable,  do_convert_I420_row_sse41,  do_swizzle_RGB_row_ssse3,  do_add_row_sse41  },
+#endif
+    { "scalar",   do_is_scalar_usable, do_convert_I420_row_scalar, do_swizzle_RGB_row_scalar, do_add_row_scalar }
+};
+
+#define NUM_KERNELS     ( (int) (sizeof(The_Kernels) / sizeof(The_Kernels[0])) )
+
+static const PixelsKernel_t * The_Kernel_Ptr = NULL;   // NULL until the first conversion
+
+
+//=======================================================================================
+// synopsis: kernel_ptr = do_get_kernel()
+//
+// returns the selected kernel --- selects the best usable kernel on first call
+//=======================================================================================
+static const PixelsKernel_t * do_get_kernel(void)
+{
+    const PixelsKernel_t * kernel_ptr = __atomic_load_n(&The_Kernel_Ptr, __ATOMIC_ACQUIRE);
+
+    if (kernel_ptr == NULL)
+    {
+        int index = -1;
+
+        INIT_CPU_FEATURES();
+
+        while ( ! The_Kernels[++index].is_usable() )
+        {
+            continue;   // the scalar kernel is always usable
+        }
+
+        kernel_ptr = &The_Kernels[index];
+
+        __atomic_store_n(&The_Kernel_Ptr, kernel_ptr, __ATOMIC_RELEASE);
+    }
+
+    return kernel_ptr;
+}
+
+
+//=======================================================================================
+// synopsis: name = convert_pixels_get_kernel()
+//
+// returns the name of the kernel in use --- "scalar", "sse4.1", "avx2" or "avx512bw"
+//=======================================================================================
+const char * convert_pixels_get_kernel(void)
+{
+    return do_get_kernel()->name;
+}
+
+
+//=======================================================================================
+// synopsis: result = convert_pixels_set_kernel(aNamePtr)
+//
+// selects a kernel by name, "auto" selects the best one --- returns 0, else -1 if unusable
+//=======================================================================================
+int convert_pixels_set_kernel(const char * aNamePtr)
+{
+    int index = -1;
+
+    if ( (aNamePtr == NULL) || (strcmp(aNamePtr, "auto") == 0) )
+    {
+        __atomic_store_n(&The_Kernel_Ptr, NULL, __ATOMIC_RELEASE);
+
+        do_get_kernel();
+
+        return 0;
+    }
+
+    INIT_CPU_FEATURES();
+
+    while ( ++index < NUM_KERNELS )
+    {
+        if ( (strcmp(aNamePtr, The_Kernels[index].name) == 0) && The_Kernels[index].is_usable() )
+        {
+            __atomic_store_n(&The_Kernel_Ptr, &The_Kernels[index], __ATOMIC_RELEASE);
+
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+
+//=======================================================================================
+// synopsis: convert_I420_row_to_RGB24(aRgbPtr, aLumaPtr, aCbPtr, aCrPtr, aNumCols)
+//
+// converts one row of I420 samples --- chroma samples are shared by two luma samples
+//=======================================================================================
+void convert_I420_row_to_RGB24(uint8_t       * aRgbPtr,
+                               const uint8_t * aLumaPtr,
+                               const uint8_t * aCbPtr,
+                               const uint8_t * aCrPtr,
+                               int             aNumCols)
+{
+    do_get_kernel()->I420_row_func(aRgbPtr, aLumaPtr, aCbPtr, aCrPtr, aNumCols);
+}
+
+
+//=======================================================================================
+// synopsis: count = convert_I420_frame_to_RGB24(aRgbPtr, aRgbStride, aPlanes, aStrides, aCols, aRows)
+//
+// converts planar Y,U,V frame to packed RGB24 --- returns number of pixels converted
+//=======================================================================================
+int convert_I420_frame_to_RGB24(uint8_t       * aRgbPtr,
+                                int             aRgbStride,
+                                const uint8_t * aPlanesArray[3],
+                                const int       aStridesArray[3],
+                                int             aNumCols,
+                                int             aNumRows)
+{
+    int row_index;
+
+    // verify valid conditions
+    if ( (aRgbPtr == NULL) || (aNumCols < 1) || (aNumRows < 1) || (aRgbStride < aNumCols * 3) )
+    {
+        return 0;
+    }
+
+    ConvertRowFunc_t row_func = do_get_kernel()->I420_row_func;
+
+    for ( row_index = 0;  row_index < aNumRows;  ++row_index )
+    {
+        row_func(aRgbPtr + (row_index * aRgbStride),
+                 aPlanesArray[0] + (row_index * aStridesArray[0]),
+                 aPlanesArray[1] + ((row_index >> 1) * aStridesArray[1]),
+                 aPlanesArray[2] + ((row_index >> 1) * aStridesArray[2]),
+                 aNumCols);
+    }
+
+    return aNumCols * aNumRows;
+}
+
+
+//=======================================================================================
+// synopsis: do_gather_samples(aDestPtr, aSourcePtr, aPstride, aCount)
+//
+// copies samples that are interleaved with other samples into consecutive bytes
+//=======================================================================================
+static void do_gather_samples(uint8_t * aDestPtr, const uint8_t * aSourcePtr, int aPstride, int aCount)
+{
+    while (--aCount >= 0)
+    {
+        *aDestPtr++ = *aSourcePtr;
+
+        aSourcePtr += aPstride;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_convert_YUV_row(aRgbPtr, aFramePtr, aRowIndex, aRowFunc)
+//
+// converts a row of YUV samples --- non-planar samples are gathered in chunks first
+//=======================================================================================
+static void do_convert_YUV_row(uint8_t             * aRgbPtr,
+                               const PixelsFrame_t * aFramePtr,
+                               int                   aRowIndex,
+                               ConvertRowFunc_t      aRowFunc)
+{
+    const int * pstrides = aFramePtr->pstrides_array;
+
+    int   chroma_row = aRowIndex >> aFramePtr->rows_shift;
+
+    const uint8_t * luma_ptr = aFramePtr->comps_array[0] + (aRowIndex  * aFramePtr->strides_array[0]);
+    const uint8_t * cb_ptr   = aFramePtr->comps_array[1] + (chroma_row * aFramePtr->strides_array[1]);
+    const uint8_t * cr_ptr   = aFramePtr->comps_array[2] + (chroma_row * aFramePtr->strides_array[2]);
+
+    // planar rows (e.g. I420, YV12) --- are converted directly
+    if ( (pstrides[0] == 1) && (pstrides[1] == 1) && (pstrides[2] == 1) )
+    {
+        aRowFunc(aRgbPtr, luma_ptr, cb_ptr, cr_ptr, aFramePtr->num_cols);
+        return;
+    }
+
+    uint8_t luma_array[GATHER_COLS],
+            cb_array[GATHER_COLS / 2],
+            cr_array[GATHER_COLS / 2];
+
+    int col_index;
+
+    for ( col_index = 0;  col_index < aFramePtr->num_cols;  col_index += GATHER_COLS )
+    {
+        int num_cols = MIN(GATHER_COLS, aFramePtr->num_cols - col_index);
+        int num_C_samples = (num_cols + 1) / 2;
+
+        const uint8_t * Y_ptr = luma_ptr + (col_index * pstrides[0]);
+        const uint8_t * U_ptr = cb_ptr + ((col_index / 2) * pstrides[1]);
+        const uint8_t * V_ptr = cr_ptr + ((col_index / 2) * pstrides[2]);
+
+        if (pstrides[0] != 1)
+        {
+            do_gather_samples(luma_array, Y_ptr, pstrides[0], num_cols);
+            Y_ptr = luma_array;
+        }
+
+        if (pstrides[1] != 1)
+        {
+            do_gather_samples(cb_array, U_ptr, pstrides[1], num_C_samples);
+            U_ptr = cb_array;
+        }
+
+        if (pstrides[2] != 1)
+        {
+            do_gather_samples(cr_array, V_ptr, pstrides[2], num_C_samples);
+            V_ptr = cr_array;
+        }
+
+        aRowFunc(aRgbPtr + (col_index * 3), Y_ptr, U_ptr, V_ptr, num_cols);
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_convert_RGB_row(aRgbPtr, aFramePtr, aRowIndex, aSwizzleFunc)
+//
+// copies a row of R,G,B samples in any order and with any padding into RGB24 pixels
+//=======================================================================================
+static void do_convert_RGB_row(uint8_t             * aRgbPtr,
+                               const PixelsFrame_t * aFramePtr,
+                               int                   aRowIndex,
+                               SwizzleRowFunc_t      aSwizzleFunc)
+{
+    const int * pstrides = aFramePtr->pstrides_array;
+
+    const uint8_t * R_ptr = aFramePtr->comps_array[0] + (aRowIndex * aFramePtr->strides_array[0]);
+    const uint8_t * G_ptr = aFramePtr->comps_array[1] + (aRowIndex * aFramePtr->strides_array[1]);
+    const uint8_t * B_ptr = aFramePtr->comps_array[2] + (aRowIndex * aFramePtr->strides_array[2]);
+
+    int col_index;
+
+    // RGB24 rows --- are copied as is
+    if ( (pstrides[0] == 3) && (G_ptr == R_ptr + 1) && (B_ptr == R_ptr + 2) )
+    {
+        memcpy(aRgbPtr, R_ptr, aFramePtr->num_cols * 3);
+        return;
+    }
+
+    // packed rows (e.g. BGR, BGRx, xRGB) --- are swizzled from the pixel's first R,G,B sample
+    if ( (pstrides[1] == pstrides[0]) && (pstrides[2] == pstrides[0]) )
+    {
+        const uint8_t * pixel_ptr = MIN( R_ptr, MIN(G_ptr, B_ptr) );
+
+        int offsets_array[3] = { (int) (R_ptr - pixel_ptr), (int) (G_ptr - pixel_ptr), (int) (B_ptr - pixel_ptr) };
+
+        if ( (offsets_array[0] < pstrides[0]) && (offsets_array[1] < pstrides[0]) && (offsets_array[2] < pstrides[0]) )
+        {
+            aSwizzleFunc(aRgbPtr, pixel_ptr, offsets_array, pstrides[0], aFramePtr->num_cols);
+            return;
+        }
+    }
+
+    for ( col_index = 0;  col_index < aFramePtr->num_cols;  ++col_index )
+    {
+        *aRgbPtr++ = R_ptr[col_index * pstrides[0]];
+        *aRgbPtr++ = G_ptr[col_index * pstrides[1]];
+        *aRgbPtr++ = B_ptr[col_index * pstrides[2]];
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_convert_GRAY_row(aRgbPtr, aFramePtr, aRowIndex)
+//
+// copies each Y sample of a row into the R,G,B samples of a pixel
+//=======================================================================================
+static void do_convert_GRAY_row(uint8_t * aRgbPtr, const PixelsFrame_t * aFramePtr, int aRowIndex)
+{
+    const uint8_t * Y_ptr = aFramePtr->comps_array[0] + (aRowIndex * aFramePtr->strides_array[0]);
+
+    int col_index;
+
+    for ( col_index = 0;  col_index < aFramePtr->num_cols;  ++col_index )
+    {
+        uint8_t luma = Y_ptr[col_index * aFramePtr->pstrides_array[0]];
+
+        *aRgbPtr++ = luma;
+        *aRgbPtr++ = luma;
+        *aRgbPtr++ = luma;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: is_valid = do_is_valid_frame(aFramePtr)
+//
+// returns 1 if frame has valid attributes, else 0
+//=======================================================================================
+static int do_is_valid_frame(const PixelsFrame_t * aFramePtr)
+{
+    int num_comps = (aFramePtr == NULL) ? 0 : ((aFramePtr->family == e_PIXELS_GRAY) ? 1 : 3);
+
+    if ( (num_comps == 0) || (aFramePtr->num_cols < 1) || (aFramePtr->num_rows < 1) ||
+         (aFramePtr->family > e_PIXELS_GRAY) || ((aFramePtr->rows_shift & ~1) != 0) )
+    {
+        return 0;
+    }
+
+    while (--num_comps >= 0)
+    {
+        if ( (aFramePtr->comps_array[num_comps] == NULL) || (aFramePtr->pstrides_array[num_comps] < 1) )
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+//=======================================================================================
+// synopsis: count = convert_frame_row_to_RGB24(aRgbPtr, aFramePtr, aRowIndex)
+//
+// converts one row of planar, semi-planar or packed frame --- returns number of pixels
+//=======================================================================================
+int convert_frame_row_to_RGB24(uint8_t             * aRgbPtr,
+                               const PixelsFrame_t * aFramePtr,
+                               int                   aRowIndex)
+{
+    // verify valid conditions
+    if ( (aRgbPtr == NULL) || (! do_is_valid_frame(aFramePtr)) ||
+         (aRowIndex < 0) || (aRowIndex >= aFramePtr->num_rows) )
+    {
+        return 0;
+    }
+
+    if (aFramePtr->family == e_PIXELS_YUV)
+    {
+        do_convert_YUV_row(aRgbPtr, aFramePtr, aRowIndex, do_get_kernel()->I420_row_func);
+    }
+    else if (aFramePtr->family == e_PIXELS_RGB)
+    {
+        do_convert_RGB_row(aRgbPtr, aFramePtr, aRowIndex, do_get_kernel()->RGB_row_func);
+    }
+    else
+    {
+        do_convert_GRAY_row(aRgbPtr, aFramePtr, aRowIndex);
+    }
+
+    return aFramePtr->num_cols;
+}
+
+
+//=======================================================================================
+// synopsis: count = convert_frame_to_RGB24(aRgbPtr, aRgbStride, aFramePtr)
+//
+// converts planar, semi-planar or packed frame to RGB24 --- returns number of pixels
+//=======================================================================================
+int convert_frame_to_RGB24(uint8_t             * aRgbPtr,
+                           int                   aRgbStride,
+                           const PixelsFrame_t * aFramePtr)
+{
+    int row_index;
+
+    // verify valid conditions
+    if ( (aRgbPtr == NULL) || (! do_is_valid_frame(aFramePtr)) || (aRgbStride < aFramePtr->num_cols * 3) )
+    {
+        return 0;
+    }
+
+    ConvertRowFunc_t row_func = do_get_kernel()->I420_row_func;
+
+    SwizzleRowFunc_t swizzle_func = do_get_kernel()->RGB_row_func;
+
+    for ( row_index = 0;  row_index < aFramePtr->num_rows;  ++row_index )
+    {
+        uint8_t * rgb_row_ptr = aRgbPtr + (row_index * aRgbStride);
+
+        if (aFramePtr->family == e_PIXELS_YUV)
+        {
+            do_convert_YUV_row(rgb_row_ptr, aFramePtr, row_index, row_func);
+        }
+        else if (aFramePtr->family == e_PIXELS_RGB)
+        {
+            do_convert_RGB_row(rgb_row_ptr, aFramePtr, row_index, swizzle_func);
+        }
+        else
+        {
+            do_convert_GRAY_row(rgb_row_ptr, aFramePtr, row_index);
+        }
+    }
+
+    return aFramePtr->num_cols * aFramePtr->num_rows;
+}
+
+
+//=======================================================================================
+// synopsis: count = convert_frame_row_to_GRAY8(aGrayPtr, aFramePtr, aRowIndex)
+//
+// copies the Y samples of a YUV or GRAY row, else computes the luma of an RGB row ---
+// returns number of pixels
+//=======================================================================================
+int convert_frame_row_to_GRAY8(uint8_t             * aGrayPtr,
+                               const PixelsFrame_t * aFramePtr,
+                               int                   aRowIndex)
+{
+    // verify valid conditions
+    if ( (aGrayPtr == NULL) || (! do_is_valid_frame(aFramePtr)) ||
+         (aRowIndex < 0) || (aRowIndex >= aFramePtr->num_rows) )
+    {
+        return 0;
+    }
+
+    const int * pstrides = aFramePtr->pstrides_array;
+
+    const uint8_t * Y_ptr = aFramePtr->comps_array[0] + (aRowIndex * aFramePtr->strides_array[0]);
+
+    int col_index;
+
+    if (aFramePtr->family != e_PIXELS_RGB)
+    {
+        if (pstrides[0] == 1)
+        {
+            memcpy(aGrayPtr, Y_ptr, aFramePtr->num_cols);
+        }
+        else
+        {
+            do_gather_samples(aGrayPtr, Y_ptr, pstrides[0], aFramePtr->num_cols);
+        }
+
+        return aFramePtr->num_cols;
+    }
+
+    const uint8_t * R_ptr = Y_ptr;
+    const uint8_t * G_ptr = aFramePtr->comps_array[1] + (aRowIndex * aFramePtr->strides_array[1]);
+    const uint8_t * B_ptr = aFramePtr->comps_array[2] + (aRowIndex * aFramePtr->strides_array[2]);
+
+    // full-range BT.601 luma --- (0.299 * R) + (0.587 * G) + (0.114 * B), rounded
+    for ( col_index = 0;  col_index < aFramePtr->num_cols;  ++col_index )
+    {
+        aGrayPtr[col_index] = (uint8_t) ( ( (77  * R_ptr[col_index * pstrides[0]]) +
+                                            (150 * G_ptr[col_index * pstrides[1]]) +
+                                            (29  * B_ptr[col_index * pstrides[2]]) + 128 ) >> 8 );
+    }
+
+    return aFramePtr->num_cols;
+}
+
+
+//=======================================================================================
+// synopsis: result = convert_frame_to_GRAY_view(aGrayPtr, aFramePtr)
+//
+// describes the Y samples of a YUV or GRAY frame as a GRAY frame, without copying them ---
+// returns 0, else -1 if the frame is invalid or has no Y samples (RGB)
+//=======================================================================================
+int convert_frame_to_GRAY_view(PixelsFrame_t * aGrayPtr, const PixelsFrame_t * aFramePtr)
+{
+    if ( (aGrayPtr == NULL) || (! do_is_valid_frame(aFramePtr)) || (aFramePtr->family == e_PIXELS_RGB) )
+    {
+        return -1;
+    }
+
+    memset(aGrayPtr, 0, sizeof(*aGrayPtr));
+
+    aGrayPtr->family            = e_PIXELS_GRAY;
+    aGrayPtr->num_cols          = aFramePtr->num_cols;
+    aGrayPtr->num_rows          = aFramePtr->num_rows;
+    aGrayPtr->comps_array[0]    = aFramePtr->comps_array[0];
+    aGrayPtr->strides_array[0]  = aFramePtr->strides_array[0];
+    aGrayPtr->pstrides_array[0] = aFramePtr->pstrides_array[0];
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: result = convert_frame_to_cropped_view(aCroppedPtr, aFramePtr, aLeft, aTop, aNumCols, aNumRows)
+//
+// describes a rectangle of the frame as a frame, without copying its samples --- a size of
+// 0 reaches the frame's edge, the rectangle is clipped to the frame, YUV rectangles start
+// on shared U,V samples --- returns 0, else -1 if the frame is invalid or not overlapped
+//=======================================================================================
+int convert_frame_to_cropped_view(PixelsFrame_t       * aCroppedPtr,
+                                  const PixelsFrame_t * aFramePtr,
+                                  int                   aLeft,
+                                  int                   aTop,
+                                  int                   aNumCols,
+                                  int                   aNumRows)
+{
+    if ( (aCroppedPtr == NULL) || (! do_is_valid_frame(aFramePtr)) ||
+         (aLeft < 0) || (aLeft >= aFramePtr->num_cols) || (aNumCols < 0) ||
+         (aTop  < 0) || (aTop  >= aFramePtr->num_rows) || (aNumRows < 0) )
+    {
+        return -1;
+    }
+
+    int64_t right  = (aNumCols == 0) ? aFramePtr->num_cols : (int64_t) aLeft + aNumCols,
+            bottom = (aNumRows == 0) ? aFramePtr->num_rows : (int64_t) aTop  + aNumRows;
+
+    // the U,V samples of a YUV rectangle must not be shared with pixels outside of it
+    if (aFramePtr->family == e_PIXELS_YUV)
+    {
+        aLeft &= ~1;
+        aTop  &= ~aFramePtr->rows_shift;
+    }
+
+    int plane_index, num_planes = (aFramePtr->family == e_PIXELS_GRAY) ? 1 : 3;
+
+    *aCroppedPtr = *aFramePtr;
+
+    aCroppedPtr->num_cols = (int) (MIN( right,  aFramePtr->num_cols ) - aLeft);
+    aCroppedPtr->num_rows = (int) (MIN( bottom, aFramePtr->num_rows ) - aTop);
+
+    for ( plane_index = 0;  plane_index < num_planes;  ++plane_index )
+    {
+        int is_chroma = (aFramePtr->family == e_PIXELS_YUV) && (plane_index > 0);
+
+        int col_index = is_chroma ? aLeft / 2 : aLeft,
+            row_index = is_chroma ? aTop >> aFramePtr->rows_shift : aTop;
+
+        aCroppedPtr->comps_array[plane_index] += ((ptrdiff_t) row_index * aFramePtr->strides_array[plane_index]) +
+                                                 ((ptrdiff_t) col_index * aFramePtr->pstrides_array[plane_index]);
+    }
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: num_planes = do_get_frame_planes(aFramePtr, aNumCols, aNumRows, aPlanesArray)
+//
+// describes the components of a frame of aNumCols x aNumRows pixels --- returns their count
+//=======================================================================================
+static int do_get_frame_planes(const PixelsFrame_t * aFramePtr, int aNumCols, int aNumRows, PixelsPlane_t aPlanesArray[3])
+{
+    int num_planes = (aFramePtr->family == e_PIXELS_GRAY) ? 1 : 3;
+
+    int plane_index;
+
+    for ( plane_index = 0;  plane_index < num_planes;  ++plane_index )
+    {
+        int is_chroma = (aFramePtr->family == e_PIXELS_YUV) && (plane_index > 0);
+
+        aPlanesArray[plane_index].samples_ptr = aFramePtr->comps_array[plane_index];
+        aPlanesArray[plane_index].stride      = aFramePtr->strides_array[plane_index];
+        aPlanesArray[plane_index].pstride     = aFramePtr->pstrides_array[plane_index];
+        aPlanesArray[plane_index].num_cols    = is_chroma ? (aNumCols + 1) / 2 : aNumCols;
+        aPlanesArray[plane_index].num_rows    = is_chroma ? (aNumRows + aFramePtr->rows_shift) >> aFramePtr->rows_shift : aNumRows;
+    }
+
+    return num_planes;
+}
+
+
+//=======================================================================================
+// synopsis: do_scale_plane(aDestPtr, aSourcePtr, aSumsPtr, aAddFunc)
+//
+// sets each destination sample to the rounded mean of the box of source samples it covers
+//=======================================================================================
+static void do_scale_plane(const PixelsPlane_t * aDestPtr,
+                           const PixelsPlane_t * aSourcePtr,
+                           uint16_t            * aSumsPtr,
+                           AddRowFunc_t          aAddFunc)
+{
+    // the rows are summed with their interleaved bytes --- the columns skip them
+    int row_bytes = ((aSourcePtr->num_cols - 1) * aSourcePtr->pstride) + 1;
+
+    int dest_row, dest_col, row_index, col_index, first_row = 0;
+
+    for ( dest_row = 0;  dest_row < aDestPtr->num_rows;  ++dest_row )
+    {
+        int end_row = (int) (((int64_t) (dest_row + 1) * aSourcePtr->num_rows) / aDestPtr->num_rows);
+
+        uint8_t * dest_ptr = (uint8_t *) aDestPtr->samples_ptr + (dest_row * aDestPtr->stride);
+
+        int first_col = 0;
+
+        memset(aSumsPtr, 0, row_bytes * sizeof(uint16_t));
+
+        for ( row_index = first_row;  row_index < end_row;  ++row_index )
+        {
+            aAddFunc(aSumsPtr, aSourcePtr->samples_ptr + (row_index * aSourcePtr->stride), row_bytes);
+        }
+
+        for ( dest_col = 0;  dest_col < aDestPtr->num_cols;  ++dest_col )
+        {
+            int end_col = (int) (((int64_t) (dest_col + 1) * aSourcePtr->num_cols) / aDestPtr->num_cols);
+
+            uint32_t sum = 0,   count = (uint32_t) ((end_col - first_col) * (end_row - first_row));
+
+            for ( col_index = first_col;  col_index < end_col;  ++col_index )
+            {
+                sum += aSumsPtr[col_index * aSourcePtr->pstride];
+            }
+
+            dest_ptr[dest_col * aDestPtr->pstride] = (uint8_t) ((sum + (count / 2)) / count);
+
+            first_col = end_col;
+        }
+
+        first_row = end_row;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: length = convert_frame_get_scaled_size(aFramePtr, aMaxCols, aMaxRows, aColsPtr, aRowsPtr)
+//
+// fits the frame in aMaxCols x aMaxRows (0 is unbounded) keeping its aspect ratio, scaling
+// down by 128:1 at most --- returns the bytes needed to scale it, 0 if it fits already
+//=======================================================================================
+size_t convert_frame_get_scaled_size(const PixelsFrame_t * aFramePtr,
+                                     int                   aMaxCols,
+                                     int                   aMaxRows,
+                                     int                 * aColsPtr,
+                                     int                 * aRowsPtr)
+{
+    PixelsPlane_t planes_array[3];
+
+    if ( (! do_is_valid_frame(aFramePtr)) || (aColsPtr == NULL) || (aRowsPtr == NULL) )
+    {
+        return 0;
+    }
+
+    int64_t num_cols = aFramePtr->num_cols,   num_rows = aFramePtr->num_rows;
+
+    if ( (aMaxCols > 0) && (num_cols > aMaxCols) )
+    {
+        num_rows = ((num_rows * aMaxCols) + (num_cols / 2)) / num_cols;
+        num_cols = aMaxCols;
+    }
+
+    if ( (aMaxRows > 0) && (num_rows > aMaxRows) )
+    {
+        num_cols = ((num_cols * aMaxRows) + (num_rows / 2)) / num_rows;
+        num_rows = aMaxRows;
+    }
+
+    *aColsPtr = (int) MAX( num_cols, (aFramePtr->num_cols + MAX_SCALE_DOWN - 1) / MAX_SCALE_DOWN );
+    *aRowsPtr = (int) MAX( num_rows, (aFramePtr->num_rows + MAX_SCALE_DOWN - 1) / MAX_SCALE_DOWN );
+
+    if ( (*aColsPtr == aFramePtr->num_cols) && (*aRowsPtr == aFramePtr->num_rows) )
+    {
+        return 0;
+    }
+
+    int num_planes = do_get_frame_planes(aFramePtr, aFramePtr->num_cols, aFramePtr->num_rows, planes_array);
+
+    size_t sums_lng = 0,   pixels_lng = (size_t) *aColsPtr * *aRowsPtr * ((aFramePtr->family == e_PIXELS_RGB) ? 3 : 1);
+
+    while (--num_planes >= 0)
+    {
+        sums_lng = MAX( sums_lng, (size_t) (((planes_array[num_planes].num_cols - 1) * planes_array[num_planes].pstride) + 1) );
+    }
+
+    if (aFramePtr->family == e_PIXELS_YUV)
+    {
+        pixels_lng += 2 * (size_t) ((*aColsPtr + 1) / 2) * ((*aRowsPtr + 1) / 2);
+    }
+
+    return SUMS_ALIGN(sums_lng * sizeof(uint16_t)) + pixels_lng;
+}
+
+
+//=======================================================================================
+// synopsis: result = convert_frame_to_scaled(aScaledPtr, aFramePtr, aNumCols, aNumRows, aPixelsPtr)
+//
+// scales the frame down by box filters into aPixelsPtr, which holds the bytes given by
+// convert_frame_get_scaled_size() --- YUV frames become I420, RGB frames become RGB24 ---
+// returns 0, else -1 if the frame or the size is invalid
+//=======================================================================================
+int convert_frame_to_scaled(PixelsFrame_t       * aScaledPtr,
+                            const PixelsFrame_t * aFramePtr,
+                            int                   aNumCols,
+                            int                   aNumRows,
+                            uint8_t             * aPixelsPtr)
+{
+    PixelsPlane_t source_planes[3], scaled_planes[3];
+
+    if ( (aScaledPtr == NULL) || (aPixelsPtr == NULL) || (! do_is_valid_frame(aFramePtr)) ||
+         (aNumCols < 1) || (aNumCols > aFramePtr->num_cols) || ((int64_t) aNumCols * MAX_SCALE_DOWN < aFramePtr->num_cols) ||
+         (aNumRows < 1) || (aNumRows > aFramePtr->num_rows) || ((int64_t) aNumRows * MAX_SCALE_DOWN < aFramePtr->num_rows) )
+    {
+        return -1;
+    }
+
+    int num_planes = do_get_frame_planes(aFramePtr, aFramePtr->num_cols, aFramePtr->num_rows, source_planes);
+
+    int plane_index;
+
+    size_t sums_lng = 0;
+
+    for ( plane_index = 0;  plane_index < num_planes;  ++plane_index )
+    {
+        sums_lng = MAX( sums_lng, (size_t) (((source_planes[plane_index].num_cols - 1) * source_planes[plane_index].pstride) + 1) );
+    }
+
+    uint16_t * sums_ptr = (uint16_t *) aPixelsPtr;
+
+    uint8_t  * next_ptr = aPixelsPtr + SUMS_ALIGN(sums_lng * sizeof(uint16_t));
+
+    memset(aScaledPtr, 0, sizeof(*aScaledPtr));
+
+    aScaledPtr->family     = aFramePtr->family;
+    aScaledPtr->num_cols   = aNumCols;
+    aScaledPtr->num_rows   = aNumRows;
+    aScaledPtr->rows_shift = (aFramePtr->family == e_PIXELS_YUV) ? 1 : 0;
+
+    for ( plane_index = 0;  plane_index < num_planes;  ++plane_index )
+    {
+        // RGB24 --- the R,G,B planes are interleaved
+        if (aFramePtr->family == e_PIXELS_RGB)
+        {
+            aScaledPtr->comps_array[plane_index]    = next_ptr + plane_index;
+            aScaledPtr->strides_array[plane_index]  = aNumCols * 3;
+            aScaledPtr->pstrides_array[plane_index] = 3;
+            continue;
+        }
+
+        int num_cols = (plane_index == 0) ? aNumCols : (aNumCols + 1) / 2;
+        int num_rows = (plane_index == 0) ? aNumRows : (aNumRows + 1) / 2;
+
+        aScaledPtr->comps_array[plane_index]    = next_ptr;
+        aScaledPtr->strides_array[plane_index]  = num_cols;
+        aScaledPtr->pstrides_array[plane_index] = 1;
+
+        next_ptr += (size_t) num_cols * num_rows;
+    }
+
+    do_get_frame_planes(aScaledPtr, aNumCols, aNumRows, scaled_planes);
+
+    AddRowFunc_t add_func = do_get_kernel()->add_row_func;
+
+    for ( plane_index = 0;  plane_index < num_planes;  ++plane_index )
+    {
+        do_scale_plane(&scaled_planes[plane_index], &source_planes[plane_index], sums_ptr, add_func);
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * ======================================================================================
+ * File:        convert_frame_pixels.h
+ *
+ * Purpose:     external interface (API) for code in "convert_frame_pixels.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Y samples as GRAY8 rows and GRAY frame views
+ *              3. 2026-10-17               Scales frames down by box filters
+ *              4. 2026-10-17               Cropped frame views
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Convert_Frame_Pixels_H__
+
+#define __Convert_Frame_Pixels_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef enum
+{
+    e_PIXELS_YUV  = 0,      // Y,U,V samples --- each U,V is shared by two pixels of a row
+    e_PIXELS_RGB  = 1,      // R,G,B samples --- any other samples (e.g. alpha) are ignored
+    e_PIXELS_GRAY = 2       // Y samples only
+
+} PIXELS_FAMILY_e;
+
+typedef struct _PixelsFrame_t
+{
+    PIXELS_FAMILY_e     family;
+    int                 num_cols;
+    int                 num_rows;
+    int                 rows_shift;             // 1 when each U,V is shared by two rows
+    const uint8_t     * comps_array[3];         // first Y,U,V or R,G,B sample in frame
+    int                 strides_array[3];       // bytes per row of each component
+    int                 pstrides_array[3];      // bytes per pixel of each component
+
+} PixelsFrame_t;
+
+
+//=======================================================================================
+// synopsis: name = convert_pixels_get_kernel()
+//
+// returns the name of the kernel in use --- "scalar", "sse4.1", "avx2" or "avx512bw"
+//=======================================================================================
+extern const char * convert_pixels_get_kernel(void);
+
+
+//=======================================================================================
+// synopsis: result = convert_pixels_set_kernel(aNamePtr)
+//
+// selects a kernel by name, "auto" selects the best one --- returns 0, else -1 if unusable
+//=======================================================================================
+extern int convert_pixels_set_kernel(const char * aNamePtr);
+
+
+//=======================================================================================
+// synopsis: convert_I420_row_to_RGB24(aRgbPtr, aLumaPtr, aCbPtr, aCrPtr, aNumCols)
+//
+// converts one row of I420 samples --- chroma samples are shared by two luma samples
+//=======================================================================================
+extern void convert_I420_row_to_RGB24(uint8_t       * aRgbPtr,
+                                      const uint8_t * aLumaPtr,
+                                      const uint8_t * aCbPtr,
+                                      const uint8_t * aCrPtr,
+                                      int             aNumCols);
+
+
+//=======================================================================================
+// synopsis: count = convert_I420_frame_to_RGB24(aRgbPtr, aRgbStride, aPlanes, aStrides, aCols, aRows)
+//
+// converts planar Y,U,V frame to packed RGB24 --- returns number of pixels converted
+//=======================================================================================
+extern int convert_I420_frame_to_RGB24(uint8_t       * aRgbPtr,
+                                       int             aRgbStride,
+                                       const uint8_t * aPlanesArray[3],
+                                       const int       aStridesArray[3],
+                                       int             aNumCols,
+                                       int             aNumRows);
+
+
+//=======================================================================================
+// synopsis: count = convert_frame_row_to_RGB24(aRgbPtr, aFramePtr, aRowIndex)
+//
+// converts one row of planar, semi-planar or packed frame --- returns number of pixels
+//=======================================================================================
+extern int convert_frame_row_to_RGB24(uint8_t             * aRgbPtr,
+                                      const PixelsFrame_t * aFramePtr,
+                                      int                   aRowIndex);
+
+
+//=======================================================================================
+// synopsis: count = convert_frame_to_RGB24(aRgbPtr, aRgbStride, aFramePtr)
+//
+// converts planar, semi-planar or packed frame to RGB24 --- returns number of pixels
+//=======================================================================================
+extern int convert_frame_to_RGB24(uint8_t             * aRgbPtr,
+                                  int                   aRgbStride,
+                                  const PixelsFrame_t * aFramePtr);
+
+
+//=======================================================================================
+// synopsis: count = convert_frame_row_to_GRAY8(aGrayPtr, aFramePtr, aRowIndex)
+//
+// copies the Y samples of a YUV or GRAY row, else computes the luma of an RGB row ---
+// returns number of pixels
+//=======================================================================================
+extern int convert_frame_row_to_GRAY8(uint8_t             * aGrayPtr,
+                                      const PixelsFrame_t * aFramePtr,
+                                      int                   aRowIndex);
+
+
+//=======================================================================================
+// synopsis: result = convert_frame_to_GRAY_view(aGrayPtr, aFramePtr)
+//
+// describes the Y samples of a YUV or GRAY frame as a GRAY frame, without copying them ---
+// returns 0, else -1 if the frame is invalid or has no Y samples (RGB)
+//=======================================================================================
+extern int convert_frame_to_GRAY_view(PixelsFrame_t       * aGrayPtr,
+                                      const PixelsFrame_t * aFramePtr);
+
+
+//=======================================================================================
+// synopsis: result = convert_frame_to_cropped_view(aCroppedPtr, aFramePtr, aLeft, aTop, aNumCols, aNumRows)
+//
+// describes a rectangle of the frame as a frame, without copying its samples --- a size of
+// 0 reaches the frame's edge, the rectangle is clipped to the frame, YUV rectangles start
+// on shared U,V samples --- returns 0, else -1 if the frame is invalid or not overlapped
+//=======================================================================================
+extern int convert_frame_to_cropped_view(PixelsFrame_t       * aCroppedPtr,
+                                         const PixelsFrame_t * aFramePtr,
+                                         int                   aLeft,
+                                         int                   aTop,
+                                         int                   aNumCols,
+                                         int                   aNumRows);
+
+
+//=======================================================================================
+// synopsis: length = convert_frame_get_scaled_size(aFramePtr, aMaxCols, aMaxRows, aColsPtr, aRowsPtr)
+//
+// fits the frame in aMaxCols x aMaxRows (0 is unbounded) keeping its aspect ratio, scaling
+// down by 128:1 at most --- returns the bytes needed to scale it, 0 if it fits already
+//=======================================================================================
+extern size_t convert_frame_get_scaled_size(const PixelsFrame_t * aFramePtr,
+                                            int                   aMaxCols,
+                                            int                   aMaxRows,
+                                            int                 * aColsPtr,
+                                            int                 * aRowsPtr);
+
+
+//=======================================================================================
+// synopsis: result = convert_frame_to_scaled(aScaledPtr, aFramePtr, aNumCols, aNumRows, aPixelsPtr)
+//
+// scales the frame down by box filters into aPixelsPtr, which holds the bytes given by
+// convert_frame_get_scaled_size() --- YUV frames become I420, RGB frames become RGB24 ---
+// returns 0, else -1 if the frame or the size is invalid
+//=======================================================================================
+extern int convert_frame_to_scaled(PixelsFrame_t       * aScaledPtr,
+                                   const PixelsFrame_t * aFramePtr,
+                                   int                   aNumCols,
+                                   int                   aNumRows,
+                                   uint8_t             * aPixelsPtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Convert_Frame_Pixels_H__
@@ -0,0 +1,242 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_helpers.c
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Helpers apply the encoders' CPUs and scheduling
+ *
+ * Description: Helper threads which let one encoder split one image into parallel tasks
+ *              (e.g. the strips of a 4K PNG). Unlike the encoder pool, whose workers each
+ *              run a whole job, a helper runs any unclaimed task of any caller.
+ *
+ *              The caller runs its own unclaimed tasks too, and only then waits for the
+ *              tasks that helpers are running. Hence a caller never waits for a task that
+ *              no thread is running, even when all helpers are busy for other callers.
+ *
+ *              Helpers are started on demand and live as long as the process, blocked on
+ *              a condition while idle. Plain pthreads keep the encoders free of GLib.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "frame_encoder_helpers.h"
+#include "frame_encoder_placement.h"
+
+#include <stddef.h>
+#include <pthread.h>
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef struct _EncoderTasks_t
+{
+    EncoderTaskFunc_t           task_func;
+    void                      * tasks_ptr;
+
+    int                         num_tasks,
+                                next_task,      // first unclaimed task
+                                num_done;
+
+    struct _EncoderTasks_t    * next_ptr;       // next caller's tasks in the list
+
+} EncoderTasks_t;
+
+
+static pthread_mutex_t  The_Helpers_Mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_cond_t   The_Work_Cond = PTHREAD_COND_INITIALIZER;   // signaled when tasks are listed
+
+static pthread_cond_t   The_Done_Cond = PTHREAD_COND_INITIALIZER;   // signaled when all tasks of a caller are done
+
+static EncoderTasks_t * The_Tasks_List = NULL;      // callers with unclaimed tasks --- FIFO
+
+static int              The_Num_Helpers = 0;
+
+
+//=======================================================================================
+// synopsis: task_index = do_claim_task(aTasksPtr)
+//
+// called with the mutex held --- claims the next task, unlists the caller's last task
+//=======================================================================================
+static int do_claim_task(EncoderTasks_t * aTasksPtr)
+{
+    int task_index = aTasksPtr->next_task++;
+
+    if (aTasksPtr->next_task == aTasksPtr->num_tasks)
+    {
+        EncoderTasks_t ** link_ptr = &The_Tasks_List;
+
+        while (*link_ptr != aTasksPtr)
+        {
+            link_ptr = &(*link_ptr)->next_ptr;
+        }
+
+        *link_ptr = aTasksPtr->next_ptr;
+    }
+
+    return task_index;
+}
+
+
+//=======================================================================================
+// synopsis: do_run_task(aTasksPtr, aTaskIndex)
+//
+// called with the mutex held --- runs one task without it, then counts the task as done
+//=======================================================================================
+static void do_run_task(EncoderTasks_t * aTasksPtr, int aTaskIndex)
+{
+    pthread_mutex_unlock(&The_Helpers_Mutex);
+
+    aTasksPtr->task_func(aTasksPtr->tasks_ptr, aTaskIndex);
+
+    pthread_mutex_lock(&The_Helpers_Mutex);
+
+    // the caller may return as soon as the count is complete --- don't touch aTasksPtr after
+    if (++aTasksPtr->num_done == aTasksPtr->num_tasks)
+    {
+        pthread_cond_broadcast(&The_Done_Cond);
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_helper_thread_main(aUnusedPtr)
+//
+// runs unclaimed tasks of any caller, forever --- never returns
+//=======================================================================================
+static void * do_helper_thread_main(void * aUnusedPtr)
+{
+    unsigned placement_version = 0;     // none yet --- applied before the first task
+
+    pthread_mutex_lock(&The_Helpers_Mutex);
+
+    for ( ; ; )
+    {
+        while (The_Tasks_List == NULL)
+        {
+            pthread_cond_wait(&The_Work_Cond, &The_Helpers_Mutex);
+        }
+
+        // possibly --- the placement changed --- applied without the mutex, then the list is checked again
+        if (placement_version != frame_encoder_placement_get_version())
+        {
+            pthread_mutex_unlock(&The_Helpers_Mutex);
+
+            frame_encoder_placement_apply(&placement_version);      // failures are reported by the pool's workers
+
+            pthread_mutex_lock(&The_Helpers_Mutex);
+
+            continue;
+        }
+
+        EncoderTasks_t * tasks_ptr = The_Tasks_List;
+
+        do_run_task(tasks_ptr, do_claim_task(tasks_ptr));
+    }
+
+    return aUnusedPtr;
+}
+
+
+//=======================================================================================
+// synopsis: do_spawn_helpers(aNumHelpers)
+//
+// called with the mutex held --- starts helpers until aNumHelpers run, or one fails
+//=======================================================================================
+static void do_spawn_helpers(int aNumHelpers)
+{
+    pthread_attr_t attributes;
+
+    if ( (The_Num_Helpers >= aNumHelpers) || (pthread_attr_init(&attributes) != 0) )
+    {
+        return;
+    }
+
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+
+    while (The_Num_Helpers < aNumHelpers)
+    {
+        pthread_t thread_handle;
+
+        // possibly --- no more threads --- the callers run the tasks that are left
+        if (pthread_create(&thread_handle, &attributes, do_helper_thread_main, NULL) != 0)
+        {
+            break;
+        }
+
+        The_Num_Helpers += 1;
+    }
+
+    pthread_attr_destroy(&attributes);
+}
+
+
+//=======================================================================================
+// synopsis: frame_encoder_helpers_run(aTaskFunc, aTasksPtr, aNumTasks)
+//
+// runs tasks 0..aNumTasks-1 in parallel, by helper threads and by the caller --- returns
+// when all tasks are done. Helpers are started on demand, up to MAX_ENCODER_HELPERS.
+//=======================================================================================
+void frame_encoder_helpers_run(EncoderTaskFunc_t aTaskFunc, void * aTasksPtr, int aNumTasks)
+{
+    EncoderTasks_t tasks = { aTaskFunc, aTasksPtr, aNumTasks, 0, 0, NULL };
+
+    int task_index;
+
+    if (aNumTasks < 2)
+    {
+        for ( task_index = 0;  task_index < aNumTasks;  ++task_index )
+        {
+            aTaskFunc(aTasksPtr, task_index);
+        }
+
+        return;
+    }
+
+    pthread_mutex_lock(&The_Helpers_Mutex);
+
+    do_spawn_helpers( (aNumTasks - 1 < MAX_ENCODER_HELPERS) ? aNumTasks - 1 : MAX_ENCODER_HELPERS );
+
+    EncoderTasks_t ** link_ptr = &The_Tasks_List;
+
+    while (*link_ptr != NULL)
+    {
+        link_ptr = &(*link_ptr)->next_ptr;
+    }
+
+    *link_ptr = &tasks;
+
+    pthread_cond_broadcast(&The_Work_Cond);
+
+    while (tasks.next_task < tasks.num_tasks)
+    {
+        do_run_task(&tasks, do_claim_task(&tasks));
+    }
+
+    while (tasks.num_done < tasks.num_tasks)
+    {
+        pthread_cond_wait(&The_Done_Cond, &The_Helpers_Mutex);
+    }
+
+    pthread_mutex_unlock(&The_Helpers_Mutex);
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_helpers_get_count()
+//
+// returns the number of helper threads started so far
+//=======================================================================================
+int frame_encoder_helpers_get_count(void)
+{
+    pthread_mutex_lock(&The_Helpers_Mutex);
+
+    int count = The_Num_Helpers;
+
+    pthread_mutex_unlock(&The_Helpers_Mutex);
+
+    return count;
+}
@@ -0,0 +1,56 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_helpers.h
+ *
+ * Purpose:     external interface (API) for code in "frame_encoder_helpers.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Encoder_Helpers_H__
+
+#define __Frame_Encoder_Helpers_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+#define  MAX_ENCODER_HELPERS            (15)
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef void (*EncoderTaskFunc_t)(void * aTasksPtr, int aTaskIndex);
+
+
+//=======================================================================================
+// synopsis: frame_encoder_helpers_run(aTaskFunc, aTasksPtr, aNumTasks)
+//
+// runs tasks 0..aNumTasks-1 in parallel, by helper threads and by the caller --- returns
+// when all tasks are done. Helpers are started on demand, up to MAX_ENCODER_HELPERS.
+//=======================================================================================
+extern void frame_encoder_helpers_run(EncoderTaskFunc_t   aTaskFunc,
+                                      void              * aTasksPtr,
+                                      int                 aNumTasks);
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_helpers_get_count()
+//
+// returns the number of helper threads started so far
+//=======================================================================================
+extern int frame_encoder_helpers_get_count(void);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Encoder_Helpers_H__
@@ -0,0 +1,346 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_placement.c
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Description: Where and how the encoder threads run --- the pool's workers and the
+ *              encoders' helpers --- so that saving snaps never takes CPU time from the
+ *              media threads of the same host.
+ *
+ *              The threads may be pinned to a set of CPUs, e.g. the CPUs of one NUMA node
+ *              that the media threads don't use, and may run at a higher nice value or in
+ *              the SCHED_IDLE class. Threads inherit the scheduling of their creator, and
+ *              the creator of a worker is a streaming thread, which may be real-time; hence
+ *              the default placement is applied too, and makes the threads SCHED_OTHER.
+ *
+ *              Each thread applies the placement to itself before its next job when the
+ *              version has changed. The buffers of an encoder are allocated by its thread
+ *              after that, hence the kernel's first-touch policy places their pages on the
+ *              NUMA node of the thread's CPUs, and no NUMA library is needed.
+ *
+ *              Plain pthreads keep the encoders' helpers free of GLib.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE         // cpu_set_t, sched_setaffinity() and SCHED_IDLE
+#endif
+
+#include "frame_encoder_placement.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+
+static pthread_mutex_t  The_Placement_Mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static char             The_Cpus_Specs[MAX_PLACEMENT_CPUS_LNG + 1] = "all";
+
+static cpu_set_t        The_Cpu_Set;                // valid unless The_Num_Cpus is 0
+
+static int              The_Num_Cpus = 0;           // 0 is all CPUs of the process
+
+static ENCODER_SCHED_e  The_Sched = e_SCHED_NORMAL;
+
+static int              The_Nice = 0;
+
+static unsigned         The_Version = 1;            // threads start at 0 --- the default is applied too
+
+
+//=======================================================================================
+// synopsis: count = do_parse_cpu_list(aListPtr, aCpuSetPtr)
+//
+// parses a list as "0-3,8,10-11" --- returns the number of CPUs, else -1
+//=======================================================================================
+static int do_parse_cpu_list(const char * aListPtr, cpu_set_t * aCpuSetPtr)
+{
+    const char * list_ptr = aListPtr;
+
+    CPU_ZERO(aCpuSetPtr);
+
+    for ( ; ; )
+    {
+        char * end_ptr = NULL;
+
+        if ( ! isdigit((unsigned char) *list_ptr) )
+        {
+            return -1;
+        }
+
+        unsigned long first_cpu = strtoul(list_ptr, &end_ptr, 10),
+                      final_cpu = first_cpu;
+
+        list_ptr = end_ptr;
+
+        if (*list_ptr == '-')
+        {
+            if ( ! isdigit((unsigned char) *++list_ptr) )
+            {
+                return -1;
+            }
+
+            final_cpu = strtoul(list_ptr, &end_ptr, 10);
+
+            list_ptr = end_ptr;
+        }
+
+        if ( (final_cpu < first_cpu) || (final_cpu >= CPU_SETSIZE) )
+        {
+            return -1;
+        }
+
+        while (first_cpu <= final_cpu)
+        {
+            CPU_SET(first_cpu++, aCpuSetPtr);
+        }
+
+        if (*list_ptr == 0)
+        {
+            return CPU_COUNT(aCpuSetPtr);
+        }
+
+        if (*list_ptr++ != ',')
+        {
+            return -1;
+        }
+    }
+}
+
+
+//=======================================================================================
+// synopsis: count = do_parse_cpus(aSpecsPtr, aCpuSetPtr)
+//
+// parses "all", "nodeN" or a list of CPUs --- returns the number of CPUs (0 for "all"),
+// else -1 --- the CPUs must include some that the process may run on
+//=======================================================================================
+static int do_parse_cpus(const char * aSpecsPtr, cpu_set_t * aCpuSetPtr)
+{
+    char      cpu_list[4096];
+    unsigned  node_index;
+    char      trailer;
+
+    if (strcmp(aSpecsPtr, "all") == 0)
+    {
+        return 0;
+    }
+
+    if (sscanf(aSpecsPtr, "node%u%c", &node_index, &trailer) == 1)
+    {
+        char node_path[100];
+
+        snprintf(node_path, sizeof(node_path), "/sys/devices/system/node/node%u/cpulist", node_index);
+
+        FILE * file_ptr = fopen(node_path, "r");
+
+        if (file_ptr == NULL)
+        {
+            return -1;
+        }
+
+        char * list_ptr = fgets(cpu_list, sizeof(cpu_list), file_ptr);
+
+        fclose(file_ptr);
+
+        if (list_ptr == NULL)
+        {
+            return -1;
+        }
+
+        cpu_list[strcspn(cpu_list, "\n")] = 0;      // a node without CPUs has an empty list
+    }
+    else
+    {
+        snprintf(cpu_list, sizeof(cpu_list), "%s", aSpecsPtr);
+    }
+
+    int num_cpus = do_parse_cpu_list(cpu_list, aCpuSetPtr);
+
+    cpu_set_t process_cpus;
+
+    // possibly --- none of the CPUs is allowed (e.g. by the cgroup) --- every thread would fail
+    if ( (num_cpus > 0) && (sched_getaffinity(getpid(), sizeof(process_cpus), &process_cpus) == 0) )
+    {
+        CPU_AND(&process_cpus, &process_cpus, aCpuSetPtr);
+
+        if (CPU_COUNT(&process_cpus) == 0)
+        {
+            return -1;
+        }
+    }
+
+    return num_cpus;
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_placement_count_cpus(aSpecsPtr)
+//
+// checks "all", "nodeN" (the CPUs of NUMA node N) or a list as "0-3,8,10-11" --- returns
+// the number of CPUs (0 for "all"), else -1
+//=======================================================================================
+int frame_encoder_placement_count_cpus(const char * aSpecsPtr)
+{
+    cpu_set_t cpu_set;
+
+    if ( (aSpecsPtr == NULL) || (strlen(aSpecsPtr) > MAX_PLACEMENT_CPUS_LNG) )
+    {
+        return -1;
+    }
+
+    return do_parse_cpus(aSpecsPtr, &cpu_set);
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_placement_set(aCpusSpecsPtr, aSched, aNice)
+//
+// sets the CPUs and the scheduling of all encoder threads --- applied by each thread before
+// its next job --- aNice is used by e_SCHED_NICE only --- returns 0 on success, else -1
+//=======================================================================================
+int frame_encoder_placement_set(const char * aCpusSpecsPtr, ENCODER_SCHED_e aSched, int aNice)
+{
+    cpu_set_t cpu_set;
+
+    if ( (aSched > e_SCHED_IDLE) || (aCpusSpecsPtr == NULL) || (strlen(aCpusSpecsPtr) > MAX_PLACEMENT_CPUS_LNG) )
+    {
+        return -1;
+    }
+
+    // a lower nice value would take CPU time from the media threads
+    if ( (aSched == e_SCHED_NICE) && ((aNice < 1) || (aNice > MAX_ENCODER_NICE)) )
+    {
+        return -1;
+    }
+
+    int num_cpus = do_parse_cpus(aCpusSpecsPtr, &cpu_set);
+
+    if (num_cpus < 0)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&The_Placement_Mutex);
+
+    int nice = (aSched == e_SCHED_NICE) ? aNice : 0;
+
+    if ( (strcmp(aCpusSpecsPtr, The_Cpus_Specs) != 0) || (aSched != The_Sched) || (nice != The_Nice) )
+    {
+        snprintf(The_Cpus_Specs, sizeof(The_Cpus_Specs), "%s", aCpusSpecsPtr);
+
+        The_Cpu_Set  = cpu_set;
+        The_Num_Cpus = num_cpus;
+        The_Sched    = aSched;
+        The_Nice     = nice;
+
+        The_Version += 1;
+    }
+
+    pthread_mutex_unlock(&The_Placement_Mutex);
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: version = frame_encoder_placement_get_version()
+//
+// returns a number which changes whenever frame_encoder_placement_set changes the placement
+//=======================================================================================
+unsigned frame_encoder_placement_get_version(void)
+{
+    pthread_mutex_lock(&The_Placement_Mutex);
+
+    unsigned version = The_Version;
+
+    pthread_mutex_unlock(&The_Placement_Mutex);
+
+    return version;
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_placement_apply(aVersionPtr)
+//
+// called by an encoder thread, with 0 in *aVersionPtr at its start --- applies the placement
+// to the calling thread unless *aVersionPtr is current, then updates it --- returns 0 on
+// success, else the errno of the call that failed (reported once per version)
+//=======================================================================================
+int frame_encoder_placement_apply(unsigned * aVersionPtr)
+{
+    pthread_mutex_lock(&The_Placement_Mutex);
+
+    if (*aVersionPtr == The_Version)
+    {
+        pthread_mutex_unlock(&The_Placement_Mutex);
+
+        return 0;
+    }
+
+    cpu_set_t       cpu_set   = The_Cpu_Set;
+    int             num_cpus  = The_Num_Cpus;
+    ENCODER_SCHED_e sched     = The_Sched;
+    int             nice      = The_Nice;
+
+    *aVersionPtr = The_Version;
+
+    pthread_mutex_unlock(&The_Placement_Mutex);
+
+    int result = 0;
+
+    // all --- the CPUs of the process's main thread --- undoes a pinning of this thread
+    if ( (num_cpus == 0) && (sched_getaffinity(getpid(), sizeof(cpu_set), &cpu_set) != 0) )
+    {
+        result = errno;
+    }
+    else if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+    {
+        result = errno;
+    }
+
+    struct sched_param sched_param;
+
+    memset(&sched_param, 0, sizeof(sched_param));
+
+    int error = pthread_setschedparam(pthread_self(), (sched == e_SCHED_IDLE) ? SCHED_IDLE : SCHED_OTHER, &sched_param);
+
+    if (error != 0)
+    {
+        result = (result != 0) ? result : error;
+    }
+
+    // the idle class ignores the nice value
+    if (sched != e_SCHED_IDLE)
+    {
+        if (sched == e_SCHED_NORMAL)
+        {
+            errno = 0;
+
+            nice = getpriority(PRIO_PROCESS, getpid());     // -1 is a valid nice value
+
+            if (errno != 0)
+            {
+                nice = 0;
+            }
+        }
+
+        // Linux keeps a nice value per thread --- PRIO_PROCESS of the thread's own id
+        if (setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), nice) != 0)
+        {
+            result = (result != 0) ? result : errno;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,81 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_placement.h
+ *
+ * Purpose:     external interface (API) for code in "frame_encoder_placement.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Encoder_Placement_H__
+
+#define __Frame_Encoder_Placement_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+#define  MAX_PLACEMENT_CPUS_LNG         (200)
+#define  DEFAULT_ENCODER_NICE           (10)
+#define  MAX_ENCODER_NICE               (19)
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef enum
+{
+    e_SCHED_NORMAL = 0,             // the process's policy and nice value --- never real-time
+    e_SCHED_NICE,                   // the normal policy at a higher nice value
+    e_SCHED_IDLE                    // runs only when no other thread of the CPU is runnable
+
+} ENCODER_SCHED_e;
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_placement_count_cpus(aSpecsPtr)
+//
+// checks "all", "nodeN" (the CPUs of NUMA node N) or a list as "0-3,8,10-11" --- returns
+// the number of CPUs (0 for "all"), else -1
+//=======================================================================================
+extern int frame_encoder_placement_count_cpus(const char * aSpecsPtr);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_placement_set(aCpusSpecsPtr, aSched, aNice)
+//
+// sets the CPUs and the scheduling of all encoder threads --- applied by each thread before
+// its next job --- aNice is used by e_SCHED_NICE only --- returns 0 on success, else -1
+//=======================================================================================
+extern int frame_encoder_placement_set(const char * aCpusSpecsPtr, ENCODER_SCHED_e aSched, int aNice);
+
+
+//=======================================================================================
+// synopsis: version = frame_encoder_placement_get_version()
+//
+// returns a number which changes whenever frame_encoder_placement_set changes the placement
+//=======================================================================================
+extern unsigned frame_encoder_placement_get_version(void);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_placement_apply(aVersionPtr)
+//
+// called by an encoder thread, with 0 in *aVersionPtr at its start --- applies the placement
+// to the calling thread unless *aVersionPtr is current, then updates it --- returns 0 on
+// success, else the errno of the call that failed (reported once per version)
+//=======================================================================================
+extern int frame_encoder_placement_apply(unsigned * aVersionPtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Encoder_Placement_H__
@@ -0,0 +1,627 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_pool.c
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Queue depth, overload policies and a bytes budget
+ *              3. 2026-10-17               Weighted fair scheduling and queue wait times
+ *              4. 2026-10-17               Pending jobs of a queue
+ *              5. 2026-10-17               Workers apply the encoders' CPUs and scheduling
+ *
+ * Description: A small pool of worker threads, shared by all frame-saver instances,
+ *              which converts, encodes and writes the snapped frames so that the
+ *              streaming thread only references and enqueues the frame buffer.
+ *
+ *              Every instance owns one FrameEncoderQueue_t. A queue is placed in the
+ *              pool's run-queue while it has pending jobs and none of its jobs runs,
+ *              hence jobs of one instance are encoded one at a time, in FIFO order,
+ *              while different instances are encoded in parallel.
+ *
+ *              A slow disk must not grow the memory held by pending frames. Each queue
+ *              has a depth, and all pending jobs of all instances share a bytes budget.
+ *              When either is exceeded the queue's policy drops the new job, its oldest
+ *              jobs, or all its jobs but the new one --- dropped jobs are counted by the
+ *              queue, apart from the encoders' errors.
+ *
+ *              Workers take queues by deficit round-robin over the bytes of the jobs: a
+ *              queue skipped in its turn earns its weight times POOL_QUANTUM_BYTES, and
+ *              a job runs once the queue's deficit covers its bytes. A stream of large
+ *              frames thus takes its share of the workers, not turns of equal length
+ *              with the small frames of other instances.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "frame_encoder_pool.h"
+#include "frame_encoder_placement.h"
+
+#include <gst/gst.h>
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef struct _FrameEncoderJob_t
+{
+    FrameEncoderJobFunc_t   run_func,
+                            drop_func;
+
+    gpointer                data_ptr;
+
+    gsize                   num_bytes;      // memory held by the job until it runs
+
+    gint64                  submit_us;      // monotonic time of the submit
+
+} FrameEncoderJob_t;
+
+
+static GMutex   The_Pool_Mutex;             // static GMutex needs no initialization
+
+static GCond    The_Work_Cond;              // signaled when the run-queue gets a queue
+
+static GCond    The_Idle_Cond;              // signaled when a worker finishes a job
+
+static GQueue   The_Run_Queue = G_QUEUE_INIT;
+
+static guint    The_Target_Workers = DEFAULT_POOL_WORKERS;
+
+static guint    The_Live_Workers = 0;
+
+static guint    The_Pending_Jobs = 0;
+
+static gsize    The_Pending_Bytes = 0;
+
+static gsize    The_Budget_Bytes = (gsize) DEFAULT_POOL_BUDGET_MB << 20;
+
+
+//=======================================================================================
+// synopsis: do_worker_should_exit()
+//
+// called with the pool's mutex held --- returns TRUE iff the worker should exit
+//=======================================================================================
+static gboolean do_worker_should_exit()
+{
+    if (The_Live_Workers <= The_Target_Workers)
+    {
+        return FALSE;
+    }
+
+    // a pool shrinking to zero workers still drains the jobs already queued
+    return (The_Target_Workers > 0) || g_queue_is_empty(&The_Run_Queue);
+}
+
+
+//=======================================================================================
+// synopsis: queue_ptr = do_pick_next_queue()
+//
+// called with the pool's mutex held and the run-queue not empty --- dequeues the first
+// queue whose deficit covers its next job, each queue skipped earns its quantum
+//=======================================================================================
+static FrameEncoderQueue_t * do_pick_next_queue()
+{
+    for ( ; ; )
+    {
+        FrameEncoderQueue_t * queue_ptr = (FrameEncoderQueue_t *) g_queue_peek_head(&The_Run_Queue);
+
+        FrameEncoderJob_t   *   job_ptr = (FrameEncoderJob_t *) g_queue_peek_head(&queue_ptr->pending_jobs);
+
+        if (queue_ptr->deficit_bytes < (gint64) job_ptr->num_bytes)
+        {
+            queue_ptr->deficit_bytes += (gint64) POOL_QUANTUM_BYTES * queue_ptr->weight;
+        }
+
+        if (queue_ptr->deficit_bytes >= (gint64) job_ptr->num_bytes)
+        {
+            return (FrameEncoderQueue_t *) g_queue_pop_head(&The_Run_Queue);
+        }
+
+        // moves the link itself --- no allocations while the mutex is held
+        g_queue_push_tail_link(&The_Run_Queue, g_queue_pop_head_link(&The_Run_Queue));
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_worker_thread_main(aUnusedPtr)
+//
+// runs jobs from the run-queue until the pool shrinks --- returns NULL
+//=======================================================================================
+static gpointer do_worker_thread_main(gpointer aUnusedPtr)
+{
+    unsigned placement_version = 0;     // none yet --- applied before the first job
+
+    g_mutex_lock(&The_Pool_Mutex);
+
+    for ( ; ; )
+    {
+        while ( g_queue_is_empty(&The_Run_Queue) && ! do_worker_should_exit() )
+        {
+            g_cond_wait(&The_Work_Cond, &The_Pool_Mutex);
+        }
+
+        if ( do_worker_should_exit() )
+        {
+            break;
+        }
+
+        FrameEncoderQueue_t * queue_ptr = do_pick_next_queue();
+
+        FrameEncoderJob_t   *   job_ptr = (FrameEncoderJob_t *) g_queue_pop_head(&queue_ptr->pending_jobs);
+
+        queue_ptr->is_scheduled = FALSE;
+        queue_ptr->is_running   = TRUE;
+
+        queue_ptr->deficit_bytes -= (gint64) job_ptr->num_bytes;
+
+        gint64 wait_us = g_get_monotonic_time() - job_ptr->submit_us;
+
+        queue_ptr->num_waits   += 1;
+        queue_ptr->sum_wait_us += wait_us;
+        queue_ptr->max_wait_us  = MAX(queue_ptr->max_wait_us, wait_us);
+
+        The_Pending_Jobs  -= 1;
+        The_Pending_Bytes -= job_ptr->num_bytes;
+
+        g_mutex_unlock(&The_Pool_Mutex);
+
+        int error = frame_encoder_placement_apply(&placement_version);
+
+        if (error != 0)
+        {
+            GST_WARNING("Failed placing encoder worker --- (%s) \n", g_strerror(error));
+        }
+
+        job_ptr->run_func(job_ptr->data_ptr);
+
+        g_free(job_ptr);
+
+        g_mutex_lock(&The_Pool_Mutex);
+
+        queue_ptr->is_running = FALSE;
+
+        // possibly --- more jobs of this instance --- it keeps its turn while its deficit
+        // covers the next job, else it is requeued at the tail for fairness
+        if ( ! g_queue_is_empty(&queue_ptr->pending_jobs) )
+        {
+            FrameEncoderJob_t * next_ptr = (FrameEncoderJob_t *) g_queue_peek_head(&queue_ptr->pending_jobs);
+
+            queue_ptr->is_scheduled = TRUE;
+
+            if (queue_ptr->deficit_bytes >= (gint64) next_ptr->num_bytes)
+            {
+                g_queue_push_head(&The_Run_Queue, queue_ptr);
+            }
+            else
+            {
+                g_queue_push_tail(&The_Run_Queue, queue_ptr);
+            }
+        }
+
+        g_cond_broadcast(&The_Idle_Cond);
+    }
+
+    The_Live_Workers -= 1;
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    return NULL;
+}
+
+
+//=======================================================================================
+// synopsis: result = do_spawn_workers()
+//
+// called with the pool's mutex held --- returns 0 on success, else error
+//=======================================================================================
+static gint do_spawn_workers()
+{
+    while (The_Live_Workers < The_Target_Workers)
+    {
+        GError  * error_ptr = NULL;
+
+        GThread * thread_ptr = g_thread_try_new("FrameEncoder", do_worker_thread_main, NULL, &error_ptr);
+
+        if (thread_ptr == NULL)
+        {
+            GST_WARNING("Failed creating encoder worker --- (%s) \n", error_ptr ? error_ptr->message : "?");
+
+            g_clear_error(&error_ptr);
+
+            return -1;
+        }
+
+        g_thread_unref(thread_ptr);     // the worker is detached --- it exits by itself
+
+        The_Live_Workers += 1;
+    }
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_pool_set_size(aNumWorkers)
+//
+// sets the number of shared worker threads --- 0 encodes on the caller's thread
+//=======================================================================================
+gint frame_encoder_pool_set_size(guint aNumWorkers)
+{
+    if (aNumWorkers > MAX_POOL_WORKERS)
+    {
+        return -1;
+    }
+
+    g_mutex_lock(&The_Pool_Mutex);
+
+    The_Target_Workers = aNumWorkers;
+
+    // possibly --- surplus workers must wake up to exit
+    g_cond_broadcast(&The_Work_Cond);
+
+    gint result = g_queue_is_empty(&The_Run_Queue) ? 0 : do_spawn_workers();
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    return result;
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_pool_get_size()
+//
+// returns the number of shared worker threads requested by the most recent set_size
+//=======================================================================================
+guint frame_encoder_pool_get_size(void)
+{
+    g_mutex_lock(&The_Pool_Mutex);
+
+    guint count = The_Target_Workers;
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    return count;
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_pool_set_budget(aMaxBytes)
+//
+// bounds the bytes of all pending jobs of all instances --- 0 is unbounded --- returns 0
+//=======================================================================================
+gint frame_encoder_pool_set_budget(gsize aMaxBytes)
+{
+    g_mutex_lock(&The_Pool_Mutex);
+
+    The_Budget_Bytes = aMaxBytes;
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: frame_encoder_queue_init(aQueuePtr)
+//
+// initializes the per-instance queue --- jobs of one queue never run concurrently
+//=======================================================================================
+void frame_encoder_queue_init(FrameEncoderQueue_t * aQueuePtr)
+{
+    g_queue_init(&aQueuePtr->pending_jobs);
+
+    aQueuePtr->is_scheduled = FALSE;
+    aQueuePtr->is_running   = FALSE;
+
+    aQueuePtr->max_pending_jobs = DEFAULT_QUEUE_DEPTH;
+    aQueuePtr->policy           = e_QUEUE_DROP_NEWEST;
+    aQueuePtr->num_dropped_jobs = 0;
+
+    aQueuePtr->weight        = DEFAULT_QUEUE_WEIGHT;
+    aQueuePtr->deficit_bytes = 0;
+
+    aQueuePtr->num_waits   = 0;
+    aQueuePtr->sum_wait_us = 0;
+    aQueuePtr->max_wait_us = 0;
+}
+
+
+//=======================================================================================
+// synopsis: frame_encoder_queue_set_limits(aQueuePtr, aMaxPendingJobs, aPolicy)
+//
+// sets the depth of the queue (0 is bounded by the pool only) and its overload policy
+//=======================================================================================
+void frame_encoder_queue_set_limits(FrameEncoderQueue_t * aQueuePtr, guint aMaxPendingJobs, QUEUE_POLICY_e aPolicy)
+{
+    g_mutex_lock(&The_Pool_Mutex);
+
+    aQueuePtr->max_pending_jobs = aMaxPendingJobs;
+    aQueuePtr->policy           = aPolicy;
+
+    g_mutex_unlock(&The_Pool_Mutex);
+}
+
+
+//=======================================================================================
+// synopsis: frame_encoder_queue_set_weight(aQueuePtr, aWeight)
+//
+// sets the queue's share of the workers --- a queue of weight 2 encodes twice the bytes
+//=======================================================================================
+void frame_encoder_queue_set_weight(FrameEncoderQueue_t * aQueuePtr, guint aWeight)
+{
+    g_mutex_lock(&The_Pool_Mutex);
+
+    aQueuePtr->weight = CLAMP(aWeight, 1, MAX_QUEUE_WEIGHT);
+
+    g_mutex_unlock(&The_Pool_Mutex);
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_queue_get_waits(aQueuePtr, aSumPtr, aMaxPtr)
+//
+// gets total and maximum micros the queue's jobs waited for a worker since it was last
+// flushed --- returns the number of jobs
+//=======================================================================================
+guint frame_encoder_queue_get_waits(FrameEncoderQueue_t * aQueuePtr, gint64 * aSumPtr, gint64 * aMaxPtr)
+{
+    g_mutex_lock(&The_Pool_Mutex);
+
+    guint count = aQueuePtr->num_waits;
+
+    *aSumPtr = aQueuePtr->sum_wait_us;
+    *aMaxPtr = aQueuePtr->max_wait_us;
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    return count;
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_queue_get_pending(aQueuePtr)
+//
+// returns the number of the queue's jobs waiting for a worker
+//=======================================================================================
+guint frame_encoder_queue_get_pending(FrameEncoderQueue_t * aQueuePtr)
+{
+    g_mutex_lock(&The_Pool_Mutex);
+
+    guint count = aQueuePtr->pending_jobs.length;
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    return count;
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_queue_get_drops(aQueuePtr)
+//
+// returns the number of jobs dropped by the queue's policy since it was last flushed
+//=======================================================================================
+guint frame_encoder_queue_get_drops(FrameEncoderQueue_t * aQueuePtr)
+{
+    g_mutex_lock(&The_Pool_Mutex);
+
+    guint count = aQueuePtr->num_dropped_jobs;
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    return count;
+}
+
+
+//=======================================================================================
+// synopsis: is_full = do_is_queue_full(aQueuePtr, aNumBytes)
+//
+// called with the pool's mutex held --- returns TRUE iff a job of aNumBytes exceeds a limit
+//=======================================================================================
+static gboolean do_is_queue_full(FrameEncoderQueue_t * aQueuePtr, gsize aNumBytes)
+{
+    if (The_Pending_Jobs >= MAX_POOL_PENDING_JOBS)
+    {
+        return TRUE;
+    }
+
+    if ( (aQueuePtr->max_pending_jobs > 0) && (aQueuePtr->pending_jobs.length >= aQueuePtr->max_pending_jobs) )
+    {
+        return TRUE;
+    }
+
+    // a frame larger than the budget still passes when nothing else is pending
+    return (The_Budget_Bytes > 0) && (The_Pending_Bytes > 0) && (The_Pending_Bytes + aNumBytes > The_Budget_Bytes);
+}
+
+
+//=======================================================================================
+// synopsis: do_drop_pending_jobs(aQueuePtr, aDroppedPtr, aNumBytes)
+//
+// called with the pool's mutex held --- moves the jobs that the queue's policy drops to
+// make room for a job of aNumBytes into aDroppedPtr
+//=======================================================================================
+static void do_drop_pending_jobs(FrameEncoderQueue_t * aQueuePtr, GQueue * aDroppedPtr, gsize aNumBytes)
+{
+    while ( (aQueuePtr->policy != e_QUEUE_DROP_NEWEST) && ! g_queue_is_empty(&aQueuePtr->pending_jobs) )
+    {
+        if ( (aQueuePtr->policy == e_QUEUE_DROP_OLDEST) && ! do_is_queue_full(aQueuePtr, aNumBytes) )
+        {
+            break;
+        }
+
+        FrameEncoderJob_t * job_ptr = (FrameEncoderJob_t *) g_queue_pop_head(&aQueuePtr->pending_jobs);
+
+        The_Pending_Jobs  -= 1;
+        The_Pending_Bytes -= job_ptr->num_bytes;
+
+        aQueuePtr->num_dropped_jobs += 1;
+
+        g_queue_push_tail(aDroppedPtr, job_ptr);
+    }
+
+    // possibly --- the queue was emptied --- no worker must pick it up
+    if ( aQueuePtr->is_scheduled && g_queue_is_empty(&aQueuePtr->pending_jobs) )
+    {
+        g_queue_remove(&The_Run_Queue, aQueuePtr);
+
+        aQueuePtr->is_scheduled = FALSE;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_run_drop_funcs(aDroppedPtr)
+//
+// called without the pool's mutex --- the drop callbacks may release buffers
+//=======================================================================================
+static void do_run_drop_funcs(GQueue * aDroppedPtr)
+{
+    FrameEncoderJob_t * job_ptr;
+
+    while ( (job_ptr = (FrameEncoderJob_t *) g_queue_pop_head(aDroppedPtr)) != NULL )
+    {
+        job_ptr->drop_func(job_ptr->data_ptr);
+
+        g_free(job_ptr);
+    }
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_pool_submit(aQueuePtr, aRunFunc, aDropFunc, aDataPtr, aNumBytes)
+//
+// enqueues one job which holds aNumBytes --- returns 0 on success, else -1 when refused
+//=======================================================================================
+gint frame_encoder_pool_submit(FrameEncoderQueue_t   * aQueuePtr,
+                               FrameEncoderJobFunc_t   aRunFunc,
+                               FrameEncoderJobFunc_t   aDropFunc,
+                               gpointer                aDataPtr,
+                               gsize                   aNumBytes)
+{
+    GQueue dropped_jobs = G_QUEUE_INIT;
+
+    g_mutex_lock(&The_Pool_Mutex);
+
+    // possibly --- no workers wanted --- run now unless older jobs are still queued
+    if ( (The_Target_Workers == 0) &&
+         (! aQueuePtr->is_running) && g_queue_is_empty(&aQueuePtr->pending_jobs) )
+    {
+        aQueuePtr->is_running = TRUE;
+
+        g_mutex_unlock(&The_Pool_Mutex);
+
+        aRunFunc(aDataPtr);
+
+        g_mutex_lock(&The_Pool_Mutex);
+
+        aQueuePtr->is_running = FALSE;
+
+        g_cond_broadcast(&The_Idle_Cond);
+
+        g_mutex_unlock(&The_Pool_Mutex);
+
+        return 0;
+    }
+
+    if ( do_is_queue_full(aQueuePtr, aNumBytes) )
+    {
+        do_drop_pending_jobs(aQueuePtr, &dropped_jobs, aNumBytes);
+    }
+
+    // workers are started lazily --- with the first job after the pool was resized
+    if ( do_is_queue_full(aQueuePtr, aNumBytes) ||
+         ((do_spawn_workers() != 0) && (The_Live_Workers == 0)) )
+    {
+        aQueuePtr->num_dropped_jobs += 1;
+
+        g_mutex_unlock(&The_Pool_Mutex);
+
+        do_run_drop_funcs(&dropped_jobs);
+
+        return -1;
+    }
+
+    FrameEncoderJob_t * job_ptr = g_new(FrameEncoderJob_t, 1);
+
+    job_ptr->run_func  = aRunFunc;
+    job_ptr->drop_func = aDropFunc;
+    job_ptr->data_ptr  = aDataPtr;
+    job_ptr->num_bytes = aNumBytes;
+    job_ptr->submit_us = g_get_monotonic_time();
+
+    g_queue_push_tail(&aQueuePtr->pending_jobs, job_ptr);
+
+    The_Pending_Jobs  += 1;
+    The_Pending_Bytes += aNumBytes;
+
+    // possibly --- the queue was idle --- it starts a new turn without old credit
+    if ( (! aQueuePtr->is_scheduled) && (! aQueuePtr->is_running) )
+    {
+        aQueuePtr->deficit_bytes = 0;
+        aQueuePtr->is_scheduled  = TRUE;
+
+        g_queue_push_tail(&The_Run_Queue, aQueuePtr);
+
+        g_cond_signal(&The_Work_Cond);
+    }
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    do_run_drop_funcs(&dropped_jobs);
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_queue_flush(aQueuePtr)
+//
+// drops pending jobs, waits for a running job and clears the count of dropped jobs ---
+// returns number of flushed jobs
+//=======================================================================================
+guint frame_encoder_queue_flush(FrameEncoderQueue_t * aQueuePtr)
+{
+    GQueue dropped_jobs = G_QUEUE_INIT;
+
+    g_mutex_lock(&The_Pool_Mutex);
+
+    if (aQueuePtr->is_scheduled)
+    {
+        g_queue_remove(&The_Run_Queue, aQueuePtr);
+
+        aQueuePtr->is_scheduled = FALSE;
+    }
+
+    dropped_jobs = aQueuePtr->pending_jobs;
+
+    g_queue_init(&aQueuePtr->pending_jobs);
+
+    The_Pending_Jobs -= dropped_jobs.length;
+
+    GList * link_ptr;
+
+    for ( link_ptr = dropped_jobs.head;  link_ptr != NULL;  link_ptr = link_ptr->next )
+    {
+        The_Pending_Bytes -= ((FrameEncoderJob_t *) link_ptr->data)->num_bytes;
+    }
+
+    aQueuePtr->num_dropped_jobs = 0;
+
+    aQueuePtr->num_waits   = 0;
+    aQueuePtr->sum_wait_us = 0;
+    aQueuePtr->max_wait_us = 0;
+
+    while (aQueuePtr->is_running)
+    {
+        g_cond_wait(&The_Idle_Cond, &The_Pool_Mutex);
+    }
+
+    g_mutex_unlock(&The_Pool_Mutex);
+
+    guint count = dropped_jobs.length;
+
+    do_run_drop_funcs(&dropped_jobs);
+
+    return count;
+}
@@ -0,0 +1,177 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_pool.h
+ *
+ * Purpose:     external interface (API) for code in "frame_encoder_pool.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Queue depth, overload policies and a bytes budget
+ *              3. 2026-10-17               Weighted fair scheduling and queue wait times
+ *              4. 2026-10-17               Pending jobs of a queue
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Encoder_Pool_H__
+
+#define __Frame_Encoder_Pool_H__
+
+#include <glib.h>
+
+
+#define  DEFAULT_POOL_WORKERS           (2)
+#define  MAX_POOL_WORKERS               (64)
+#define  MAX_POOL_PENDING_JOBS          (64)
+#define  DEFAULT_QUEUE_DEPTH            (4)
+#define  DEFAULT_POOL_BUDGET_MB         (256)
+#define  MAX_POOL_BUDGET_MB             (65536)
+#define  DEFAULT_QUEUE_WEIGHT           (1)
+#define  MAX_QUEUE_WEIGHT               (16)
+#define  POOL_QUANTUM_BYTES             (1 << 20)
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef void (*FrameEncoderJobFunc_t)(gpointer aJobDataPtr);
+
+typedef enum
+{
+    e_QUEUE_DROP_NEWEST = 0,        // a full queue refuses the new job
+    e_QUEUE_DROP_OLDEST,            // a full queue drops its oldest jobs to fit the new one
+    e_QUEUE_KEEP_LATEST             // a full queue drops all its jobs --- coalesces to the new one
+
+} QUEUE_POLICY_e;
+
+typedef struct _FrameEncoderQueue_t
+{
+    GQueue      pending_jobs;       // jobs waiting for a worker --- FIFO per instance
+
+    gboolean    is_scheduled,       // TRUE while queued in the pool's run-queue
+                is_running;         // TRUE while a worker runs one of its jobs
+
+    guint       max_pending_jobs;   // depth of the queue --- 0 is bounded by the pool only
+    QUEUE_POLICY_e policy;          // what is dropped when the queue or the pool is full
+    guint       num_dropped_jobs;   // dropped by the policy --- not counting flushed jobs
+
+    guint       weight;             // share of the workers' bytes --- 1..MAX_QUEUE_WEIGHT
+    gint64      deficit_bytes;      // bytes it may still encode in this round-robin turn
+
+    guint       num_waits;          // jobs taken by a worker since the queue was flushed
+    gint64      sum_wait_us,        // total of micros the jobs were pending
+                max_wait_us;        // maximum micros one job was pending
+
+} FrameEncoderQueue_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_pool_set_size(aNumWorkers)
+//
+// sets the number of shared worker threads --- 0 encodes on the caller's thread
+//=======================================================================================
+gint frame_encoder_pool_set_size(guint aNumWorkers);
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_pool_get_size()
+//
+// returns the number of shared worker threads requested by the most recent set_size
+//=======================================================================================
+guint frame_encoder_pool_get_size(void);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_pool_set_budget(aMaxBytes)
+//
+// bounds the bytes of all pending jobs of all instances --- 0 is unbounded --- returns 0
+//=======================================================================================
+gint frame_encoder_pool_set_budget(gsize aMaxBytes);
+
+
+//=======================================================================================
+// synopsis: frame_encoder_queue_init(aQueuePtr)
+//
+// initializes the per-instance queue --- jobs of one queue never run concurrently
+//=======================================================================================
+void frame_encoder_queue_init(FrameEncoderQueue_t * aQueuePtr);
+
+
+//=======================================================================================
+// synopsis: frame_encoder_queue_set_limits(aQueuePtr, aMaxPendingJobs, aPolicy)
+//
+// sets the depth of the queue (0 is bounded by the pool only) and its overload policy
+//=======================================================================================
+void frame_encoder_queue_set_limits(FrameEncoderQueue_t * aQueuePtr, guint aMaxPendingJobs, QUEUE_POLICY_e aPolicy);
+
+
+//=======================================================================================
+// synopsis: frame_encoder_queue_set_weight(aQueuePtr, aWeight)
+//
+// sets the queue's share of the workers --- a queue of weight 2 encodes twice the bytes
+//=======================================================================================
+void frame_encoder_queue_set_weight(FrameEncoderQueue_t * aQueuePtr, guint aWeight);
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_queue_get_waits(aQueuePtr, aSumPtr, aMaxPtr)
+//
+// gets total and maximum micros the queue's jobs waited for a worker since it was last
+// flushed --- returns the number of jobs
+//=======================================================================================
+guint frame_encoder_queue_get_waits(FrameEncoderQueue_t * aQueuePtr, gint64 * aSumPtr, gint64 * aMaxPtr);
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_queue_get_pending(aQueuePtr)
+//
+// returns the number of the queue's jobs waiting for a worker
+//=======================================================================================
+guint frame_encoder_queue_get_pending(FrameEncoderQueue_t * aQueuePtr);
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_queue_get_drops(aQueuePtr)
+//
+// returns the number of jobs dropped by the queue's policy since it was last flushed
+//=======================================================================================
+guint frame_encoder_queue_get_drops(FrameEncoderQueue_t * aQueuePtr);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_pool_submit(aQueuePtr, aRunFunc, aDropFunc, aDataPtr, aNumBytes)
+//
+// enqueues one job which holds aNumBytes --- returns 0 on success, else -1 when refused
+//
+// aRunFunc runs on a worker thread, aDropFunc runs instead when the job is flushed or
+// dropped by the queue's policy; both must release aDataPtr. Nothing is called when the
+// submit is refused --- a refused job is counted as dropped.
+//=======================================================================================
+gint frame_encoder_pool_submit(FrameEncoderQueue_t   * aQueuePtr,
+                               FrameEncoderJobFunc_t   aRunFunc,
+                               FrameEncoderJobFunc_t   aDropFunc,
+                               gpointer                aDataPtr,
+                               gsize                   aNumBytes);
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_queue_flush(aQueuePtr)
+//
+// drops pending jobs, waits for a running job and clears the counts of dropped jobs and
+// of waits --- returns number of flushed jobs
+//=======================================================================================
+guint frame_encoder_queue_flush(FrameEncoderQueue_t * aQueuePtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Encoder_Pool_H__
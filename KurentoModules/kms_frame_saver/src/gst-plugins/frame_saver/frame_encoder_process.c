@@ -0,0 +1,649 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_process.c
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Description: Encodes the snaps in a separate process, "kms-framesaver-encoder", so that
+ *              a crash of an encoder (e.g. libpng on a corrupt frame) fails one image, not
+ *              the media server, and so that the encoders may be placed in their own cgroup
+ *              with a CPU quota.
+ *
+ *              The plugin's process and the encoder process share a ring of slots in an
+ *              anonymous file (memfd). A worker takes a free slot, copies its frame there
+ *              once (see frame_encoder_ring.c), signals the slot's "submit" eventfd, then
+ *              waits for its "done" eventfd. The encoder process has one thread per slot,
+ *              which scales and encodes the samples in place and writes the image file.
+ *
+ *              The ring's file and the eventfds are passed over a socket pair at start. The
+ *              encoder process exits when its end of the socket is closed, and the plugin's
+ *              end hangs up when the encoder process dies. A job that sees a hang-up, or
+ *              times out, kills and reaps the encoder process --- no new jobs start until
+ *              all jobs of the dead process have failed, then the next job starts a new one,
+ *              at most once per PROCESS_RESTART_MS.
+ *
+ *              The encoder process inherits the CPUs and scheduling of the thread starting
+ *              it --- an encoder worker --- and is otherwise left to its cgroup.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE         // memfd_create()
+#endif
+
+#include "frame_encoder_process.h"
+#include "frame_encoder_ring.h"
+
+#include <gst/gst.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <signal.h>
+#include <spawn.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+
+#define  PROCESS_SOCKET_FD      (3)         // the encoder process's end of the socket pair
+
+extern char ** environ;
+
+
+static GMutex   The_Process_Mutex;          // static GMutex needs no initialization
+
+static GCond    The_Slots_Cond;             // signaled when a slot is freed, or the process dies
+
+static guint    The_Num_Slots = 0;          // 0 when images are encoded in-process
+
+static guint    The_Busy_Slots = 0;         // bit per slot taken by a job
+
+static gboolean The_Is_Stopping = FALSE;    // the ring is being replaced
+
+static void   * The_Ring_Ptr = NULL;
+
+static size_t   The_Ring_Lng = 0;
+
+static int      The_Ring_Fd = -1;
+
+static int      The_Submit_Fds[MAX_PROCESS_SLOTS];
+
+static int      The_Done_Fds[MAX_PROCESS_SLOTS];
+
+static int      The_Socket_Fd = -1;         // -1 while no encoder process runs
+
+static pid_t    The_Process_Pid = -1;
+
+static guint    The_Process_Generation = 0; // changes whenever an encoder process stops
+
+static gint64   The_Started_us = 0;         // monotonic time of the last start
+
+static guint    The_Num_Restarts = 0;
+
+
+//=======================================================================================
+// synopsis: result = do_send_ring_fds(aSocketFd)
+//
+// passes the ring's file and eventfds to the encoder process, then waits for its reply
+// --- returns 0 on success, else -1
+//=======================================================================================
+static gint do_send_ring_fds(int aSocketFd)
+{
+    int       fds_array[1 + (2 * MAX_PROCESS_SLOTS)];
+    guint32   num_slots = The_Num_Slots;
+    guint     index, num_fds = 0;
+
+    fds_array[num_fds++] = The_Ring_Fd;
+
+    for ( index = 0;  index < The_Num_Slots;  ++index )
+    {
+        fds_array[num_fds++] = The_Submit_Fds[index];
+    }
+
+    for ( index = 0;  index < The_Num_Slots;  ++index )
+    {
+        fds_array[num_fds++] = The_Done_Fds[index];
+    }
+
+    union
+    {
+        char            buffer[CMSG_SPACE(sizeof(fds_array))];
+        struct cmsghdr  align;
+
+    } control;
+
+    struct iovec  io_vector = { &num_slots, sizeof(num_slots) };
+    struct msghdr message;
+
+    memset(&control, 0, sizeof(control));
+    memset(&message, 0, sizeof(message));
+
+    message.msg_iov        = &io_vector;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control.buffer;
+    message.msg_controllen = CMSG_SPACE(num_fds * sizeof(int));
+
+    struct cmsghdr * cmsg_ptr = CMSG_FIRSTHDR(&message);
+
+    cmsg_ptr->cmsg_level = SOL_SOCKET;
+    cmsg_ptr->cmsg_type  = SCM_RIGHTS;
+    cmsg_ptr->cmsg_len   = CMSG_LEN(num_fds * sizeof(int));
+
+    memcpy(CMSG_DATA(cmsg_ptr), fds_array, num_fds * sizeof(int));
+
+    if (sendmsg(aSocketFd, &message, MSG_NOSIGNAL) != (ssize_t) sizeof(num_slots))
+    {
+        return -1;
+    }
+
+    // the reply tells the ring is mapped and checked --- a hang-up tells it is not
+    struct pollfd poll_fd = { aSocketFd, POLLIN, 0 };
+
+    char reply = 0;
+
+    if ( (poll(&poll_fd, 1, PROCESS_START_TIMEOUT_MS) != 1) || (read(aSocketFd, &reply, 1) != 1) || (reply != 'R') )
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: result = do_start_process()
+//
+// called with the mutex held and no encoder process --- starts one for the ring ---
+// returns 0 on success, else -1
+//=======================================================================================
+static gint do_start_process()
+{
+    int  sockets_array[2];
+    char fd_text[12];
+
+    The_Started_us = g_get_monotonic_time();
+
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets_array) != 0)
+    {
+        GST_WARNING("Failed creating encoder process socket --- (%s) \n", g_strerror(errno));
+        return -1;
+    }
+
+    // dup2() of an fd onto itself would keep its FD_CLOEXEC
+    if (sockets_array[1] == PROCESS_SOCKET_FD)
+    {
+        int moved_fd = fcntl(sockets_array[1], F_DUPFD_CLOEXEC, PROCESS_SOCKET_FD + 1);
+
+        close(sockets_array[1]);
+
+        sockets_array[1] = moved_fd;
+    }
+
+    snprintf(fd_text, sizeof(fd_text), "%d", PROCESS_SOCKET_FD);
+
+    char * argv_array[] = { (char *) ENCODER_PROCESS_NAME, fd_text, NULL };
+
+    posix_spawn_file_actions_t file_actions;
+
+    posix_spawn_file_actions_init(&file_actions);
+    posix_spawn_file_actions_adddup2(&file_actions, sockets_array[1], PROCESS_SOCKET_FD);
+
+    pid_t pid = -1;
+
+    #ifdef FRAME_ENCODER_PROCESS_PATH
+        int error = (sockets_array[1] < 0) ? EBADF :
+                    posix_spawn(&pid, FRAME_ENCODER_PROCESS_PATH, &file_actions, NULL, argv_array, environ);
+    #else
+        int error = (sockets_array[1] < 0) ? EBADF :
+                    posix_spawnp(&pid, ENCODER_PROCESS_NAME, &file_actions, NULL, argv_array, environ);
+    #endif
+
+    posix_spawn_file_actions_destroy(&file_actions);
+
+    if (sockets_array[1] >= 0)
+    {
+        close(sockets_array[1]);
+    }
+
+    if (error != 0)
+    {
+        GST_WARNING("Failed starting encoder process --- (%s) \n", g_strerror(error));
+
+        close(sockets_array[0]);
+        return -1;
+    }
+
+    if (do_send_ring_fds(sockets_array[0]) != 0)
+    {
+        GST_WARNING("Failed starting encoder process --- pid=%d did not map the ring \n", (int) pid);
+
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+
+        close(sockets_array[0]);
+        return -1;
+    }
+
+    The_Socket_Fd   = sockets_array[0];
+    The_Process_Pid = pid;
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: do_stop_process()
+//
+// called with the mutex held --- kills and reaps the encoder process, if any
+//=======================================================================================
+static void do_stop_process()
+{
+    if (The_Process_Pid > 0)
+    {
+        kill(The_Process_Pid, SIGKILL);
+        waitpid(The_Process_Pid, NULL, 0);
+    }
+
+    if (The_Socket_Fd >= 0)
+    {
+        close(The_Socket_Fd);
+    }
+
+    The_Process_Pid = -1;
+    The_Socket_Fd   = -1;
+
+    The_Process_Generation += 1;
+}
+
+
+//=======================================================================================
+// synopsis: do_close_ring()
+//
+// called with the mutex held and no encoder process --- unmaps and closes the ring
+//=======================================================================================
+static void do_close_ring()
+{
+    guint index;
+
+    for ( index = 0;  index < The_Num_Slots;  ++index )
+    {
+        close(The_Submit_Fds[index]);
+        close(The_Done_Fds[index]);
+    }
+
+    if (The_Ring_Ptr != NULL)
+    {
+        munmap(The_Ring_Ptr, The_Ring_Lng);
+    }
+
+    if (The_Ring_Fd >= 0)
+    {
+        close(The_Ring_Fd);
+    }
+
+    The_Ring_Ptr  = NULL;
+    The_Ring_Lng  = 0;
+    The_Ring_Fd   = -1;
+    The_Num_Slots = 0;
+}
+
+
+//=======================================================================================
+// synopsis: result = do_open_ring(aNumSlots, aSlotMB)
+//
+// called with the mutex held and no ring --- returns 0 on success, else -1
+//=======================================================================================
+static gint do_open_ring(guint aNumSlots, guint aSlotMB)
+{
+    size_t slot_bytes = (size_t) aSlotMB << 20;
+
+    size_t ring_lng = frame_encoder_ring_get_size(aNumSlots, slot_bytes);
+
+    int ring_fd = memfd_create(ENCODER_PROCESS_NAME, MFD_CLOEXEC);
+
+    if ( (ring_fd < 0) || (ftruncate(ring_fd, (off_t) ring_lng) != 0) )
+    {
+        GST_WARNING("Failed creating encoder ring of %u MB --- (%s) \n", aNumSlots * aSlotMB, g_strerror(errno));
+
+        if (ring_fd >= 0)
+        {
+            close(ring_fd);
+        }
+
+        return -1;
+    }
+
+    void * ring_ptr = mmap(NULL, ring_lng, PROT_READ | PROT_WRITE, MAP_SHARED, ring_fd, 0);
+
+    if (ring_ptr == MAP_FAILED)
+    {
+        GST_WARNING("Failed mapping encoder ring --- (%s) \n", g_strerror(errno));
+
+        close(ring_fd);
+        return -1;
+    }
+
+    frame_encoder_ring_init(ring_ptr, aNumSlots, slot_bytes);
+
+    The_Ring_Ptr = ring_ptr;
+    The_Ring_Lng = ring_lng;
+    The_Ring_Fd  = ring_fd;
+
+    // blocking --- the flags are shared with the encoder process, which blocks on its reads
+    for ( The_Num_Slots = 0;  The_Num_Slots < aNumSlots;  ++The_Num_Slots )
+    {
+        The_Submit_Fds[The_Num_Slots] = eventfd(0, EFD_CLOEXEC);
+        The_Done_Fds[The_Num_Slots]   = eventfd(0, EFD_CLOEXEC);
+
+        if ( (The_Submit_Fds[The_Num_Slots] < 0) || (The_Done_Fds[The_Num_Slots] < 0) )
+        {
+            GST_WARNING("Failed creating encoder ring events --- (%s) \n", g_strerror(errno));
+
+            if (The_Submit_Fds[The_Num_Slots] >= 0)
+            {
+                close(The_Submit_Fds[The_Num_Slots]);
+            }
+
+            if (The_Done_Fds[The_Num_Slots] >= 0)
+            {
+                close(The_Done_Fds[The_Num_Slots]);
+            }
+
+            do_close_ring();
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_process_set_ring(aNumSlots, aSlotMB)
+//
+// starts the encoder process with a ring of aNumSlots frames of up to aSlotMB megabytes,
+// after the images being saved --- 0 slots stops it --- returns 0 on success, else -1
+//=======================================================================================
+gint frame_encoder_process_set_ring(guint aNumSlots, guint aSlotMB)
+{
+    if ( (aNumSlots > MAX_PROCESS_SLOTS) || ((aNumSlots > 0) && ((aSlotMB < 1) || (aSlotMB > MAX_PROCESS_SLOT_MB))) )
+    {
+        return -1;
+    }
+
+    g_mutex_lock(&The_Process_Mutex);
+
+    while (The_Is_Stopping)
+    {
+        g_cond_wait(&The_Slots_Cond, &The_Process_Mutex);
+    }
+
+    if ( (aNumSlots == The_Num_Slots) &&
+         ((aNumSlots == 0) || (((EncoderRingHeader_t *) The_Ring_Ptr)->slot_bytes == (guint64) aSlotMB << 20)) )
+    {
+        g_mutex_unlock(&The_Process_Mutex);
+        return 0;
+    }
+
+    The_Is_Stopping = TRUE;
+
+    while (The_Busy_Slots != 0)
+    {
+        g_cond_wait(&The_Slots_Cond, &The_Process_Mutex);
+    }
+
+    do_stop_process();
+    do_close_ring();
+
+    gint result = 0;
+
+    if (aNumSlots > 0)
+    {
+        result = do_open_ring(aNumSlots, aSlotMB);
+
+        result = (result != 0) ? result : do_start_process();
+
+        if (result != 0)
+        {
+            do_close_ring();
+        }
+    }
+
+    The_Is_Stopping = FALSE;
+
+    g_cond_broadcast(&The_Slots_Cond);
+
+    g_mutex_unlock(&The_Process_Mutex);
+
+    return result;
+}
+
+
+//=======================================================================================
+// synopsis: is_enabled = frame_encoder_process_is_enabled()
+//
+// returns TRUE iff images are encoded by the encoder process
+//=======================================================================================
+gboolean frame_encoder_process_is_enabled(void)
+{
+    g_mutex_lock(&The_Process_Mutex);
+
+    gboolean is_enabled = (The_Num_Slots > 0);
+
+    g_mutex_unlock(&The_Process_Mutex);
+
+    return is_enabled;
+}
+
+
+//=======================================================================================
+// synopsis: slot_index = do_take_slot(aGenerationPtr, aSocketFdPtr)
+//
+// waits for a free slot, starts the encoder process if needed --- gets the process's
+// generation and a duplicate of its socket --- returns the slot, else -1
+//=======================================================================================
+static gint do_take_slot(guint * aGenerationPtr, int * aSocketFdPtr)
+{
+    g_mutex_lock(&The_Process_Mutex);
+
+    // a dead process is restarted after all of its jobs have failed
+    while ( (The_Num_Slots > 0) &&
+            (The_Is_Stopping || (The_Busy_Slots == (1u << The_Num_Slots) - 1) ||
+             ((The_Socket_Fd < 0) && (The_Busy_Slots != 0))) )
+    {
+        g_cond_wait(&The_Slots_Cond, &The_Process_Mutex);
+    }
+
+    gint slot_index = -1;
+
+    if ( (The_Num_Slots > 0) && (The_Socket_Fd < 0) &&
+         (g_get_monotonic_time() - The_Started_us >= (gint64) PROCESS_RESTART_MS * 1000) )
+    {
+        The_Num_Restarts += 1;
+
+        GST_WARNING("Restarting encoder process --- restarts=%u \n", The_Num_Restarts);
+
+        do_start_process();
+    }
+
+    if (The_Socket_Fd >= 0)
+    {
+        *aSocketFdPtr = fcntl(The_Socket_Fd, F_DUPFD_CLOEXEC, 0);
+
+        if (*aSocketFdPtr >= 0)
+        {
+            for ( slot_index = 0;  (The_Busy_Slots & (1u << slot_index)) != 0;  ++slot_index )
+            {
+                continue;
+            }
+
+            The_Busy_Slots |= (1u << slot_index);
+
+            *aGenerationPtr = The_Process_Generation;
+        }
+    }
+
+    g_mutex_unlock(&The_Process_Mutex);
+
+    return slot_index;
+}
+
+
+//=======================================================================================
+// synopsis: do_drain_event(aEventFd)
+//
+// resets an eventfd without blocking
+//=======================================================================================
+static void do_drain_event(int aEventFd)
+{
+    struct pollfd poll_fd = { aEventFd, POLLIN, 0 };
+
+    guint64 count;
+
+    if ( (poll(&poll_fd, 1, 0) == 1) && (read(aEventFd, &count, sizeof(count)) != sizeof(count)) )
+    {
+        GST_WARNING("Failed resetting encoder ring event --- (%s) \n", g_strerror(errno));
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_free_slot(aSlotIndex, aGeneration, aIsDead)
+//
+// frees a slot --- a job which saw its process die, or hang, stops that process
+//=======================================================================================
+static void do_free_slot(gint aSlotIndex, guint aGeneration, gboolean aIsDead)
+{
+    g_mutex_lock(&The_Process_Mutex);
+
+    if (aIsDead && (aGeneration == The_Process_Generation))
+    {
+        GST_WARNING("Stopped encoder process --- pid=%d \n", (int) The_Process_Pid);
+
+        do_stop_process();
+    }
+
+    // a dead process may leave the slot's signals unread --- the next one must not see them
+    if (aIsDead)
+    {
+        do_drain_event(The_Submit_Fds[aSlotIndex]);
+        do_drain_event(The_Done_Fds[aSlotIndex]);
+    }
+
+    The_Busy_Slots &= ~(1u << aSlotIndex);
+
+    g_cond_broadcast(&The_Slots_Cond);
+
+    g_mutex_unlock(&The_Process_Mutex);
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_process_save(aPathPtr, aFormatPtr, aFramePtr, aOptionsPtr)
+//
+// copies a frame to a free slot of the ring, then waits for the encoder process to scale,
+// encode and write it --- a crashed or stuck encoder process is restarted by a later call
+// --- returns 0 on success, else error
+//=======================================================================================
+gint frame_encoder_process_save(const char             * aPathPtr,
+                                const char             * aFormatPtr,
+                                const PixelsFrame_t    * aFramePtr,
+                                const EncoderOptions_t * aOptionsPtr)
+{
+    guint generation = 0;
+    int   socket_fd  = -1;
+
+    gint slot_index = do_take_slot(&generation, &socket_fd);
+
+    if (slot_index < 0)
+    {
+        return -1;      // no ring, or the encoder process cannot start
+    }
+
+    // the ring, the slot's fds and its job stay valid until the slot is freed
+    if (frame_encoder_ring_put_frame(The_Ring_Ptr, (unsigned) slot_index, aPathPtr, aFormatPtr, aFramePtr, aOptionsPtr) != 0)
+    {
+        close(socket_fd);
+
+        do_free_slot(slot_index, generation, FALSE);
+        return -2;      // larger than a slot
+    }
+
+    guint64 count = 1;
+
+    gint result = -3;
+
+    gboolean is_dead = (write(The_Submit_Fds[slot_index], &count, sizeof(count)) != sizeof(count));
+
+    gint64 deadline_us = g_get_monotonic_time() + ((gint64) PROCESS_JOB_TIMEOUT_MS * 1000);
+
+    while (! is_dead)
+    {
+        struct pollfd poll_fds[2] = { { The_Done_Fds[slot_index], POLLIN, 0 }, { socket_fd, POLLIN, 0 } };
+
+        gint64 left_us = deadline_us - g_get_monotonic_time();
+
+        int num_ready = (left_us <= 0) ? 0 : poll(poll_fds, 2, (int) ((left_us + 999) / 1000));
+
+        if ( (num_ready < 0) && (errno == EINTR) )
+        {
+            continue;
+        }
+
+        if (poll_fds[0].revents & POLLIN)
+        {
+            if (read(The_Done_Fds[slot_index], &count, sizeof(count)) == sizeof(count))
+            {
+                result = frame_encoder_ring_get_job(The_Ring_Ptr, (unsigned) slot_index)->result;
+            }
+
+            break;
+        }
+
+        // the encoder process never writes to the socket after its start --- only hangs up
+        if (num_ready != 0)
+        {
+            GST_WARNING("Encoder process died saving (%s) \n", aPathPtr);
+
+            is_dead = TRUE;
+        }
+        else
+        {
+            GST_WARNING("Encoder process hung saving (%s) \n", aPathPtr);
+
+            is_dead = TRUE;
+            result  = -4;
+        }
+    }
+
+    close(socket_fd);
+
+    do_free_slot(slot_index, generation, is_dead);
+
+    return result;
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_process_get_restarts()
+//
+// returns the number of times the encoder process was restarted after it crashed or hung
+//=======================================================================================
+guint frame_encoder_process_get_restarts(void)
+{
+    g_mutex_lock(&The_Process_Mutex);
+
+    guint count = The_Num_Restarts;
+
+    g_mutex_unlock(&The_Process_Mutex);
+
+    return count;
+}
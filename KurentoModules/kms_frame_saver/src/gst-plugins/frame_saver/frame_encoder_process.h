@@ -0,0 +1,81 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_process.h
+ *
+ * Purpose:     external interface (API) for code in "frame_encoder_process.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Encoder_Process_H__
+
+#define __Frame_Encoder_Process_H__
+
+#include <glib.h>
+
+#include "frame_encoders.h"
+
+
+#define  ENCODER_PROCESS_NAME           "kms-framesaver-encoder"
+#define  DEFAULT_PROCESS_SLOTS          (2)
+#define  MAX_PROCESS_SLOTS              (16)
+#define  DEFAULT_PROCESS_SLOT_MB        (16)
+#define  MAX_PROCESS_SLOT_MB            (256)
+#define  PROCESS_START_TIMEOUT_MS       (5000)      // the encoder process maps the ring and replies
+#define  PROCESS_JOB_TIMEOUT_MS         (10000)     // an image taking longer kills the encoder process
+#define  PROCESS_RESTART_MS             (1000)      // minimal interval between restarts
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_process_set_ring(aNumSlots, aSlotMB)
+//
+// starts the encoder process with a ring of aNumSlots frames of up to aSlotMB megabytes,
+// after the images being saved --- 0 slots stops it --- returns 0 on success, else -1
+//=======================================================================================
+gint frame_encoder_process_set_ring(guint aNumSlots, guint aSlotMB);
+
+
+//=======================================================================================
+// synopsis: is_enabled = frame_encoder_process_is_enabled()
+//
+// returns TRUE iff images are encoded by the encoder process
+//=======================================================================================
+gboolean frame_encoder_process_is_enabled(void);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_process_save(aPathPtr, aFormatPtr, aFramePtr, aOptionsPtr)
+//
+// copies a frame to a free slot of the ring, then waits for the encoder process to scale,
+// encode and write it --- a crashed or stuck encoder process is restarted by a later call
+// --- returns 0 on success, else error
+//=======================================================================================
+gint frame_encoder_process_save(const char             * aPathPtr,
+                                const char             * aFormatPtr,
+                                const PixelsFrame_t    * aFramePtr,
+                                const EncoderOptions_t * aOptionsPtr);
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_process_get_restarts()
+//
+// returns the number of times the encoder process was restarted after it crashed or hung
+//=======================================================================================
+guint frame_encoder_process_get_restarts(void);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Encoder_Process_H__
@@ -0,0 +1,271 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_process_main.c
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Description: The encoder process, "kms-framesaver-encoder", started by the plugin with
+ *              "proc=" (see frame_encoder_process.c) --- never by hand.
+ *
+ *              Its argument is the fd of its end of a socket pair, which brings the ring's
+ *              file and eventfds. One thread per slot waits for the slot's "submit" event,
+ *              scales and encodes the frame in place, writes the image file, then stores
+ *              the result in the slot and signals its "done" event.
+ *
+ *              The process exits when the plugin closes the socket, or dies. It only links
+ *              the encoders, which are free of GLib and of GStreamer.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "frame_encoder_ring.h"
+#include "frame_encoder_scratch.h"
+#include "frame_encoders.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+
+#define  MAX_RING_SLOTS     (64)
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef struct _RingSlot_t
+{
+    void      * ring_ptr;
+    unsigned    slot_index;
+    int         submit_fd,
+                done_fd;
+
+} RingSlot_t;
+
+
+//=======================================================================================
+// synopsis: result = do_encode_frame(aJobPtr, aFramePtr, aOptionsPtr)
+//
+// scales a frame as the plugin would, then encodes it --- returns 0 on success, else error
+//=======================================================================================
+static int do_encode_frame(const EncoderRingJob_t * aJobPtr, const PixelsFrame_t * aFramePtr, EncoderOptions_t * aOptionsPtr)
+{
+    const FrameEncoder_t * encoder_ptr = frame_encoders_find(aJobPtr->format_name);
+
+    PixelsFrame_t pixels = *aFramePtr;
+
+    int scaled_cols, scaled_rows;
+
+    if (encoder_ptr == NULL)
+    {
+        return -1;
+    }
+
+    size_t scaled_lng = convert_frame_get_scaled_size(&pixels, aOptionsPtr->max_cols, aOptionsPtr->max_rows, &scaled_cols, &scaled_rows);
+
+    if (scaled_lng > 0)
+    {
+        uint8_t * scaled_ptr = frame_encoder_scratch_frame(aOptionsPtr->scratch_ptr, scaled_lng);
+
+        if ( (scaled_ptr == NULL) ||
+             (convert_frame_to_scaled(&pixels, aFramePtr, scaled_cols, scaled_rows, scaled_ptr) != 0) )
+        {
+            return -1;
+        }
+    }
+
+    return encoder_ptr->save_func(aJobPtr->image_path, &pixels, aOptionsPtr);
+}
+
+
+//=======================================================================================
+// synopsis: do_slot_thread_main(aSlotPtr)
+//
+// encodes the jobs of one slot --- exits the process if the plugin's events fail
+//=======================================================================================
+static void * do_slot_thread_main(void * aSlotPtr)
+{
+    RingSlot_t * slot_ptr = (RingSlot_t *) aSlotPtr;
+
+    EncoderScratch_t scratch;
+
+    memset(&scratch, 0, sizeof(scratch));
+
+    for ( ; ; )
+    {
+        uint64_t count;
+
+        ssize_t num_read = read(slot_ptr->submit_fd, &count, sizeof(count));
+
+        if (num_read != (ssize_t) sizeof(count))
+        {
+            if ( (num_read < 0) && (errno == EINTR) )
+            {
+                continue;
+            }
+
+            _exit(2);
+        }
+
+        EncoderRingJob_t * job_ptr = frame_encoder_ring_get_job(slot_ptr->ring_ptr, slot_ptr->slot_index);
+
+        PixelsFrame_t    pixels;
+        EncoderOptions_t options;
+
+        int result = frame_encoder_ring_get_frame(slot_ptr->ring_ptr, slot_ptr->slot_index, &pixels, &options);
+
+        if (result == 0)
+        {
+            options.scratch_ptr = &scratch;
+
+            result = do_encode_frame(job_ptr, &pixels, &options);
+        }
+
+        // the result must be visible before the plugin sees the event
+        __atomic_store_n(&job_ptr->result, (int32_t) result, __ATOMIC_RELEASE);
+
+        count = 1;
+
+        if (write(slot_ptr->done_fd, &count, sizeof(count)) != (ssize_t) sizeof(count))
+        {
+            _exit(2);
+        }
+    }
+
+    return NULL;
+}
+
+
+//=======================================================================================
+// synopsis: num_fds = do_receive_fds(aSocketFd, aFdsArray, aMaxFds)
+//
+// receives the ring's file and eventfds --- returns their number, else -1
+//=======================================================================================
+static int do_receive_fds(int aSocketFd, int * aFdsArray, int aMaxFds)
+{
+    union
+    {
+        char            buffer[CMSG_SPACE(sizeof(int) * (1 + (2 * MAX_RING_SLOTS)))];
+        struct cmsghdr  align;
+
+    } control;
+
+    uint32_t      num_slots = 0;
+    struct iovec  io_vector = { &num_slots, sizeof(num_slots) };
+    struct msghdr message;
+
+    memset(&message, 0, sizeof(message));
+
+    message.msg_iov        = &io_vector;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    if (recvmsg(aSocketFd, &message, MSG_CMSG_CLOEXEC) != (ssize_t) sizeof(num_slots))
+    {
+        return -1;
+    }
+
+    struct cmsghdr * cmsg_ptr = CMSG_FIRSTHDR(&message);
+
+    if ( (cmsg_ptr == NULL) || (cmsg_ptr->cmsg_level != SOL_SOCKET) || (cmsg_ptr->cmsg_type != SCM_RIGHTS) )
+    {
+        return -1;
+    }
+
+    int num_fds = (int) ((cmsg_ptr->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+
+    if ( (num_fds > aMaxFds) || (num_fds != (int) (1 + (2 * num_slots))) )
+    {
+        return -1;
+    }
+
+    memcpy(aFdsArray, CMSG_DATA(cmsg_ptr), num_fds * sizeof(int));
+
+    return num_fds;
+}
+
+
+//=======================================================================================
+// synopsis: main(argc, argv)
+//=======================================================================================
+int main(int argc, char * argv[])
+{
+    static RingSlot_t  slots_array[MAX_RING_SLOTS];
+
+    int         fds_array[1 + (2 * MAX_RING_SLOTS)];
+    struct stat ring_stat;
+    char        reply = 'R';
+
+    int socket_fd = (argc == 2) ? atoi(argv[1]) : -1;
+
+    // no PR_SET_PDEATHSIG --- it would follow the thread which started the process, an
+    // encoder worker which may exit --- the socket hangs up when the plugin's process dies
+    signal(SIGPIPE, SIG_IGN);
+
+    int num_fds = (socket_fd < 0) ? -1 : do_receive_fds(socket_fd, fds_array, (int) (sizeof(fds_array) / sizeof(int)));
+
+    if ( (num_fds < 3) || (fstat(fds_array[0], &ring_stat) != 0) )
+    {
+        fprintf(stderr, "%s: must be started by the frame-saver plugin \n", argv[0]);
+        return 1;
+    }
+
+    size_t ring_lng = (size_t) ring_stat.st_size;
+
+    void * ring_ptr = mmap(NULL, ring_lng, PROT_READ | PROT_WRITE, MAP_SHARED, fds_array[0], 0);
+
+    int slot_index, num_slots = (num_fds - 1) / 2;
+
+    if ( (ring_ptr == MAP_FAILED) || (frame_encoder_ring_check(ring_ptr, ring_lng) != num_slots) )
+    {
+        fprintf(stderr, "%s: invalid encoder ring \n", argv[0]);
+        return 1;
+    }
+
+    // the header places the slots --- a stray write must not move them for the plugin
+    mprotect(ring_ptr, (size_t) sysconf(_SC_PAGESIZE), PROT_READ);
+
+    for ( slot_index = 0;  slot_index < num_slots;  ++slot_index )
+    {
+        pthread_t thread_id;
+
+        slots_array[slot_index].ring_ptr   = ring_ptr;
+        slots_array[slot_index].slot_index = (unsigned) slot_index;
+        slots_array[slot_index].submit_fd  = fds_array[1 + slot_index];
+        slots_array[slot_index].done_fd    = fds_array[1 + num_slots + slot_index];
+
+        if (pthread_create(&thread_id, NULL, do_slot_thread_main, &slots_array[slot_index]) != 0)
+        {
+            fprintf(stderr, "%s: failed creating slot thread \n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (write(socket_fd, &reply, 1) != 1)
+    {
+        return 1;
+    }
+
+    // the plugin never writes again --- the read ends when it closes its end
+    for ( ; ; )
+    {
+        ssize_t num_read = read(socket_fd, &reply, 1);
+
+        if ( (num_read == 0) || ((num_read < 0) && (errno != EINTR)) )
+        {
+            break;
+        }
+    }
+
+    _exit(0);
+}
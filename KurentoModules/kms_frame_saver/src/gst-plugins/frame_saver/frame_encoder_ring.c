@@ -0,0 +1,339 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_ring.c
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Description: The layout of the shared memory between the plugin and the encoder process
+ *              --- a header, then slots which each hold one job and the samples of its
+ *              frame. Used by both processes, hence free of GLib and of GStreamer.
+ *
+ *              A frame is copied to its slot once, component extents only: the rows of a
+ *              cropped view, or the planes of a whole frame. Components which share bytes
+ *              (e.g. packed RGB, or the U,V plane of NV12) are copied as one block. The
+ *              encoder process describes the samples in place and encodes them without
+ *              another copy.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "frame_encoder_ring.h"
+
+#include <string.h>
+
+
+#define RING_PAGE_ALIGNMENT(N)      ( ((N) + 4095) & ~((uint64_t) 4095) )
+#define RING_BLOCK_ALIGNMENT(N)     ( ((N) + 63) & ~((uint64_t) 63) )
+
+
+//=======================================================================================
+// synopsis: pixels_ptr = do_get_slot_pixels(aRingPtr, aSlotIndex)
+//
+// returns the first byte of a slot's samples
+//=======================================================================================
+static uint8_t * do_get_slot_pixels(void * aRingPtr, unsigned aSlotIndex)
+{
+    return (uint8_t *) frame_encoder_ring_get_job(aRingPtr, aSlotIndex) + RING_PAGE_ALIGNMENT(sizeof(EncoderRingJob_t));
+}
+
+
+//=======================================================================================
+// synopsis: num_comps = do_get_extents(aFramePtr, aFirstArray, aLengthArray)
+//
+// gets the first byte and the length of each component's samples --- returns the number
+// of components, else -1 if the frame is invalid
+//=======================================================================================
+static int do_get_extents(const PixelsFrame_t * aFramePtr, const uint8_t * aFirstArray[3], uint64_t aLengthArray[3])
+{
+    int comp_index, num_comps = (aFramePtr->family == e_PIXELS_GRAY) ? 1 : 3;
+
+    if ( (aFramePtr->family < e_PIXELS_YUV) || (aFramePtr->family > e_PIXELS_GRAY) ||
+         (aFramePtr->num_cols < 1) || (aFramePtr->num_rows < 1) || ((aFramePtr->rows_shift & ~1) != 0) )
+    {
+        return -1;
+    }
+
+    for ( comp_index = 0;  comp_index < num_comps;  ++comp_index )
+    {
+        int is_chroma = (aFramePtr->family == e_PIXELS_YUV) && (comp_index > 0);
+
+        int num_cols  = is_chroma ? (aFramePtr->num_cols + 1) / 2 : aFramePtr->num_cols,
+            num_rows  = is_chroma ? (aFramePtr->num_rows + aFramePtr->rows_shift) >> aFramePtr->rows_shift : aFramePtr->num_rows;
+
+        if ( (aFramePtr->comps_array[comp_index] == NULL) ||
+             (aFramePtr->strides_array[comp_index] < 1) || (aFramePtr->pstrides_array[comp_index] < 1) )
+        {
+            return -1;
+        }
+
+        aFirstArray[comp_index]  = aFramePtr->comps_array[comp_index];
+        aLengthArray[comp_index] = ((uint64_t) (num_rows - 1) * aFramePtr->strides_array[comp_index]) +
+                                   ((uint64_t) (num_cols - 1) * aFramePtr->pstrides_array[comp_index]) + 1;
+    }
+
+    return num_comps;
+}
+
+
+//=======================================================================================
+// synopsis: length = frame_encoder_ring_get_size(aNumSlots, aSlotBytes)
+//
+// returns the bytes of a ring of aNumSlots slots of aSlotBytes pixels each
+//=======================================================================================
+size_t frame_encoder_ring_get_size(unsigned aNumSlots, size_t aSlotBytes)
+{
+    uint64_t slot_stride = RING_PAGE_ALIGNMENT(sizeof(EncoderRingJob_t)) + RING_PAGE_ALIGNMENT(aSlotBytes);
+
+    return (size_t) (RING_PAGE_ALIGNMENT(sizeof(EncoderRingHeader_t)) + (aNumSlots * slot_stride));
+}
+
+
+//=======================================================================================
+// synopsis: frame_encoder_ring_init(aRingPtr, aNumSlots, aSlotBytes)
+//
+// writes the header of a ring of frame_encoder_ring_get_size() bytes
+//=======================================================================================
+void frame_encoder_ring_init(void * aRingPtr, unsigned aNumSlots, size_t aSlotBytes)
+{
+    EncoderRingHeader_t * header_ptr = (EncoderRingHeader_t *) aRingPtr;
+
+    header_ptr->magic       = ENCODER_RING_MAGIC;
+    header_ptr->version     = ENCODER_RING_VERSION;
+    header_ptr->num_slots   = aNumSlots;
+    header_ptr->reserved    = 0;
+    header_ptr->slot_bytes  = aSlotBytes;
+    header_ptr->slot_stride = RING_PAGE_ALIGNMENT(sizeof(EncoderRingJob_t)) + RING_PAGE_ALIGNMENT(aSlotBytes);
+}
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_ring_check(aRingPtr, aRingLng)
+//
+// checks the header of a mapped ring --- returns its number of slots, else -1
+//=======================================================================================
+int frame_encoder_ring_check(const void * aRingPtr, size_t aRingLng)
+{
+    const EncoderRingHeader_t * header_ptr = (const EncoderRingHeader_t *) aRingPtr;
+
+    if ( (aRingLng < sizeof(EncoderRingHeader_t)) ||
+         (header_ptr->magic != ENCODER_RING_MAGIC) || (header_ptr->version != ENCODER_RING_VERSION) )
+    {
+        return -1;
+    }
+
+    if ( (header_ptr->num_slots < 1) || (header_ptr->slot_bytes > (uint64_t) aRingLng) ||
+         (frame_encoder_ring_get_size(header_ptr->num_slots, (size_t) header_ptr->slot_bytes) > aRingLng) )
+    {
+        return -1;
+    }
+
+    return (int) header_ptr->num_slots;
+}
+
+
+//=======================================================================================
+// synopsis: job_ptr = frame_encoder_ring_get_job(aRingPtr, aSlotIndex)
+//
+// returns the job of a slot --- its samples follow it
+//=======================================================================================
+EncoderRingJob_t * frame_encoder_ring_get_job(void * aRingPtr, unsigned aSlotIndex)
+{
+    const EncoderRingHeader_t * header_ptr = (const EncoderRingHeader_t *) aRingPtr;
+
+    return (EncoderRingJob_t *) ((uint8_t *) aRingPtr + RING_PAGE_ALIGNMENT(sizeof(EncoderRingHeader_t)) +
+                                                        (aSlotIndex * header_ptr->slot_stride));
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_ring_put_frame(aRingPtr, aSlotIndex, aPathPtr, aFormatPtr, aFramePtr, aOptionsPtr)
+//
+// copies the samples of a frame, or of a cropped view of it, to a slot with what the
+// encoder needs --- returns 0 on success, else -1 if it does not fit
+//=======================================================================================
+int frame_encoder_ring_put_frame(void                   * aRingPtr,
+                                 unsigned                 aSlotIndex,
+                                 const char             * aPathPtr,
+                                 const char             * aFormatPtr,
+                                 const PixelsFrame_t    * aFramePtr,
+                                 const EncoderOptions_t * aOptionsPtr)
+{
+    const EncoderRingHeader_t * header_ptr = (const EncoderRingHeader_t *) aRingPtr;
+
+    EncoderRingJob_t * job_ptr = frame_encoder_ring_get_job(aRingPtr, aSlotIndex);
+
+    uint8_t * pixels_ptr = do_get_slot_pixels(aRingPtr, aSlotIndex);
+
+    const uint8_t * first_array[3];
+    uint64_t        length_array[3];
+
+    int comp_index, num_comps = do_get_extents(aFramePtr, first_array, length_array);
+
+    if ( (num_comps < 1) || (strlen(aPathPtr) > PATH_MAX) || (strlen(aFormatPtr) > MAX_RING_FORMAT_LNG) )
+    {
+        return -1;
+    }
+
+    uint64_t num_bytes = 0;
+
+    int is_copied[3] = { 0, 0, 0 };
+
+    // each block starts at the first of its components --- later components which overlap
+    // it (e.g. G,B of packed RGB) are copied with it
+    for ( ; ; )
+    {
+        int first_index = -1;
+
+        for ( comp_index = 0;  comp_index < num_comps;  ++comp_index )
+        {
+            if ( ! is_copied[comp_index] && ((first_index < 0) || (first_array[comp_index] < first_array[first_index])) )
+            {
+                first_index = comp_index;
+            }
+        }
+
+        if (first_index < 0)
+        {
+            break;
+        }
+
+        const uint8_t * block_ptr = first_array[first_index];
+
+        uint64_t block_lng = 0;
+
+        for ( comp_index = 0;  comp_index < num_comps;  ++comp_index )
+        {
+            if ( ! is_copied[comp_index] && (first_array[comp_index] >= block_ptr) &&
+                 (first_array[comp_index] <= block_ptr + block_lng) )
+            {
+                uint64_t comp_end = (uint64_t) (first_array[comp_index] - block_ptr) + length_array[comp_index];
+
+                block_lng = (comp_end > block_lng) ? comp_end : block_lng;
+
+                job_ptr->comps_offsets[comp_index] = num_bytes + (uint64_t) (first_array[comp_index] - block_ptr);
+
+                is_copied[comp_index] = 1;
+
+                comp_index = -1;    // a longer block may overlap components checked before
+            }
+        }
+
+        if (num_bytes + block_lng > header_ptr->slot_bytes)
+        {
+            return -1;
+        }
+
+        memcpy(pixels_ptr + num_bytes, block_ptr, (size_t) block_lng);
+
+        num_bytes = RING_BLOCK_ALIGNMENT(num_bytes + block_lng);
+    }
+
+    strcpy(job_ptr->image_path,  aPathPtr);
+    strcpy(job_ptr->format_name, aFormatPtr);
+
+    job_ptr->quality      = aOptionsPtr->quality;
+    job_ptr->png_level    = aOptionsPtr->png.level;
+    job_ptr->png_filters  = aOptionsPtr->png.filters;
+    job_ptr->png_strategy = (int32_t) aOptionsPtr->png.strategy;
+    job_ptr->png_strips   = aOptionsPtr->png.num_strips;
+    job_ptr->max_cols     = aOptionsPtr->max_cols;
+    job_ptr->max_rows     = aOptionsPtr->max_rows;
+
+    job_ptr->family     = (int32_t) aFramePtr->family;
+    job_ptr->num_cols   = aFramePtr->num_cols;
+    job_ptr->num_rows   = aFramePtr->num_rows;
+    job_ptr->rows_shift = aFramePtr->rows_shift;
+
+    for ( comp_index = 0;  comp_index < 3;  ++comp_index )
+    {
+        job_ptr->comps_offsets[comp_index]  = (comp_index < num_comps) ? job_ptr->comps_offsets[comp_index] : 0;
+        job_ptr->strides_array[comp_index]  = aFramePtr->strides_array[comp_index];
+        job_ptr->pstrides_array[comp_index] = aFramePtr->pstrides_array[comp_index];
+    }
+
+    job_ptr->num_bytes = num_bytes;
+    job_ptr->result    = -1;
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_ring_get_frame(aRingPtr, aSlotIndex, aFramePtr, aOptionsPtr)
+//
+// describes the frame of a slot in place and sets the encoder's options (not the scratch)
+// --- returns 0 on success, else -1 if the job is invalid
+//=======================================================================================
+int frame_encoder_ring_get_frame(void             * aRingPtr,
+                                 unsigned           aSlotIndex,
+                                 PixelsFrame_t    * aFramePtr,
+                                 EncoderOptions_t * aOptionsPtr)
+{
+    const EncoderRingHeader_t * header_ptr = (const EncoderRingHeader_t *) aRingPtr;
+
+    EncoderRingJob_t * job_ptr = frame_encoder_ring_get_job(aRingPtr, aSlotIndex);
+
+    uint8_t * pixels_ptr = do_get_slot_pixels(aRingPtr, aSlotIndex);
+
+    const uint8_t * first_array[3];
+    uint64_t        length_array[3];
+
+    int comp_index;
+
+    job_ptr->image_path[PATH_MAX] = 0;
+    job_ptr->format_name[MAX_RING_FORMAT_LNG] = 0;
+
+    memset(aFramePtr, 0, sizeof(*aFramePtr));
+
+    aFramePtr->family     = (PIXELS_FAMILY_e) job_ptr->family;
+    aFramePtr->num_cols   = job_ptr->num_cols;
+    aFramePtr->num_rows   = job_ptr->num_rows;
+    aFramePtr->rows_shift = job_ptr->rows_shift;
+
+    // the extents first --- the components point into the slot once they are checked
+    for ( comp_index = 0;  comp_index < 3;  ++comp_index )
+    {
+        aFramePtr->comps_array[comp_index]    = pixels_ptr;
+        aFramePtr->strides_array[comp_index]  = job_ptr->strides_array[comp_index];
+        aFramePtr->pstrides_array[comp_index] = job_ptr->pstrides_array[comp_index];
+    }
+
+    int num_comps = do_get_extents(aFramePtr, first_array, length_array);
+
+    if ( (num_comps < 1) || (job_ptr->num_bytes > header_ptr->slot_bytes) )
+    {
+        return -1;
+    }
+
+    // the samples must not reach past the slot --- the other process is not trusted
+    for ( comp_index = 0;  comp_index < 3;  ++comp_index )
+    {
+        if (comp_index >= num_comps)
+        {
+            aFramePtr->comps_array[comp_index] = NULL;
+        }
+        else if ( (job_ptr->comps_offsets[comp_index] > job_ptr->num_bytes) ||
+                  (length_array[comp_index] > job_ptr->num_bytes - job_ptr->comps_offsets[comp_index]) )
+        {
+            return -1;
+        }
+        else
+        {
+            aFramePtr->comps_array[comp_index] = pixels_ptr + job_ptr->comps_offsets[comp_index];
+        }
+    }
+
+    memset(aOptionsPtr, 0, sizeof(*aOptionsPtr));
+
+    aOptionsPtr->quality        = job_ptr->quality;
+    aOptionsPtr->png.level      = job_ptr->png_level;
+    aOptionsPtr->png.filters    = job_ptr->png_filters;
+    aOptionsPtr->png.strategy   = (PNG_STRATEGY_e) job_ptr->png_strategy;
+    aOptionsPtr->png.num_strips = job_ptr->png_strips;
+    aOptionsPtr->max_cols       = job_ptr->max_cols;
+    aOptionsPtr->max_rows       = job_ptr->max_rows;
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_ring.h
+ *
+ * Purpose:     external interface (API) for code in "frame_encoder_ring.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Encoder_Ring_H__
+
+#define __Frame_Encoder_Ring_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include "frame_encoders.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+#define  ENCODER_RING_MAGIC             (0x46535652)    // "FSVR"
+#define  ENCODER_RING_VERSION           (1)
+#define  MAX_RING_FORMAT_LNG            (15)
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef struct _EncoderRingHeader_t
+{
+    uint32_t        magic,
+                    version,
+                    num_slots,
+                    reserved;
+
+    uint64_t        slot_bytes;             // pixels one slot holds
+    uint64_t        slot_stride;            // bytes from one slot to the next --- job and pixels
+
+} EncoderRingHeader_t;
+
+typedef struct _EncoderRingJob_t
+{
+    char            image_path[PATH_MAX + 1];
+    char            format_name[MAX_RING_FORMAT_LNG + 1];
+
+    int32_t         quality,                // EncoderOptions_t --- crops are applied by the sender
+                    png_level,
+                    png_filters,
+                    png_strategy,
+                    png_strips,
+                    max_cols,
+                    max_rows;
+
+    int32_t         family,                 // PixelsFrame_t --- the components are offsets in the slot
+                    num_cols,
+                    num_rows,
+                    rows_shift;
+    uint64_t        comps_offsets[3];
+    int32_t         strides_array[3],
+                    pstrides_array[3];
+
+    uint64_t        num_bytes;              // bytes of the samples copied to the slot
+
+    int32_t         result;                 // written by the encoder process --- 0 if saved
+
+} EncoderRingJob_t;
+
+
+//=======================================================================================
+// synopsis: length = frame_encoder_ring_get_size(aNumSlots, aSlotBytes)
+//
+// returns the bytes of a ring of aNumSlots slots of aSlotBytes pixels each
+//=======================================================================================
+extern size_t frame_encoder_ring_get_size(unsigned aNumSlots, size_t aSlotBytes);
+
+
+//=======================================================================================
+// synopsis: frame_encoder_ring_init(aRingPtr, aNumSlots, aSlotBytes)
+//
+// writes the header of a ring of frame_encoder_ring_get_size() bytes
+//=======================================================================================
+extern void frame_encoder_ring_init(void * aRingPtr, unsigned aNumSlots, size_t aSlotBytes);
+
+
+//=======================================================================================
+// synopsis: count = frame_encoder_ring_check(aRingPtr, aRingLng)
+//
+// checks the header of a mapped ring --- returns its number of slots, else -1
+//=======================================================================================
+extern int frame_encoder_ring_check(const void * aRingPtr, size_t aRingLng);
+
+
+//=======================================================================================
+// synopsis: job_ptr = frame_encoder_ring_get_job(aRingPtr, aSlotIndex)
+//
+// returns the job of a slot --- its samples follow it
+//=======================================================================================
+extern EncoderRingJob_t * frame_encoder_ring_get_job(void * aRingPtr, unsigned aSlotIndex);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_ring_put_frame(aRingPtr, aSlotIndex, aPathPtr, aFormatPtr, aFramePtr, aOptionsPtr)
+//
+// copies the samples of a frame, or of a cropped view of it, to a slot with what the
+// encoder needs --- returns 0 on success, else -1 if it does not fit
+//=======================================================================================
+extern int frame_encoder_ring_put_frame(void                   * aRingPtr,
+                                        unsigned                 aSlotIndex,
+                                        const char             * aPathPtr,
+                                        const char             * aFormatPtr,
+                                        const PixelsFrame_t    * aFramePtr,
+                                        const EncoderOptions_t * aOptionsPtr);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_ring_get_frame(aRingPtr, aSlotIndex, aFramePtr, aOptionsPtr)
+//
+// describes the frame of a slot in place and sets the encoder's options (not the scratch)
+// --- returns 0 on success, else -1 if the job is invalid
+//=======================================================================================
+extern int frame_encoder_ring_get_frame(void             * aRingPtr,
+                                        unsigned           aSlotIndex,
+                                        PixelsFrame_t    * aFramePtr,
+                                        EncoderOptions_t * aOptionsPtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Encoder_Ring_H__
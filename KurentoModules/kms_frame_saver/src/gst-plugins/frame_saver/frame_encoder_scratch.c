@@ -0,0 +1,267 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_scratch.c
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Reusable frame buffer, e.g. for scaled frames
+ *
+ * Description: Memory that an encoder keeps from one image to the next, one scratch per
+ *              worker thread. The encoder's own allocations (e.g. libpng and zlib state)
+ *              come from an arena which is reset, not freed, per image; the arena grows
+ *              to the peak use of the previous image, so the same settings and size cost
+ *              no heap allocations after the first image. The encoded image is kept in
+ *              memory and written to its file by a single write().
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "frame_encoder_scratch.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifndef O_BINARY
+    #define O_BINARY    (0)
+#endif
+
+#define ARENA_ALIGNMENT(N)  ( ((N) + 15) & ~((size_t) 15) )
+
+
+//=======================================================================================
+// synopsis: is_ok = do_grow_block(aScratchPtr, aBlockPtrPtr, aLengthPtr, aKeepLng, aNeedLng)
+//
+// grows a block to at least aNeedLng bytes, keeping the first aKeepLng --- returns 1 if OK
+//=======================================================================================
+static int do_grow_block(EncoderScratch_t * aScratchPtr,
+                         uint8_t         ** aBlockPtrPtr,
+                         size_t           * aLengthPtr,
+                         size_t             aKeepLng,
+                         size_t             aNeedLng)
+{
+    if (aNeedLng <= *aLengthPtr)
+    {
+        return 1;
+    }
+
+    // grow by half at least --- a slowly growing output needs few reallocations
+    size_t    new_lng = (aNeedLng > *aLengthPtr + (*aLengthPtr / 2)) ? aNeedLng : *aLengthPtr + (*aLengthPtr / 2);
+
+    uint8_t * new_ptr = (aKeepLng > 0) ? realloc(*aBlockPtrPtr, new_lng) : malloc(new_lng);
+
+    if (new_ptr == NULL)
+    {
+        return 0;
+    }
+
+    if (aKeepLng == 0)
+    {
+        free(*aBlockPtrPtr);
+    }
+
+    aScratchPtr->num_heap_allocs += 1;
+
+    *aBlockPtrPtr = new_ptr;
+    *aLengthPtr   = new_lng;
+
+    return 1;
+}
+
+
+//=======================================================================================
+// synopsis: frame_encoder_scratch_begin(aScratchPtr)
+//
+// prepares for the next image --- grows the arena to the previous image's peak use
+//=======================================================================================
+void frame_encoder_scratch_begin(EncoderScratch_t * aScratchPtr)
+{
+    // possibly --- the arena failed to grow --- the heap serves the excess
+    do_grow_block(aScratchPtr, &aScratchPtr->arena_ptr, &aScratchPtr->arena_lng, 0, aScratchPtr->arena_need);
+
+    aScratchPtr->arena_used  = 0;
+    aScratchPtr->arena_need  = 0;
+    aScratchPtr->output_used = 0;
+}
+
+
+//=======================================================================================
+// synopsis: pointer = frame_encoder_scratch_alloc(aScratchPtr, aLength)
+//
+// allocates from the arena, else from the heap --- returns NULL when out of memory
+//=======================================================================================
+void * frame_encoder_scratch_alloc(EncoderScratch_t * aScratchPtr, size_t aLength)
+{
+    size_t length = ARENA_ALIGNMENT(aLength);
+
+    aScratchPtr->arena_need += length;
+
+    if (aScratchPtr->arena_used + length <= aScratchPtr->arena_lng)
+    {
+        void * pointer = aScratchPtr->arena_ptr + aScratchPtr->arena_used;
+
+        aScratchPtr->arena_used += length;
+
+        return pointer;
+    }
+
+    aScratchPtr->num_heap_allocs += 1;
+
+    return malloc(aLength);
+}
+
+
+//=======================================================================================
+// synopsis: frame_encoder_scratch_free(aScratchPtr, aPointer)
+//
+// frees a pointer given by frame_encoder_scratch_alloc() --- arena memory is kept
+//=======================================================================================
+void frame_encoder_scratch_free(EncoderScratch_t * aScratchPtr, void * aPointer)
+{
+    uint8_t * pointer = (uint8_t *) aPointer;
+
+    if ( (pointer >= aScratchPtr->arena_ptr) && (pointer < aScratchPtr->arena_ptr + aScratchPtr->arena_lng) )
+    {
+        return;
+    }
+
+    free(aPointer);
+}
+
+
+//=======================================================================================
+// synopsis: pointer = frame_encoder_scratch_buffer(aScratchPtr, aLength)
+//
+// returns the reusable rows buffer, grown to aLength bytes --- NULL when out of memory
+//=======================================================================================
+uint8_t * frame_encoder_scratch_buffer(EncoderScratch_t * aScratchPtr, size_t aLength)
+{
+    if (! do_grow_block(aScratchPtr, &aScratchPtr->buffer_ptr, &aScratchPtr->buffer_lng, 0, aLength))
+    {
+        return NULL;
+    }
+
+    return aScratchPtr->buffer_ptr;
+}
+
+
+//=======================================================================================
+// synopsis: pointer = frame_encoder_scratch_frame(aScratchPtr, aLength)
+//
+// returns the reusable frame buffer, grown to aLength bytes --- NULL when out of memory
+//=======================================================================================
+uint8_t * frame_encoder_scratch_frame(EncoderScratch_t * aScratchPtr, size_t aLength)
+{
+    if (! do_grow_block(aScratchPtr, &aScratchPtr->frame_ptr, &aScratchPtr->frame_lng, 0, aLength))
+    {
+        return NULL;
+    }
+
+    return aScratchPtr->frame_ptr;
+}
+
+
+//=======================================================================================
+// synopsis: pointer = frame_encoder_scratch_reserve(aScratchPtr, aLength)
+//
+// returns the end of the output, with room for aLength more bytes --- NULL if no memory
+//=======================================================================================
+uint8_t * frame_encoder_scratch_reserve(EncoderScratch_t * aScratchPtr, size_t aLength)
+{
+    if (! do_grow_block(aScratchPtr, &aScratchPtr->output_ptr, &aScratchPtr->output_lng,
+                        aScratchPtr->output_used, aScratchPtr->output_used + aLength))
+    {
+        return NULL;
+    }
+
+    return aScratchPtr->output_ptr + aScratchPtr->output_used;
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_scratch_append(aScratchPtr, aDataPtr, aLength)
+//
+// appends bytes to the output --- returns 0 if OK, else error
+//=======================================================================================
+int frame_encoder_scratch_append(EncoderScratch_t * aScratchPtr, const void * aDataPtr, size_t aLength)
+{
+    uint8_t * end_ptr = frame_encoder_scratch_reserve(aScratchPtr, aLength);
+
+    if (end_ptr == NULL)
+    {
+        return -1;
+    }
+
+    memcpy(end_ptr, aDataPtr, aLength);
+
+    aScratchPtr->output_used += aLength;
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_scratch_write_file(aScratchPtr, aPathPtr)
+//
+// writes the output to a new file by one write() call --- returns 0 if OK, else error
+//=======================================================================================
+int frame_encoder_scratch_write_file(EncoderScratch_t * aScratchPtr, const char * aPathPtr)
+{
+    const uint8_t * data_ptr = aScratchPtr->output_ptr;
+
+    size_t data_lng = aScratchPtr->output_used;
+
+    int fd = open(aPathPtr, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    // possibly --- a signal or a full disk splits the write
+    while (data_lng > 0)
+    {
+        ssize_t count = write(fd, data_ptr, data_lng);
+
+        if (count > 0)
+        {
+            data_ptr += count;
+            data_lng -= (size_t) count;
+        }
+        else if ( (count == 0) || (errno != EINTR) )
+        {
+            break;
+        }
+    }
+
+    if ( (close(fd) != 0) || (data_lng > 0) )
+    {
+        return -2;
+    }
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: frame_encoder_scratch_release(aScratchPtr)
+//
+// frees all buffers and the compressor --- the scratch can be used again
+//=======================================================================================
+void frame_encoder_scratch_release(EncoderScratch_t * aScratchPtr)
+{
+    if ( (aScratchPtr->compressor_ptr != NULL) && (aScratchPtr->compressor_free_func != NULL) )
+    {
+        aScratchPtr->compressor_free_func(aScratchPtr->compressor_ptr);
+    }
+
+    free(aScratchPtr->arena_ptr);
+    free(aScratchPtr->output_ptr);
+    free(aScratchPtr->buffer_ptr);
+    free(aScratchPtr->frame_ptr);
+
+    memset(aScratchPtr, 0, sizeof(*aScratchPtr));
+}
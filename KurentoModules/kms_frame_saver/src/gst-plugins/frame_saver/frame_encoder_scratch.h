@@ -0,0 +1,138 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoder_scratch.h
+ *
+ * Purpose:     external interface (API) for code in "frame_encoder_scratch.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Reusable frame buffer, e.g. for scaled frames
+ *              3. 2026-10-17               Placement version of the buffers
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Encoder_Scratch_H__
+
+#define __Frame_Encoder_Scratch_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef void (*ScratchFreeFunc_t)(void * aStatePtr);
+
+typedef struct _EncoderScratch_t
+{
+    uint8_t           * arena_ptr;          // encoder's own allocations --- reset per image
+    size_t              arena_lng,
+                        arena_used,
+                        arena_need;         // peak use of the arena in the current image
+
+    uint8_t           * output_ptr;         // encoded image --- written by one write()
+    size_t              output_lng,
+                        output_used;
+
+    uint8_t           * buffer_ptr;         // converted or filtered rows
+    size_t              buffer_lng;
+
+    uint8_t           * frame_ptr;          // pixels of a derived frame (e.g. scaled) --- input of the encoder
+    size_t              frame_lng;
+
+    void              * compressor_ptr;     // long-lived compressor state --- e.g. libdeflate
+    int                 compressor_key;     // e.g. the level the compressor was made for
+    ScratchFreeFunc_t   compressor_free_func;
+
+    unsigned            num_heap_allocs;    // stops growing once the buffers fit the images
+
+    unsigned            placement_version;  // placement of the thread which first touched the buffers
+
+} EncoderScratch_t;
+
+
+//=======================================================================================
+// synopsis: frame_encoder_scratch_begin(aScratchPtr)
+//
+// prepares for the next image --- grows the arena to the previous image's peak use
+//=======================================================================================
+extern void frame_encoder_scratch_begin(EncoderScratch_t * aScratchPtr);
+
+
+//=======================================================================================
+// synopsis: pointer = frame_encoder_scratch_alloc(aScratchPtr, aLength)
+//
+// allocates from the arena, else from the heap --- returns NULL when out of memory
+//=======================================================================================
+extern void * frame_encoder_scratch_alloc(EncoderScratch_t * aScratchPtr, size_t aLength);
+
+
+//=======================================================================================
+// synopsis: frame_encoder_scratch_free(aScratchPtr, aPointer)
+//
+// frees a pointer given by frame_encoder_scratch_alloc() --- arena memory is kept
+//=======================================================================================
+extern void frame_encoder_scratch_free(EncoderScratch_t * aScratchPtr, void * aPointer);
+
+
+//=======================================================================================
+// synopsis: pointer = frame_encoder_scratch_buffer(aScratchPtr, aLength)
+//
+// returns the reusable rows buffer, grown to aLength bytes --- NULL when out of memory
+//=======================================================================================
+extern uint8_t * frame_encoder_scratch_buffer(EncoderScratch_t * aScratchPtr, size_t aLength);
+
+
+//=======================================================================================
+// synopsis: pointer = frame_encoder_scratch_frame(aScratchPtr, aLength)
+//
+// returns the reusable frame buffer, grown to aLength bytes --- NULL when out of memory
+//=======================================================================================
+extern uint8_t * frame_encoder_scratch_frame(EncoderScratch_t * aScratchPtr, size_t aLength);
+
+
+//=======================================================================================
+// synopsis: pointer = frame_encoder_scratch_reserve(aScratchPtr, aLength)
+//
+// returns the end of the output, with room for aLength more bytes --- NULL if no memory
+//=======================================================================================
+extern uint8_t * frame_encoder_scratch_reserve(EncoderScratch_t * aScratchPtr, size_t aLength);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_scratch_append(aScratchPtr, aDataPtr, aLength)
+//
+// appends bytes to the output --- returns 0 if OK, else error
+//=======================================================================================
+extern int frame_encoder_scratch_append(EncoderScratch_t * aScratchPtr, const void * aDataPtr, size_t aLength);
+
+
+//=======================================================================================
+// synopsis: result = frame_encoder_scratch_write_file(aScratchPtr, aPathPtr)
+//
+// writes the output to a new file by one write() call --- returns 0 if OK, else error
+//=======================================================================================
+extern int frame_encoder_scratch_write_file(EncoderScratch_t * aScratchPtr, const char * aPathPtr);
+
+
+//=======================================================================================
+// synopsis: frame_encoder_scratch_release(aScratchPtr)
+//
+// frees all buffers and the compressor --- the scratch can be used again
+//=======================================================================================
+extern void frame_encoder_scratch_release(EncoderScratch_t * aScratchPtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Encoder_Scratch_H__
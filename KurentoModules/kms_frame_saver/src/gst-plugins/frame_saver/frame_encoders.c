@@ -0,0 +1,199 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoders.c
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Encoders take EncoderOptions_t
+ *              3. 2026-10-17               Encoders may use the worker's scratch
+ *              4. 2026-10-17               Grayscale encoders "gray" and "gray-jpeg"
+ *
+ * Description: Table of the image encoders that can save snapped frames. Each encoder
+ *              consumes a PixelsFrame_t as is, hence it can skip conversions it doesn't
+ *              need (e.g. the JPEG encoder takes Y,U,V planes without RGB conversion).
+ *
+ *              The grayscale encoders pass the Y plane of YUV frames to the PNG or JPEG
+ *              writer as a GRAY frame, straight from the mapped buffer --- the chroma
+ *              samples are never read. Only RGB frames are converted, into a luma copy.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "frame_encoders.h"
+#include "save_frames_as_png.h"
+#include "save_frames_as_jpeg.h"
+#include "save_frames_as_qoi.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+//=======================================================================================
+// synopsis: result = do_save_as_PNG(aPathPtr, aFramePtr, aOptionsPtr)
+//
+// adapts the PNG writer to the encoders table --- quality is ignored (PNG is lossless)
+//=======================================================================================
+static int do_save_as_PNG(const char * aPathPtr, const PixelsFrame_t * aFramePtr, const EncoderOptions_t * aOptionsPtr)
+{
+    return save_pixels_as_PNG(aPathPtr, aFramePtr, &aOptionsPtr->png, aOptionsPtr->scratch_ptr);
+}
+
+
+//=======================================================================================
+// synopsis: result = do_save_as_QOI(aPathPtr, aFramePtr, aOptionsPtr)
+//
+// adapts the QOI writer to the encoders table --- options are ignored (QOI is lossless)
+//=======================================================================================
+static int do_save_as_QOI(const char * aPathPtr, const PixelsFrame_t * aFramePtr, const EncoderOptions_t * aOptionsPtr)
+{
+    (void) aOptionsPtr;
+
+    return save_pixels_as_QOI(aPathPtr, aFramePtr);
+}
+
+
+#ifndef _NOT_USING_JPEG_LIBRARY_
+
+//=======================================================================================
+// synopsis: result = do_save_as_JPEG(aPathPtr, aFramePtr, aOptionsPtr)
+//
+// adapts the JPEG writer to the encoders table
+//=======================================================================================
+static int do_save_as_JPEG(const char * aPathPtr, const PixelsFrame_t * aFramePtr, const EncoderOptions_t * aOptionsPtr)
+{
+    return save_pixels_as_JPEG(aPathPtr, aFramePtr, aOptionsPtr->quality);
+}
+
+#endif
+
+
+//=======================================================================================
+// synopsis: result = do_save_as_gray(aPathPtr, aFramePtr, aOptionsPtr, aSaveFunc)
+//
+// saves the luma of the frame by aSaveFunc --- returns 0 if OK, else error
+//=======================================================================================
+static int do_save_as_gray(const char             * aPathPtr,
+                           const PixelsFrame_t    * aFramePtr,
+                           const EncoderOptions_t * aOptionsPtr,
+                           SaveImageFunc_t          aSaveFunc)
+{
+    PixelsFrame_t gray_frame;
+
+    int row_index, result;
+
+    // YUV and GRAY frames --- their Y samples are used in place
+    if (convert_frame_to_GRAY_view(&gray_frame, aFramePtr) == 0)
+    {
+        return aSaveFunc(aPathPtr, &gray_frame, aOptionsPtr);
+    }
+
+    if ( (aFramePtr == NULL) || (aFramePtr->family != e_PIXELS_RGB) || (aFramePtr->num_cols < 1) || (aFramePtr->num_rows < 1) )
+    {
+        return -10;
+    }
+
+    // RGB frames --- have no Y samples, their luma is computed into a copy
+    uint8_t * luma_ptr = (uint8_t *) malloc( (size_t) aFramePtr->num_cols * aFramePtr->num_rows );
+
+    if (luma_ptr == NULL)
+    {
+        return -20;
+    }
+
+    if (aOptionsPtr->scratch_ptr != NULL)
+    {
+        aOptionsPtr->scratch_ptr->num_heap_allocs += 1;
+    }
+
+    for ( row_index = 0;  row_index < aFramePtr->num_rows;  ++row_index )
+    {
+        if (convert_frame_row_to_GRAY8(luma_ptr + ((size_t) row_index * aFramePtr->num_cols), aFramePtr, row_index) == 0)
+        {
+            free(luma_ptr);
+            return -30;
+        }
+    }
+
+    memset(&gray_frame, 0, sizeof(gray_frame));
+
+    gray_frame.family            = e_PIXELS_GRAY;
+    gray_frame.num_cols          = aFramePtr->num_cols;
+    gray_frame.num_rows          = aFramePtr->num_rows;
+    gray_frame.comps_array[0]    = luma_ptr;
+    gray_frame.strides_array[0]  = aFramePtr->num_cols;
+    gray_frame.pstrides_array[0] = 1;
+
+    result = aSaveFunc(aPathPtr, &gray_frame, aOptionsPtr);
+
+    free(luma_ptr);
+
+    return result;
+}
+
+
+//=======================================================================================
+// synopsis: result = do_save_as_gray_PNG(aPathPtr, aFramePtr, aOptionsPtr)
+//
+// saves the luma of the frame as an 8-bit gray PNG
+//=======================================================================================
+static int do_save_as_gray_PNG(const char * aPathPtr, const PixelsFrame_t * aFramePtr, const EncoderOptions_t * aOptionsPtr)
+{
+    return do_save_as_gray(aPathPtr, aFramePtr, aOptionsPtr, do_save_as_PNG);
+}
+
+
+#ifndef _NOT_USING_JPEG_LIBRARY_
+
+//=======================================================================================
+// synopsis: result = do_save_as_gray_JPEG(aPathPtr, aFramePtr, aOptionsPtr)
+//
+// saves the luma of the frame as a one-component JPEG
+//=======================================================================================
+static int do_save_as_gray_JPEG(const char * aPathPtr, const PixelsFrame_t * aFramePtr, const EncoderOptions_t * aOptionsPtr)
+{
+    return do_save_as_gray(aPathPtr, aFramePtr, aOptionsPtr, do_save_as_JPEG);
+}
+
+#endif
+
+
+// the first encoder is the default one
+static const FrameEncoder_t The_Encoders[] =
+{
+    { "png",       "png", 0,                    do_save_as_PNG       },
+    { "qoi",       "qoi", 0,                    do_save_as_QOI       },
+#ifndef _NOT_USING_JPEG_LIBRARY_
+    { "jpeg",      "jpg", DEFAULT_JPEG_QUALITY, do_save_as_JPEG      },
+#endif
+    { "gray",      "png", 0,                    do_save_as_gray_PNG  },
+#ifndef _NOT_USING_JPEG_LIBRARY_
+    { "gray-jpeg", "jpg", DEFAULT_JPEG_QUALITY, do_save_as_gray_JPEG },
+#endif
+};
+
+
+//=======================================================================================
+// synopsis: encoder_ptr = frame_encoders_find(aNamePtr)
+//
+// returns the encoder named by "fmt=" parameter --- NULL if unknown or not built
+//=======================================================================================
+const FrameEncoder_t * frame_encoders_find(const char * aNamePtr)
+{
+    int index = (int) (sizeof(The_Encoders) / sizeof(The_Encoders[0]));
+
+    if ( (aNamePtr == NULL) || (*aNamePtr == 0) )
+    {
+        return &The_Encoders[0];
+    }
+
+    while (--index >= 0)
+    {
+        if (strcmp(aNamePtr, The_Encoders[index].name) == 0)
+        {
+            return &The_Encoders[index];
+        }
+    }
+
+    return NULL;
+}
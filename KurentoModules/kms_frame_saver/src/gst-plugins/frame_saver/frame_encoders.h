@@ -0,0 +1,72 @@
+/*
+ * ======================================================================================
+ * File:        frame_encoders.h
+ *
+ * Purpose:     external interface (API) for code in "frame_encoders.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *              2. 2026-10-17               Encoders take EncoderOptions_t
+ *              3. 2026-10-17               Encoders may use the worker's scratch
+ *              4. 2026-10-17               Options carry the size of scaled-down frames
+ *              5. 2026-10-17               Options carry the rectangle of cropped frames
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Encoders_H__
+
+#define __Frame_Encoders_H__
+
+#include "convert_frame_pixels.h"
+#include "save_frames_as_png.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef struct _EncoderOptions_t
+{
+    int                 quality;            // lossy encoders, 1..100
+    PngOptions_t        png;                // PNG encoder --- deflate level, filters, strategy
+    EncoderScratch_t  * scratch_ptr;        // memory kept by the calling worker --- NULL if none
+    int                 max_cols,           // the caller scales frames down to fit --- 0 is unbounded
+                        max_rows;
+    int                 crop_left,          // the caller crops frames before scaling them
+                        crop_top,
+                        crop_cols,          // 0 is up to the frame's edge
+                        crop_rows;
+
+} EncoderOptions_t;
+
+typedef int (*SaveImageFunc_t)(const char * aPathPtr, const PixelsFrame_t * aFramePtr, const EncoderOptions_t * aOptionsPtr);
+
+typedef struct _FrameEncoder_t
+{
+    const char        * name;               // value of the "fmt=" parameter
+    const char        * extension;          // extension of the saved image files
+    int                 default_quality;    // 0 if the encoder ignores quality
+    SaveImageFunc_t     save_func;          // returns 0 if OK, else error
+
+} FrameEncoder_t;
+
+
+//=======================================================================================
+// synopsis: encoder_ptr = frame_encoders_find(aNamePtr)
+//
+// returns the encoder named by "fmt=" parameter --- NULL if unknown or not built
+//=======================================================================================
+extern const FrameEncoder_t * frame_encoders_find(const char * aNamePtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Encoders_H__
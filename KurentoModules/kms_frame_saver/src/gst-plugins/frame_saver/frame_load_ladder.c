@@ -0,0 +1,243 @@
+/*
+ * ======================================================================================
+ * File:        frame_load_ladder.c
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Description: An overload controller, one per frame-saver instance, which degrades the
+ *              snaps step by step before the encoder queues drop them: cheaper encoder
+ *              settings, then images scaled down by half, then a doubled snaps interval,
+ *              then skipped snaps --- each level keeps the degradations of the ones below.
+ *
+ *              The level is updated once per snap from the backlog and the drops of the
+ *              instance's queues and from a moving average of the encode latencies. It
+ *              steps up after LOAD_STEP_UP_SNAPS overloaded snaps in a row, and steps down
+ *              only after LOAD_STEP_DOWN_SNAPS calm ones, when the queues are empty and the
+ *              latency is below a lower threshold, hence it does not oscillate between two
+ *              levels. The latency average restarts after each step, so a step is judged
+ *              by the images encoded with its own settings.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "frame_load_ladder.h"
+
+
+static const char * The_Level_Names[] = { "off", "effort", "scale", "stretch", "shed" };    // by LOAD_LEVEL_e
+
+
+//=======================================================================================
+// synopsis: name = frame_load_ladder_get_name(aLevel)
+//
+// returns the name of a level --- "off", "effort", "scale", "stretch" or "shed"
+//=======================================================================================
+const char * frame_load_ladder_get_name(LOAD_LEVEL_e aLevel)
+{
+    return ( (guint) aLevel < G_N_ELEMENTS(The_Level_Names) ) ? The_Level_Names[aLevel] : "?";
+}
+
+
+//=======================================================================================
+// synopsis: do_change_level(aLadderPtr, aLevel)
+//
+// called with the mutex held --- moves to aLevel and restarts the measures of the load
+//=======================================================================================
+static void do_change_level(FrameLoadLadder_t * aLadderPtr, LOAD_LEVEL_e aLevel)
+{
+    if (aLadderPtr->level != aLevel)
+    {
+        aLadderPtr->level      = aLevel;
+        aLadderPtr->num_steps += 1;
+    }
+
+    aLadderPtr->mean_latency_us = -1;
+    aLadderPtr->num_hot_snaps   = 0;
+    aLadderPtr->num_calm_snaps  = 0;
+    aLadderPtr->num_shed_checks = 0;
+}
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_init(aLadderPtr)
+//
+// initializes a disabled ladder
+//=======================================================================================
+void frame_load_ladder_init(FrameLoadLadder_t * aLadderPtr)
+{
+    g_mutex_init(&aLadderPtr->mutex);
+
+    aLadderPtr->top_level = e_LOAD_NORMAL;
+    aLadderPtr->level     = e_LOAD_NORMAL;
+    aLadderPtr->high_ms   = 0;
+    aLadderPtr->low_ms    = 0;
+    aLadderPtr->num_drops = 0;
+    aLadderPtr->num_steps = 0;
+
+    do_change_level(aLadderPtr, e_LOAD_NORMAL);
+}
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_clear(aLadderPtr)
+//
+// releases the resources of a ladder
+//=======================================================================================
+void frame_load_ladder_clear(FrameLoadLadder_t * aLadderPtr)
+{
+    g_mutex_clear(&aLadderPtr->mutex);
+}
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_configure(aLadderPtr, aTopLevel, aHighMs, aLowMs)
+//
+// sets the deepest level and the latency thresholds (0 is auto) and restarts the measures
+// --- the level is kept unless it is deeper than aTopLevel
+//=======================================================================================
+void frame_load_ladder_configure(FrameLoadLadder_t * aLadderPtr, LOAD_LEVEL_e aTopLevel, guint aHighMs, guint aLowMs)
+{
+    g_mutex_lock(&aLadderPtr->mutex);
+
+    aLadderPtr->top_level = MIN(aTopLevel, e_LOAD_SHED);
+    aLadderPtr->high_ms   = aHighMs;
+    aLadderPtr->low_ms    = aLowMs;
+
+    // the measures restart with the new thresholds
+    do_change_level(aLadderPtr, MIN(aLadderPtr->level, aLadderPtr->top_level));
+
+    g_mutex_unlock(&aLadderPtr->mutex);
+}
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_reset(aLadderPtr)
+//
+// returns to the NORMAL level and clears the measures and the count of steps
+//=======================================================================================
+void frame_load_ladder_reset(FrameLoadLadder_t * aLadderPtr)
+{
+    g_mutex_lock(&aLadderPtr->mutex);
+
+    do_change_level(aLadderPtr, e_LOAD_NORMAL);
+
+    aLadderPtr->num_drops = 0;
+    aLadderPtr->num_steps = 0;
+
+    g_mutex_unlock(&aLadderPtr->mutex);
+}
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_add_latency(aLadderPtr, aMicros)
+//
+// adds the time one image took to encode and write --- called by the encoder workers
+//=======================================================================================
+void frame_load_ladder_add_latency(FrameLoadLadder_t * aLadderPtr, gint64 aMicros)
+{
+    g_mutex_lock(&aLadderPtr->mutex);
+
+    // moving average --- each new latency weighs 1/4
+    if (aLadderPtr->mean_latency_us < 0)
+    {
+        aLadderPtr->mean_latency_us = aMicros;
+    }
+    else
+    {
+        aLadderPtr->mean_latency_us += (aMicros - aLadderPtr->mean_latency_us) / 4;
+    }
+
+    g_mutex_unlock(&aLadderPtr->mutex);
+}
+
+
+//=======================================================================================
+// synopsis: is_changed = frame_load_ladder_update(aLadderPtr, aBacklog, aNumDrops, aPeriodMs)
+//
+// called once per snap with the pending jobs and the drops of the instance's queues, and
+// the snaps interval (0 if not paced by time) --- returns TRUE iff the level changed
+//=======================================================================================
+gboolean frame_load_ladder_update(FrameLoadLadder_t * aLadderPtr, guint aBacklog, guint aNumDrops, guint aPeriodMs)
+{
+    g_mutex_lock(&aLadderPtr->mutex);
+
+    LOAD_LEVEL_e old_level = aLadderPtr->level;
+
+    // auto --- the encoders are overloaded when one image takes longer than the snaps interval
+    gint64 high_us = 1000 * (gint64) ( (aLadderPtr->high_ms > 0) ? aLadderPtr->high_ms :
+                                       (aPeriodMs > 0)           ? aPeriodMs : LOAD_DEFAULT_HIGH_MS );
+
+    gint64 low_us  = (aLadderPtr->low_ms > 0) ? (1000 * (gint64) aLadderPtr->low_ms) : (high_us / 2);
+
+    // the queues' drops are cleared by a flush --- a smaller count is not a new drop
+    gboolean is_dropped = (aNumDrops > aLadderPtr->num_drops);
+
+    aLadderPtr->num_drops = aNumDrops;
+
+    gboolean is_hot  = is_dropped || (aBacklog >= LOAD_BACKLOG_JOBS) || (aLadderPtr->mean_latency_us > high_us);
+
+    // calm needs a latency measured at this level --- while shedding it comes from the probe snaps
+    gboolean is_calm = (! is_dropped) && (aBacklog == 0) &&
+                       (aLadderPtr->mean_latency_us >= 0) && (aLadderPtr->mean_latency_us < low_us);
+
+    aLadderPtr->num_hot_snaps  = is_hot  ? (aLadderPtr->num_hot_snaps + 1)  : 0;
+    aLadderPtr->num_calm_snaps = is_calm ? (aLadderPtr->num_calm_snaps + 1) : 0;
+
+    if ( (aLadderPtr->num_hot_snaps >= LOAD_STEP_UP_SNAPS) && (aLadderPtr->level < aLadderPtr->top_level) )
+    {
+        do_change_level(aLadderPtr, aLadderPtr->level + 1);
+    }
+    else if ( (aLadderPtr->num_calm_snaps >= LOAD_STEP_DOWN_SNAPS) && (aLadderPtr->level > e_LOAD_NORMAL) )
+    {
+        do_change_level(aLadderPtr, aLadderPtr->level - 1);
+    }
+
+    gboolean is_changed = (aLadderPtr->level != old_level);
+
+    g_mutex_unlock(&aLadderPtr->mutex);
+
+    return is_changed;
+}
+
+
+//=======================================================================================
+// synopsis: level = frame_load_ladder_get_level(aLadderPtr, aStepsPtr)
+//
+// gets the number of level changes since the last reset (aStepsPtr may be NULL) ---
+// returns the current level
+//=======================================================================================
+LOAD_LEVEL_e frame_load_ladder_get_level(FrameLoadLadder_t * aLadderPtr, guint * aStepsPtr)
+{
+    g_mutex_lock(&aLadderPtr->mutex);
+
+    LOAD_LEVEL_e level = aLadderPtr->level;
+
+    if (aStepsPtr != NULL)
+    {
+        *aStepsPtr = aLadderPtr->num_steps;
+    }
+
+    g_mutex_unlock(&aLadderPtr->mutex);
+
+    return level;
+}
+
+
+//=======================================================================================
+// synopsis: is_shed = frame_load_ladder_should_shed(aLadderPtr)
+//
+// called once per snap --- returns TRUE iff the snap is skipped, which is never below the
+// SHED level, and one snap in LOAD_SHED_PROBE_SNAPS is still saved to measure the load
+//=======================================================================================
+gboolean frame_load_ladder_should_shed(FrameLoadLadder_t * aLadderPtr)
+{
+    g_mutex_lock(&aLadderPtr->mutex);
+
+    gboolean is_shed = (aLadderPtr->level >= e_LOAD_SHED) &&
+                       ((++aLadderPtr->num_shed_checks % LOAD_SHED_PROBE_SNAPS) != 0);
+
+    g_mutex_unlock(&aLadderPtr->mutex);
+
+    return is_shed;
+}
@@ -0,0 +1,153 @@
+/*
+ * ======================================================================================
+ * File:        frame_load_ladder.h
+ *
+ * Purpose:     external interface (API) for code in "frame_load_ladder.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Load_Ladder_H__
+
+#define __Frame_Load_Ladder_H__
+
+#include <glib.h>
+
+
+#define  LOAD_STEP_UP_SNAPS             (2)         // overloaded snaps in a row before a step up
+#define  LOAD_STEP_DOWN_SNAPS           (6)         // calm snaps in a row before a step down
+#define  LOAD_BACKLOG_JOBS              (2)         // pending jobs of an overloaded queue
+#define  LOAD_SHED_PROBE_SNAPS          (4)         // one snap in these is saved while shedding
+#define  LOAD_DEFAULT_HIGH_MS           (1000)      // encode latency of an overload --- unless paced by time
+#define  LOAD_EFFORT_QUALITY            (50)        // quality of lossy encoders from the EFFORT level
+#define  LOAD_STRETCH_FACTOR            (2)         // snaps interval multiplier from the STRETCH level
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef enum
+{
+    e_LOAD_NORMAL = 0,              // snaps are saved as configured
+    e_LOAD_EFFORT,                  // encoders trade size or quality for speed
+    e_LOAD_SCALE,                   // images are also scaled down by half
+    e_LOAD_STRETCH,                 // the snaps interval is also doubled
+    e_LOAD_SHED,                    // most snaps are also skipped
+
+    e_LOAD_NUM_LEVELS
+
+} LOAD_LEVEL_e;
+
+
+typedef struct _FrameLoadLadder_t
+{
+    GMutex          mutex;              // encoders add latencies while the stream updates the level
+
+    LOAD_LEVEL_e    top_level,          // deepest level allowed --- NORMAL disables the ladder
+                    level;
+    guint           high_ms,            // encode latency which steps up --- 0 is auto
+                    low_ms;             // encode latency which allows a step down --- 0 is auto
+
+    gint64          mean_latency_us;    // moving average of the encode latencies --- -1 before the first
+    guint           num_drops;          // drops of the queues as of the previous update
+
+    guint           num_hot_snaps,      // overloaded snaps in a row
+                    num_calm_snaps,     // calm snaps in a row
+                    num_shed_checks;    // snaps checked at the SHED level
+
+    guint           num_steps;          // level changes since the last reset
+
+} FrameLoadLadder_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+//=======================================================================================
+// synopsis: name = frame_load_ladder_get_name(aLevel)
+//
+// returns the name of a level --- "off", "effort", "scale", "stretch" or "shed"
+//=======================================================================================
+const char * frame_load_ladder_get_name(LOAD_LEVEL_e aLevel);
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_init(aLadderPtr)
+//
+// initializes a disabled ladder
+//=======================================================================================
+void frame_load_ladder_init(FrameLoadLadder_t * aLadderPtr);
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_clear(aLadderPtr)
+//
+// releases the resources of a ladder
+//=======================================================================================
+void frame_load_ladder_clear(FrameLoadLadder_t * aLadderPtr);
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_configure(aLadderPtr, aTopLevel, aHighMs, aLowMs)
+//
+// sets the deepest level and the latency thresholds (0 is auto) and restarts the measures
+// --- the level is kept unless it is deeper than aTopLevel
+//=======================================================================================
+void frame_load_ladder_configure(FrameLoadLadder_t * aLadderPtr, LOAD_LEVEL_e aTopLevel, guint aHighMs, guint aLowMs);
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_reset(aLadderPtr)
+//
+// returns to the NORMAL level and clears the measures and the count of steps
+//=======================================================================================
+void frame_load_ladder_reset(FrameLoadLadder_t * aLadderPtr);
+
+
+//=======================================================================================
+// synopsis: frame_load_ladder_add_latency(aLadderPtr, aMicros)
+//
+// adds the time one image took to encode and write --- called by the encoder workers
+//=======================================================================================
+void frame_load_ladder_add_latency(FrameLoadLadder_t * aLadderPtr, gint64 aMicros);
+
+
+//=======================================================================================
+// synopsis: is_changed = frame_load_ladder_update(aLadderPtr, aBacklog, aNumDrops, aPeriodMs)
+//
+// called once per snap with the pending jobs and the drops of the instance's queues, and
+// the snaps interval (0 if not paced by time) --- returns TRUE iff the level changed
+//=======================================================================================
+gboolean frame_load_ladder_update(FrameLoadLadder_t * aLadderPtr, guint aBacklog, guint aNumDrops, guint aPeriodMs);
+
+
+//=======================================================================================
+// synopsis: level = frame_load_ladder_get_level(aLadderPtr, aStepsPtr)
+//
+// gets the number of level changes since the last reset (aStepsPtr may be NULL) ---
+// returns the current level
+//=======================================================================================
+LOAD_LEVEL_e frame_load_ladder_get_level(FrameLoadLadder_t * aLadderPtr, guint * aStepsPtr);
+
+
+//=======================================================================================
+// synopsis: is_shed = frame_load_ladder_should_shed(aLadderPtr)
+//
+// called once per snap --- returns TRUE iff the snap is skipped, which is never below the
+// SHED level, and one snap in LOAD_SHED_PROBE_SNAPS is still saved to measure the load
+//=======================================================================================
+gboolean frame_load_ladder_should_shed(FrameLoadLadder_t * aLadderPtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Load_Ladder_H__
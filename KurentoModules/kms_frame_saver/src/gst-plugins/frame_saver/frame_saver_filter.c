@@ -27,10 +27,17 @@
 
 #include "frame_saver_filter.h"
 #include "frame_saver_params.h"
+#include "frame_encoder_pool.h"
+#include "frame_encoder_placement.h"
+#include "frame_load_ladder.h"
+#include "frame_snap_timer.h"
+#include "convert_frame_pixels.h"
+#include "frame_encoders.h"
 #include "save_frames_as_png.h"
 
 #include <gst/gst.h>
 #include <gst/app/gstappsink.h>
+#include <gst/video/video.h>
 #include <glib.h>
 #include <glib/gtypes.h>
 
@@ -45,10 +52,12 @@
 #define PREFIX_FORMAT           "@FrameSaver.%u --- "
 #define INFINIT_NANOS           (NANOS_PER_DAY + 9);
 #define NUM_APP_SINK_BUFFERS    (2)
+#define TEE_RETRY_MICROS        (MIN_TICKS_MILLISEC * 100)
 
 #define CAPS_FOR_AUTO_SOURCE    "video/x-raw, width=(int)500, height=(int)200" //, framerate=(fraction)1/2"
 #define CAPS_FOR_VIEW_SINKER    "video/x-raw, width=(int)500, height=(int)200"
-#define CAPS_FOR_SNAP_SINKER    "video/x-raw, format=(string)RGB, bpp=(int)24"
+#define CAPS_FOR_SNAP_SINKER    "video/x-raw, format=(string){ I420, YV12, NV12, NV21, YUY2, UYVY, YVYU, "   \
+                                "RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, GRAY8 }"
 
 
 //=======================================================================================
@@ -122,7 +131,7 @@ typedef struct _FlowSplicer_t
 
 typedef struct _FramesSaver_t
 {
-    gint          instance_ID;              // ZERO indicates structure is empty
+    gint          instance_ID;              // unique for every saver --- counts up from 1
 
     GstElement  * parent_pipeline_ptr,      // NULL indicates pipline is unknown
                 * attached_plugin_ptr;      // NULL indicates no plugin attached
@@ -142,28 +151,65 @@ typedef struct _FramesSaver_t
                 * sinker_caps_ptr;          // for TEE-to-Queue2-to-Sink2 (or appsink)
 
     guint           num_snap_signals,       // count of signals to snap frames
+                    num_queued_frames,      // count of frames queued for saving
                     num_saved_frames,       // count of frames saved as files
                     num_saver_errors,       // count of frames saver's errors
+                    num_encoder_allocs,     // count of heap allocations by the encoders
                     num_stream_frames,      // count of stream input frames
-                    num_stream_errors;      // count of stream input errors
+                    num_stream_errors,      // count of stream input errors
+                    num_shed_snaps;         // count of snaps skipped by the load ladder
 
     GstClockTime    frame_snap_wait_ns;     // wait time for next frame snap --- 0 is infinite
     GstClockTime    wait_state_ends_ns;     // timestamp for a TEE insertion --- 0 is infinite
+    GstClockTime    snap_pace_next_at;      // running-time or frames count of next snap --- NONE is never
 
     GstAppSinkCallbacks appsink_callbacks;
 
     FlowSplicer_t       flow_splicer_info;
 
+    FrameEncoderQueue_t encoder_queues[1 + MAX_EXTRA_RENDITIONS];   // frames waiting for the encoder pool --- one per rendition
+
+    FrameLoadLadder_t   load_ladder;        // degrades the snaps when the encoders are overloaded
+
+    GstCaps           * video_caps_ptr;     // caps of video_info --- NULL until first frame
+    GstVideoInfo        video_info;         // format, strides and offsets of appsink frames
+
     gchar               work_folder_path[PATH_MAX + 1];
 
-    int                isIdleTaskInitialized;
+    FrameSnapTimer_t    snap_timer;         // wakes up when snap or wait-state is due
 
 } FramesSaver_t;
 
 
-#define MAX_NUM_PLUGINS (4000)
+typedef struct _FrameSnapShot_t
+{
+    gint            ref_count;              // one per rendition of the snap
+
+    GstBuffer     * buffer_ptr;             // referenced by the streaming thread
+
+    GstVideoInfo    video_info;             // as negotiated when the frame was snapped
+
+    GMutex          map_mutex;              // the first rendition to run maps the frame
+    gint            map_result;             // 0 when mapped, 1 before the first map, else error
+    GstVideoFrame   frame;
+    PixelsFrame_t   pixels;                 // components of the mapped frame
+
+} FrameSnapShot_t;
+
+
+typedef struct _FrameSnapJob_t
+{
+    FramesSaver_t   * saver_ptr;
+
+    FrameSnapShot_t * shot_ptr;             // shared by all renditions of the snap
+
+    gchar           * image_path_ptr;
+
+    const FrameEncoder_t * encoder_ptr;     // as selected by "fmt=" or "rend=" when the frame was snapped
+    EncoderOptions_t       options;         // as set by "fmt=", "png=", "scale=", "crop=" or "rend=" when the frame was snapped
+
+} FrameSnapJob_t;
 
-static FramesSaver_t    The_FramesSavers_Array[ MAX_NUM_PLUGINS ] = { { 0, NULL, NULL } };
 
 static const int        MUTEX_TIMEOUT_MS = 10;
 
@@ -177,6 +223,10 @@ static GstClockTime    The_LaunchTime_ns = 0;
 
 static gint            The_Plugins_Count = -1;
 
+static gint            The_Instances_Serial = 0;    // last instance_ID given to a saver
+
+static GQuark          The_Saver_Quark = 0;     // plugin's qdata key for its FramesSaver_t
+
 
 //=======================================================================================
 // synopsis: splicer_ptr = do_get_splicer_ptr(aSaverPtr)
@@ -217,10 +267,10 @@ static int do_initialize_static_resources()
         The_LaunchTime_ns = gst_clock_get_time( The_SysClock_Ptr );
     }
 
-    memset( The_FramesSavers_Array, 0, sizeof(The_FramesSavers_Array) );
-
     The_Plugins_Count = 0;
 
+    The_Saver_Quark = g_quark_from_static_string("frame-saver-instance");
+
     if (nativeCreateMutex(&The_Mutex_Handle) != 0)
     {
         The_Mutex_Handle = NULL;    // create failed
@@ -231,128 +281,319 @@ static int do_initialize_static_resources()
 
 
 //=======================================================================================
-// synopsis: result = do_find_plugin_index(aPluginPtr)
+// synopsis: saver_ptr = do_find_plugin_saver(aPluginPtr)
 //
-// returns index in array of known plugins --- returns -1 iff not in the array
+// returns the plugin's attached FramesSaver_t --- returns NULL iff plugin is unknown
 //=======================================================================================
-static int do_find_plugin_index(const void * aPluginPtr)
+static FramesSaver_t * do_find_plugin_saver(GstElement * aPluginPtr)
 {
-    int index = 0;
-
     // possibly --- once only or RESET --- initialize resources
     if ( (The_Mutex_Handle == NULL) || (The_Plugins_Count < 0) )
     {
         do_initialize_static_resources();
 
+        return NULL;
+    }
+
+    if (aPluginPtr == NULL)
+    {
+        return NULL;
+    }
+
+    // constant time --- the plugin instance carries a pointer to its saver
+    return (FramesSaver_t *) g_object_get_qdata( G_OBJECT(aPluginPtr), The_Saver_Quark );
+}
+
+
+//=======================================================================================
+// synopsis: result = do_get_frame_pixels(aFramePtr, aPixelsPtr)
+//
+// describes the components of a mapped frame --- returns 0 on success, else error
+//=======================================================================================
+static int do_get_frame_pixels(GstVideoFrame * aFramePtr, PixelsFrame_t * aPixelsPtr)
+{
+    const GstVideoFormatInfo * finfo = aFramePtr->info.finfo;
+
+    int comp_index, num_comps = 3;
+
+    if ( GST_VIDEO_FORMAT_INFO_HAS_PALETTE(finfo) || GST_VIDEO_FORMAT_INFO_IS_TILED(finfo) )
+    {
         return -1;
     }
 
-    while ( (index < MAX_NUM_PLUGINS) && (The_FramesSavers_Array[index].attached_plugin_ptr != aPluginPtr) )
+    if ( GST_VIDEO_FORMAT_INFO_IS_YUV(finfo) )
+    {
+        // only 4:2:0 and 4:2:2 --- each U,V sample is shared by two pixels of a row
+        if ( (GST_VIDEO_FORMAT_INFO_W_SUB(finfo, GST_VIDEO_COMP_U) != 1) ||
+             (GST_VIDEO_FORMAT_INFO_H_SUB(finfo, GST_VIDEO_COMP_U) > 1) )
+        {
+            return -2;
+        }
+
+        aPixelsPtr->family     = e_PIXELS_YUV;
+        aPixelsPtr->rows_shift = GST_VIDEO_FORMAT_INFO_H_SUB(finfo, GST_VIDEO_COMP_U);
+    }
+    else if ( GST_VIDEO_FORMAT_INFO_IS_RGB(finfo) )
+    {
+        aPixelsPtr->family     = e_PIXELS_RGB;
+        aPixelsPtr->rows_shift = 0;
+    }
+    else if ( GST_VIDEO_FORMAT_INFO_IS_GRAY(finfo) )
+    {
+        aPixelsPtr->family     = e_PIXELS_GRAY;
+        aPixelsPtr->rows_shift = 0;
+        num_comps = 1;
+    }
+    else
+    {
+        return -3;
+    }
+
+    if ( (int) GST_VIDEO_FORMAT_INFO_N_COMPONENTS(finfo) < num_comps )
+    {
+        return -4;
+    }
+
+    memset(aPixelsPtr->comps_array, 0, sizeof(aPixelsPtr->comps_array));
+
+    for ( comp_index = 0;  comp_index < num_comps;  ++comp_index )
+    {
+        if (GST_VIDEO_FORMAT_INFO_DEPTH(finfo, comp_index) != 8)
+        {
+            return -5;      // only 8-bit samples
+        }
+
+        aPixelsPtr->comps_array[comp_index]    = GST_VIDEO_FRAME_COMP_DATA(aFramePtr, comp_index);
+        aPixelsPtr->strides_array[comp_index]  = GST_VIDEO_FRAME_COMP_STRIDE(aFramePtr, comp_index);
+        aPixelsPtr->pstrides_array[comp_index] = GST_VIDEO_FRAME_COMP_PSTRIDE(aFramePtr, comp_index);
+    }
+
+    aPixelsPtr->num_cols = GST_VIDEO_FRAME_WIDTH(aFramePtr);
+    aPixelsPtr->num_rows = GST_VIDEO_FRAME_HEIGHT(aFramePtr);
+
+    return 0;
+}
+
+
+//=======================================================================================
+// synopsis: do_free_encoder_scratch(aScratchPtr)
+//
+// frees the encoder scratch of a thread --- called by GLib when the thread exits
+//=======================================================================================
+static void do_free_encoder_scratch(gpointer aScratchPtr)
+{
+    frame_encoder_scratch_release( (EncoderScratch_t *) aScratchPtr );
+
+    g_free(aScratchPtr);
+}
+
+
+static GPrivate The_Encoder_Scratch = G_PRIVATE_INIT(do_free_encoder_scratch);   // one per encoding thread
+
+
+//=======================================================================================
+// synopsis: scratch_ptr = do_get_encoder_scratch()
+//
+// returns the calling thread's encoder scratch --- made by the thread's first call, and
+// emptied when the placement of the encoder threads changes
+//=======================================================================================
+static EncoderScratch_t * do_get_encoder_scratch()
+{
+    EncoderScratch_t * scratch_ptr = (EncoderScratch_t *) g_private_get(&The_Encoder_Scratch);
+
+    if (scratch_ptr == NULL)
     {
-        ++index;   // next
+        scratch_ptr = g_new0(EncoderScratch_t, 1);
+
+        g_private_set(&The_Encoder_Scratch, scratch_ptr);
     }
 
-    return ( (index < MAX_NUM_PLUGINS) && (aPluginPtr != NULL) ) ? index : -1;
+    unsigned placement_version = frame_encoder_placement_get_version();
+
+    // possibly --- the encoder threads moved --- the buffers are made again, near their new CPUs
+    if (scratch_ptr->placement_version != placement_version)
+    {
+        frame_encoder_scratch_release(scratch_ptr);
+
+        scratch_ptr->placement_version = placement_version;
+    }
+
+    return scratch_ptr;
 }
 
 
 //=======================================================================================
-// synopsis: result = do_save_frame_buffer(aBufferPtr, aCapsPtr, aSaverPtr)
+// synopsis: pixels_ptr = do_map_frame_snapshot(aShotPtr, aSaverPtr)
 //
-// snaps and saves a frame --- returns GST_FLOW_OK on success, else GST_FLOW_ERROR
+// maps the snapped frame once for all its renditions --- returns its pixels, else NULL
 //=======================================================================================
-static gint do_save_frame_buffer(GstBuffer     * aBufferPtr,
-                                 const char    * aCapsPtr,
-                                 FramesSaver_t * aSaverPtr)
+static const PixelsFrame_t * do_map_frame_snapshot(FrameSnapShot_t * aShotPtr, FramesSaver_t * aSaverPtr)
 {
     /*
     * NOTE-1: image height can depend on the pixel-aspect-ratio of the source.
     *
-    * NOTE-2: stride of video buffers is rounded to the nearest multiple of 4.
+    * NOTE-2: strides and offsets come from the buffer's GstVideoMeta when it has one.
+    *
+    * NOTE-3: any 8-bit YUV (4:2:0, 4:2:2), RGB or GRAY layout is passed to the encoder.
+    *
+    * NOTE-4: the first rendition to run maps the frame, the others wait for it and reuse
+    *         the mapped frame --- the last rendition to finish unmaps it.
     */
 
-    GstMapInfo map;
+    GstVideoInfo * info_ptr = &aShotPtr->video_info;
 
-    char sz_image_format[100],
-         sz_image_path[PATH_MAX + 100];
+    g_mutex_lock(&aShotPtr->map_mutex);
 
-    const char * interlace = aCapsPtr ? strstr(aCapsPtr, "interlace-mode=") : (aCapsPtr = "?");
+    if (aShotPtr->map_result > 0)
+    {
+        if ( (GST_VIDEO_INFO_HEIGHT(info_ptr) < 1) || (GST_VIDEO_INFO_WIDTH(info_ptr) < 1) )
+        {
+            aShotPtr->map_result = -1;  // invalid attributes
+        }
+        else if ( GST_VIDEO_INFO_IS_INTERLACED(info_ptr) )
+        {
+            aShotPtr->map_result = -2;  // only "progressive" is allowed
+        }
+        else if (TRUE != gst_video_frame_map(&aShotPtr->frame, info_ptr, aShotPtr->buffer_ptr, GST_MAP_READ))
+        {
+            aShotPtr->map_result = -3;
+        }
+        else if (do_get_frame_pixels(&aShotPtr->frame, &aShotPtr->pixels) != 0)
+        {
+            gst_video_frame_unmap(&aShotPtr->frame);
 
-    int  cols = 0,
-         rows = 0,
-         bits = 8,
-         errs = pipeline_params_parse_caps(aCapsPtr,
-                                           sz_image_format,
-                                           &cols,
-                                           &rows,
-                                           &bits);
+            aShotPtr->map_result = -4;  // unsupported format
+        }
+        else
+        {
+            aShotPtr->map_result = 0;
+
+            g_atomic_int_inc( (gint *) &aSaverPtr->num_saved_frames );
+        }
+    }
 
-    if ( (errs != 0) || (rows < 1) || (cols < 1) )
+    gint result = aShotPtr->map_result;
+
+    g_mutex_unlock(&aShotPtr->map_mutex);
+
+    return (result == 0) ? &aShotPtr->pixels : NULL;
+}
+
+
+//=======================================================================================
+// synopsis: do_release_frame_snapshot(aShotPtr)
+//
+// drops one rendition's reference --- the last one unmaps and releases the frame buffer
+//=======================================================================================
+static void do_release_frame_snapshot(FrameSnapShot_t * aShotPtr)
+{
+    if (! g_atomic_int_dec_and_test(&aShotPtr->ref_count))
     {
-        aSaverPtr->num_saver_errors += 1;
-        return GST_FLOW_ERROR;  // invalid attributes
+        return;
     }
 
-    if ( (interlace != NULL) && (strstr(interlace, "progressive") == NULL) )
+    if (aShotPtr->map_result == 0)
     {
-        aSaverPtr->num_saver_errors += 1;
-        return GST_FLOW_ERROR;  // only "progressive" is allowed
+        gst_video_frame_unmap(&aShotPtr->frame);
     }
 
-    if (TRUE != gst_buffer_map(aBufferPtr, &map, GST_MAP_READ))
+    gst_buffer_unref(aShotPtr->buffer_ptr);
+
+    g_mutex_clear(&aShotPtr->map_mutex);
+
+    g_free(aShotPtr);
+}
+
+
+//=======================================================================================
+// synopsis: result = do_save_frame_buffer(aShotPtr, aImagePathPtr, aEncoderPtr, aOptionsPtr, aSaverPtr)
+//
+// saves one rendition of a snapped frame --- runs on an encoder worker --- returns GST_FLOW_OK or error
+//=======================================================================================
+static gint do_save_frame_buffer(FrameSnapShot_t        * aShotPtr,
+                                 const char             * aImagePathPtr,
+                                 const FrameEncoder_t   * aEncoderPtr,
+                                 const EncoderOptions_t * aOptionsPtr,
+                                 FramesSaver_t          * aSaverPtr)
+{
+    /*
+    * NOTE-1: encoders convert only what they need (PNG converts rows to RGB24, JPEG none).
+    *
+    * NOTE-2: encoders reuse the thread's scratch memory --- "allocs" stops growing once it fits.
+    *
+    * NOTE-3: with "scale=" the frame is scaled down in its own family (e.g. YUV) before the
+    *         encoder runs, hence conversion and encoding work on the small frame only.
+    *
+    * NOTE-4: with "crop=" the frame is narrowed to a view of the rectangle before scaling,
+    *         hence the samples outside of it are never read.
+    */
+
+    const PixelsFrame_t * mapped_ptr = do_map_frame_snapshot(aShotPtr, aSaverPtr);
+
+    if (mapped_ptr == NULL)
     {
-        aSaverPtr->num_saver_errors += 1;
+        g_atomic_int_inc( (gint *) &aSaverPtr->num_saver_errors );
         return GST_FLOW_ERROR;
     }
 
-    void  * data_ptr = (void*) map.data;        // pointer to frame's data bytes
-    int     data_lng = (int) map.size;          // total number of frame's bytes
-    int     num_pixs = rows * cols;
-    int     pix_size = data_lng / num_pixs;
-    int       stride = GST_ROUND_UP_4(cols * pix_size);         // bytes per row
+    PixelsFrame_t pixels = *mapped_ptr;
+
+    int errs = 0;
 
     GstClockTime now = gst_clock_get_time (The_SysClock_Ptr);
 
     guint elapsed_ms = (guint) ((now - The_LaunchTime_ns) / NANOS_PER_MILLISEC);
 
-    aSaverPtr->num_saved_frames += 1;
+    EncoderOptions_t options = *aOptionsPtr;
+
+    options.scratch_ptr = do_get_encoder_scratch();
 
-    if ( strncmp(sz_image_format, "BGR", 3) == 0 )
+    guint num_allocs = options.scratch_ptr->num_heap_allocs;
+
+    if ( (options.crop_left > 0) || (options.crop_top > 0) || (options.crop_cols > 0) || (options.crop_rows > 0) )
     {
-        data_ptr = malloc(data_lng);
-        memcpy(data_ptr, map.data, data_lng);
-        convert_BGR_frame_to_RGB(data_ptr, pix_size * 8, stride, cols, rows);
-        sz_image_format[0] = 'R';
-        sz_image_format[2] = 'B';
-    }
+        PixelsFrame_t cropped_pixels = pixels;
 
-    sprintf(sz_image_path,
+        errs = convert_frame_to_cropped_view(&cropped_pixels, &pixels,
+                                             options.crop_left, options.crop_top,
+                                             options.crop_cols, options.crop_rows);
+        pixels = cropped_pixels;
+    }
 
-            "%s%c%05u_%lu.png",
-            aSaverPtr->work_folder_path, PATH_DELIMITER,
-            aSaverPtr->num_saved_frames,
-            (unsigned long)time(NULL)
-            );
+    int scaled_cols, scaled_rows;
 
-    errs = save_frame_as_PNG(sz_image_path, sz_image_format, data_ptr, data_lng, stride, cols, rows);
+    size_t scaled_lng = convert_frame_get_scaled_size(&pixels, options.max_cols, options.max_rows, &scaled_cols, &scaled_rows);
 
-    if (data_ptr != map.data)
+    if ( (errs == 0) && (scaled_lng > 0) )
     {
-        free(data_ptr);     // discard the copied image data
+        PixelsFrame_t scaled_pixels;
+
+        uint8_t * scaled_ptr = frame_encoder_scratch_frame(options.scratch_ptr, scaled_lng);
+
+        if ( (scaled_ptr == NULL) ||
+             (convert_frame_to_scaled(&scaled_pixels, &pixels, scaled_cols, scaled_rows, scaled_ptr) != 0) )
+        {
+            errs = -1;
+        }
+
+        pixels = scaled_pixels;
     }
 
+    errs = (errs != 0) ? errs : aEncoderPtr->save_func(aImagePathPtr, &pixels, &options);
+
+    g_atomic_int_add( (gint *) &aSaverPtr->num_encoder_allocs, (gint) (options.scratch_ptr->num_heap_allocs - num_allocs) );
+
     #ifndef _NO_DBG_TRACE
-    	GST_DEBUG(PREFIX_FORMAT "playtime=%u ... Saved=(%s), Error=(%d) \n", aSaverPtr->instance_ID,
+    	GST_DEBUG(PREFIX_FORMAT "playtime=%u ... Saved=(%s), Format=(%s), Error=(%d) \n", aSaverPtr->instance_ID,
     			elapsed_ms,
-				strrchr(sz_image_path, PATH_DELIMITER) + 1,
+				strrchr(aImagePathPtr, PATH_DELIMITER) + 1,
+				GST_VIDEO_INFO_NAME(&aShotPtr->video_info),
 				errs);
 	#endif
 
-    gst_buffer_unmap (aBufferPtr, &map);
-
     if (errs != 0)
     {
-        aSaverPtr->num_saver_errors += 1;
+        g_atomic_int_inc( (gint *) &aSaverPtr->num_saver_errors );
     }
 
     return (errs == 0) ? GST_FLOW_OK : GST_FLOW_OK;
@@ -360,135 +601,330 @@ static gint do_save_frame_buffer(GstBuffer     * aBufferPtr,
 
 
 //=======================================================================================
-// synopsis: result = do_appsink_callback_for_new_frame(aAppSinkPtr, aContextPtr)
+// synopsis: do_drop_frame_snap_job(aJobPtr)
 //
-// appsink callback for new-frame events
+// releases a job's frame buffer and memory --- called when a job ends or is flushed
 //=======================================================================================
-static GstFlowReturn do_appsink_callback_for_new_frame(GstAppSink * aAppSinkPtr,
-                                                       gpointer     aContextPtr)
+static void do_drop_frame_snap_job(gpointer aJobPtr)
 {
-    GstFlowReturn   flow_result = GST_FLOW_OK;
+    FrameSnapJob_t * job_ptr = (FrameSnapJob_t *) aJobPtr;
 
-    FramesSaver_t *   saver_ptr = (FramesSaver_t *) aContextPtr;
+    do_release_frame_snapshot(job_ptr->shot_ptr);
 
-    FlowSplicer_t * splicer_ptr = do_get_splicer_ptr( saver_ptr );
+    g_free(job_ptr->image_path_ptr);
 
-    GstSample     *  sample_ptr = gst_app_sink_pull_sample(aAppSinkPtr);
+    g_free(job_ptr);
+}
 
-    GstCaps       *    caps_ptr = sample_ptr ? gst_sample_get_caps(sample_ptr) : NULL;
 
-    GstBuffer     *  buffer_ptr = sample_ptr ? gst_sample_get_buffer(sample_ptr) : NULL;
+//=======================================================================================
+// synopsis: do_run_frame_snap_job(aJobPtr)
+//
+// converts, encodes and writes one rendition of a snapped frame --- called by an encoder worker
+//=======================================================================================
+static void do_run_frame_snap_job(gpointer aJobPtr)
+{
+    FrameSnapJob_t * job_ptr = (FrameSnapJob_t *) aJobPtr;
 
-    // verify valid conditions
-    if ( (buffer_ptr == NULL) || (caps_ptr == NULL) || (saver_ptr == NULL) )
-    {
-        saver_ptr->num_stream_errors += 1;
+    gint64 start_us = g_get_monotonic_time();
 
-        gst_sample_unref(sample_ptr);
+    do_save_frame_buffer(job_ptr->shot_ptr,
+                         job_ptr->image_path_ptr,
+                         job_ptr->encoder_ptr,
+                         &job_ptr->options,
+                         job_ptr->saver_ptr);
 
-        gst_caps_unref(caps_ptr);
+    frame_load_ladder_add_latency(&job_ptr->saver_ptr->load_ladder, g_get_monotonic_time() - start_us);
 
-        return GST_FLOW_ERROR;
+    do_drop_frame_snap_job(job_ptr);
+}
+
+
+//=======================================================================================
+// synopsis: is_shed = do_update_load_ladder(aSaverPtr)
+//
+// called once per snap --- steps the load ladder by the queues' backlog and drops ---
+// returns TRUE iff the snap must be skipped
+//=======================================================================================
+static gboolean do_update_load_ladder(FramesSaver_t * aSaverPtr)
+{
+    SplicerParams_t * params_ptr = &do_get_splicer_ptr(aSaverPtr)->params;
+
+    guint num_drops = 0;
+
+    int index = (int) G_N_ELEMENTS(aSaverPtr->encoder_queues);
+
+    while (--index >= 0)
+    {
+        num_drops += frame_encoder_queue_get_drops(&aSaverPtr->encoder_queues[index]);
     }
 
-    saver_ptr->num_stream_frames += 1;
+    // the primary image's queue holds the backlog --- renditions follow its pace
+    guint backlog = frame_encoder_queue_get_pending(&aSaverPtr->encoder_queues[0]);
 
-    if (splicer_ptr->params.one_snap_ms > 0)
+    guint period_ms = (params_ptr->snaps_pace == e_PACE_BY_FRAMES) ? 0 : params_ptr->one_snap_ms;
+
+    if (frame_load_ladder_update(&aSaverPtr->load_ladder, backlog, num_drops, period_ms))
     {
-        guint total_done = saver_ptr->num_saver_errors + saver_ptr->num_saved_frames;
+        guint num_steps = 0;
 
-        if (saver_ptr->num_snap_signals > total_done)
-        {
-            gchar * psz_caps = gst_caps_to_string(caps_ptr);
+        LOAD_LEVEL_e level = frame_load_ladder_get_level(&aSaverPtr->load_ladder, &num_steps);
 
-            flow_result = do_save_frame_buffer(buffer_ptr, psz_caps, saver_ptr);
+        GST_INFO(PREFIX_FORMAT "load=%s --- steps=%u, backlog=%u, drops=%u \n", aSaverPtr->instance_ID,
+                 frame_load_ladder_get_name(level),
+                 num_steps,
+                 backlog,
+                 num_drops);
+    }
 
-            g_free(psz_caps);
-        }
+    // the first snap is never skipped --- it makes the snaps' folder
+    return (aSaverPtr->num_snap_signals > 1) && frame_load_ladder_should_shed(&aSaverPtr->load_ladder);
+}
+
+
+//=======================================================================================
+// synopsis: do_degrade_encoder_options(aOptionsPtr, aLevel, aVideoInfoPtr)
+//
+// makes one image cheaper as the load ladder's level requires
+//=======================================================================================
+static void do_degrade_encoder_options(EncoderOptions_t   * aOptionsPtr,
+                                       LOAD_LEVEL_e         aLevel,
+                                       const GstVideoInfo * aVideoInfoPtr)
+{
+    if (aLevel >= e_LOAD_EFFORT)
+    {
+        // fastest deflate which still compresses --- and a lower quality for lossy encoders
+        aOptionsPtr->png.level   = ((aOptionsPtr->png.level < 0) || (aOptionsPtr->png.level > 1)) ? 1 : aOptionsPtr->png.level;
+        aOptionsPtr->png.filters = (aOptionsPtr->png.filters == e_PNG_FILTER_NONE) ? e_PNG_FILTER_NONE : e_PNG_FILTER_SUB;
+
+        aOptionsPtr->quality = (aOptionsPtr->quality > 0) ? MIN(aOptionsPtr->quality, LOAD_EFFORT_QUALITY) : LOAD_EFFORT_QUALITY;
     }
 
-    gst_sample_unref(sample_ptr);
+    if (aLevel >= e_LOAD_SCALE)
+    {
+        // half of the configured bounds --- else of the cropped or whole frame
+        int max_cols = (aOptionsPtr->max_cols  > 0) ? aOptionsPtr->max_cols  :
+                       (aOptionsPtr->crop_cols > 0) ? aOptionsPtr->crop_cols : GST_VIDEO_INFO_WIDTH(aVideoInfoPtr);
 
-    gst_caps_unref(caps_ptr);
+        int max_rows = (aOptionsPtr->max_rows  > 0) ? aOptionsPtr->max_rows  :
+                       (aOptionsPtr->crop_rows > 0) ? aOptionsPtr->crop_rows : GST_VIDEO_INFO_HEIGHT(aVideoInfoPtr);
 
-    return flow_result;
+        aOptionsPtr->max_cols = MAX(max_cols / 2, 1);
+        aOptionsPtr->max_rows = MAX(max_rows / 2, 1);
+    }
 }
 
 
 //=======================================================================================
-// synopsis: result = do_appsink_callback_probe_inp_pad_BUF(aPadPtr, aInfoPtr, aCtxPtr)
+// synopsis: result = do_enqueue_frame_buffer(aBufferPtr, aVideoInfoPtr, aSaverPtr)
 //
-// appsink callback for input-pad BUFFER events
+// queues each rendition of a frame for the encoder pool --- returns GST_FLOW_OK on success, else error
 //=======================================================================================
-static GstPadProbeReturn do_appsink_callback_probe_inp_pad_BUF(GstPad          * aPadPtr,
-                                                               GstPadProbeInfo * aInfoPtr,
-                                                               gpointer          aCtxPtr)
+static gint do_enqueue_frame_buffer(GstBuffer          * aBufferPtr,
+                                    const GstVideoInfo * aVideoInfoPtr,
+                                    FramesSaver_t      * aSaverPtr)
 {
-    FramesSaver_t *   saver_ptr = (FramesSaver_t *) aCtxPtr;
+    // possibly --- caps were not negotiated yet
+    if ( (aVideoInfoPtr == NULL) || (aVideoInfoPtr->finfo == NULL) ||
+         (GST_VIDEO_INFO_FORMAT(aVideoInfoPtr) == GST_VIDEO_FORMAT_UNKNOWN) )
+    {
+        return GST_FLOW_ERROR;
+    }
 
-    FlowSplicer_t * splicer_ptr = do_get_splicer_ptr( saver_ptr );
+    SplicerParams_t * params_ptr = &do_get_splicer_ptr(aSaverPtr)->params;
 
-    GstBuffer    * buffer_ptr = GST_PAD_PROBE_INFO_BUFFER(aInfoPtr);
+    const FrameEncoder_t * encoders_array[1 + MAX_EXTRA_RENDITIONS];
 
-    GstEvent     *  event_ptr = GST_PAD_PROBE_INFO_DATA(aInfoPtr);
+    int num_jobs = 1 + (int) MIN(params_ptr->num_renditions, MAX_EXTRA_RENDITIONS),   job_index;
 
-    GstEventType  event_type = GST_EVENT_TYPE(event_ptr);
+    for ( job_index = 0;  job_index < num_jobs;  ++job_index )
+    {
+        encoders_array[job_index] = frame_encoders_find( (job_index == 0) ? params_ptr->image_format
+                                                                          : params_ptr->renditions[job_index - 1].image_format );
+        if (encoders_array[job_index] == NULL)
+        {
+            return GST_FLOW_ERROR;
+        }
+    }
 
-    if ( (buffer_ptr == NULL) || (event_type == GST_EVENT_UNKNOWN) )
+    LOAD_LEVEL_e load_level = e_LOAD_NORMAL;
+
+    if (params_ptr->load_level != e_LOAD_NORMAL)
     {
-        return GST_PAD_PROBE_OK;
+        // possibly --- overloaded --- the snap is done without queueing a frame
+        if ( do_update_load_ladder(aSaverPtr) )
+        {
+            aSaverPtr->num_snap_signals -= 1;
+            aSaverPtr->num_shed_snaps   += 1;
+
+            return GST_FLOW_OK;
+        }
+
+        load_level = frame_load_ladder_get_level(&aSaverPtr->load_ladder, NULL);
     }
 
-#ifdef _USE_APPSINK_CALLBACKS_
-    if ( saver_ptr->attached_plugin_ptr == NULL )
+    EncoderOptions_t options;
+
+    memset(&options, 0, sizeof(options));
+
+    options.quality        = (int) params_ptr->image_quality;
+    options.png.level      = params_ptr->png_level;
+    options.png.filters    = (int) params_ptr->png_filters;
+    options.png.strategy   = (PNG_STRATEGY_e) params_ptr->png_strategy;
+    options.png.num_strips = (int) params_ptr->png_strips;
+    options.max_cols       = (int) params_ptr->scale_cols;
+    options.max_rows       = (int) params_ptr->scale_rows;
+    options.crop_left      = (int) params_ptr->crop_left;
+    options.crop_top       = (int) params_ptr->crop_top;
+    options.crop_cols      = (int) params_ptr->crop_cols;
+    options.crop_rows      = (int) params_ptr->crop_rows;
+
+    // "crop=roi" --- frames without a region of interest are saved whole
+    if (params_ptr->crop_to_roi)
     {
-        // GST_DEBUG_OBJECT(aPadPtr, "appsink-inp-pad --- BUF event !!! ");
-        return GST_PAD_PROBE_OK;
+        GstVideoRegionOfInterestMeta * roi_ptr = gst_buffer_get_video_region_of_interest_meta(aBufferPtr);
+
+        options.crop_left = (roi_ptr == NULL) ? 0 : (int) roi_ptr->x;
+        options.crop_top  = (roi_ptr == NULL) ? 0 : (int) roi_ptr->y;
+        options.crop_cols = (roi_ptr == NULL) ? 0 : (int) MAX( roi_ptr->w, 1 );
+        options.crop_rows = (roi_ptr == NULL) ? 0 : (int) MAX( roi_ptr->h, 1 );
     }
-#endif
 
-    saver_ptr->num_stream_frames += 1;
+    // all renditions share the buffer --- the first one to run maps it for the others
+    FrameSnapShot_t * shot_ptr = g_new0(FrameSnapShot_t, 1);
 
-    // note: "buffer" here --- "sample" in do_appsink_callback_for_new_frame()
-    if ( (splicer_ptr->params.one_snap_ms > 0) &&
-         (saver_ptr->num_snap_signals > saver_ptr->num_saved_frames) )
+    shot_ptr->ref_count  = num_jobs;
+    shot_ptr->buffer_ptr = gst_buffer_ref(aBufferPtr);
+    shot_ptr->video_info = *aVideoInfoPtr;
+    shot_ptr->map_result = 1;
+
+    g_mutex_init(&shot_ptr->map_mutex);
+
+    guint frame_number = aSaverPtr->num_queued_frames + 1;
+
+    unsigned long snap_time = (unsigned long) time(NULL);
+
+    // the renditions share the buffer --- each one is charged its part of the pool's budget
+    gsize num_bytes = (gst_buffer_get_size(aBufferPtr) + num_jobs - 1) / num_jobs;
+
+    int num_queued = 0;
+
+    for ( job_index = 0;  job_index < num_jobs;  ++job_index )
     {
-        GstCaps * caps_ptr = gst_pad_get_current_caps(aPadPtr);
+        FrameSnapJob_t * job_ptr = g_new(FrameSnapJob_t, 1);
 
-        gchar   * psz_caps = gst_caps_to_string(caps_ptr);
+        job_ptr->saver_ptr   = aSaverPtr;
+        job_ptr->shot_ptr    = shot_ptr;
+        job_ptr->encoder_ptr = encoders_array[job_index];
+        job_ptr->options     = options;
+
+        if (job_index == 0)
+        {
+            job_ptr->image_path_ptr = g_strdup_printf("%s%c%05u_%lu.%s",
+                                                      aSaverPtr->work_folder_path, PATH_DELIMITER,
+                                                      frame_number,
+                                                      snap_time,
+                                                      job_ptr->encoder_ptr->extension);
+        }
+        else
+        {
+            const RenditionParams_t * rendition_ptr = &params_ptr->renditions[job_index - 1];
+
+            job_ptr->options.quality   = (int) rendition_ptr->image_quality;
+            job_ptr->options.max_cols  = (int) rendition_ptr->scale_cols;
+            job_ptr->options.max_rows  = (int) rendition_ptr->scale_rows;
+            job_ptr->options.crop_left = (int) rendition_ptr->crop_left;
+            job_ptr->options.crop_top  = (int) rendition_ptr->crop_top;
+            job_ptr->options.crop_cols = (int) rendition_ptr->crop_cols;
+            job_ptr->options.crop_rows = (int) rendition_ptr->crop_rows;
+
+            job_ptr->image_path_ptr = g_strdup_printf("%s%c%05u_%lu_r%d.%s",
+                                                      aSaverPtr->work_folder_path, PATH_DELIMITER,
+                                                      frame_number,
+                                                      snap_time,
+                                                      job_index,
+                                                      job_ptr->encoder_ptr->extension);
+        }
 
-        do_save_frame_buffer( buffer_ptr, psz_caps, saver_ptr );
+        do_degrade_encoder_options(&job_ptr->options, load_level, aVideoInfoPtr);
 
-        gst_caps_unref(caps_ptr);
+        // each rendition has its own queue --- the renditions of a snap are encoded in parallel
+        if (frame_encoder_pool_submit(&aSaverPtr->encoder_queues[job_index],
+                                      do_run_frame_snap_job,
+                                      do_drop_frame_snap_job,
+                                      job_ptr,
+                                      num_bytes) != 0)
+        {
+            do_drop_frame_snap_job(job_ptr);    // refused by the queue's policy --- this rendition is skipped
+            continue;
+        }
 
-        g_free(psz_caps);
+        num_queued += 1;
     }
 
-    return GST_PAD_PROBE_OK;
+    if (num_queued == 0)
+    {
+        return GST_FLOW_ERROR;      // queues are full --- retry with a later frame
+    }
+
+    aSaverPtr->num_queued_frames = frame_number;
+
+    return GST_FLOW_OK;
 }
 
 
 //=======================================================================================
-// synopsis: result = do_appsink_callback_probe_inp_pad_EOS(aPadPtr, aInfoPtr, aCtxPtr)
+// synopsis: info_ptr = do_cache_video_info(aSaverPtr, aCapsPtr)
 //
-// appsink callback for input-pad events --- se for EOS
+// parses caps only when they change --- returns cached video info, else NULL when invalid
 //=======================================================================================
-static GstPadProbeReturn do_appsink_callback_probe_inp_pad_EOS(GstPad          * aPadPtr,
-                                                               GstPadProbeInfo * aInfoPtr,
-                                                               gpointer          aCtxPtr)
+static const GstVideoInfo * do_cache_video_info(FramesSaver_t * aSaverPtr, GstCaps * aCapsPtr)
 {
-    GstEvent* event_data_ptr = GST_PAD_PROBE_INFO_DATA(aInfoPtr);
+    if (aCapsPtr == NULL)
+    {
+        return NULL;
+    }
 
-    GstEventType  event_type = GST_EVENT_TYPE(event_data_ptr);
+    // same caps object --- or equal caps --- hence the same video info
+    if ( (aCapsPtr != aSaverPtr->video_caps_ptr) &&
+         ( (aSaverPtr->video_caps_ptr == NULL) || ! gst_caps_is_equal(aCapsPtr, aSaverPtr->video_caps_ptr) ) )
+    {
+        if (! gst_video_info_from_caps(&aSaverPtr->video_info, aCapsPtr))
+        {
+            gst_caps_replace(&aSaverPtr->video_caps_ptr, NULL);
 
-    if (event_type != GST_EVENT_EOS)
+            return NULL;
+        }
+    }
+
+    gst_caps_replace(&aSaverPtr->video_caps_ptr, aCapsPtr);
+
+    return &aSaverPtr->video_info;
+}
+
+
+//=======================================================================================
+// synopsis: do_flush_frame_snaps(aSaverPtr)
+//
+// discards queued frames and waits for a frame being saved, then resets the counters
+//=======================================================================================
+static void do_flush_frame_snaps(FramesSaver_t * aSaverPtr)
+{
+    int index = (int) G_N_ELEMENTS(aSaverPtr->encoder_queues);
+
+    while (--index >= 0)
     {
-        return GST_PAD_PROBE_PASS;
+        frame_encoder_queue_flush( &aSaverPtr->encoder_queues[index] );
     }
 
-    GST_DEBUG_OBJECT(aPadPtr, "appsink-inp-pad --- EOS event !!! ");
+    aSaverPtr->num_saver_errors  = 0;
+    aSaverPtr->num_saved_frames  = 0;
+    aSaverPtr->num_queued_frames = 0;
+    aSaverPtr->num_snap_signals  = 0;
+    aSaverPtr->snap_pace_next_at = 0;
+    aSaverPtr->num_shed_snaps    = 0;
 
-    return GST_PAD_PROBE_OK;
+    frame_load_ladder_reset( &aSaverPtr->load_ladder );
 }
 
 
@@ -503,6 +939,12 @@ static gboolean do_appsink_trigger_next_frame_snap(FramesSaver_t * aSaverPtr, ui
 
     GstClockTime next_snap_nanos = NANOS_PER_MILLISEC *splicer_ptr->params.one_snap_ms;
 
+    // possibly --- overloaded --- the snaps interval is stretched
+    if (frame_load_ladder_get_level(&aSaverPtr->load_ladder, NULL) >= e_LOAD_STRETCH)
+    {
+        next_snap_nanos *= LOAD_STRETCH_FACTOR;
+    }
+
     // establish a desired time for next frame snap
     aSaverPtr->frame_snap_wait_ns += next_snap_nanos;
 
@@ -540,43 +982,230 @@ static gboolean do_appsink_trigger_next_frame_snap(FramesSaver_t * aSaverPtr, ui
             aSaverPtr->num_snap_signals = 0;
         }
 
-        next_snap_nanos += NANOS_PER_MILLISEC * elapsedPlaytimeMillis;
+        next_snap_nanos += NANOS_PER_MILLISEC * elapsedPlaytimeMillis;
+
+        aSaverPtr->frame_snap_wait_ns = next_snap_nanos;
+    }
+
+    gboolean is_more_snaps_ok = TRUE;
+
+    if ((splicer_ptr->params.max_num_snaps_saved > 0) &&
+        (splicer_ptr->params.max_num_snaps_saved <= aSaverPtr->num_queued_frames))
+    {
+        GST_DEBUG(PREFIX_FORMAT "playtime=%u ... #SAVED=%u ... Reached-Limit \n", aSaverPtr->instance_ID,
+                elapsedPlaytimeMillis,
+                splicer_ptr->params.max_num_snaps_saved);
+
+         is_more_snaps_ok = FALSE;
+    }
+    else if ((splicer_ptr->params.max_num_failed_snap > 0) &&
+             (splicer_ptr->params.max_num_failed_snap <= aSaverPtr->num_saver_errors))
+    {
+        GST_DEBUG(PREFIX_FORMAT "playtime=%u ... #FAILS=%u ... Reached-Limit \n", aSaverPtr->instance_ID,
+                elapsedPlaytimeMillis,
+                splicer_ptr->params.max_num_failed_snap);
+
+         is_more_snaps_ok = FALSE;
+    }
+    else if ((aSaverPtr->attached_plugin_ptr != NULL) && (splicer_ptr->params.max_wait_ms > 0))
+    {
+        GST_DEBUG(PREFIX_FORMAT "playtime=%u ... #snaps=%u ... #saved=%u ... errors=%u,%u ... frames=%u\n", aSaverPtr->instance_ID,
+                elapsedPlaytimeMillis,
+                aSaverPtr->num_snap_signals,
+                aSaverPtr->num_saved_frames,
+                aSaverPtr->num_saver_errors,
+                aSaverPtr->num_stream_errors,
+                aSaverPtr->num_stream_frames);
+    }
+
+    return is_more_snaps_ok;
+}
+
+
+//=======================================================================================
+// synopsis: do_pace_next_frame_snap(aSaverPtr, aRunningTime)
+//
+// called upon buffer arrival --- triggers a snap when the stream reaches the next one
+//=======================================================================================
+static void do_pace_next_frame_snap(FramesSaver_t * aSaverPtr, GstClockTime aRunningTime)
+{
+    FlowSplicer_t * splicer_ptr = do_get_splicer_ptr( aSaverPtr );
+
+    guint64         snap_period = splicer_ptr->params.one_snap_ms;
+
+    guint64         snap_pacing = aSaverPtr->num_stream_frames - 1;    // first frame is 0
+
+    if (splicer_ptr->params.snaps_pace == e_PACE_BY_STREAM)
+    {
+        // possibly --- buffer without timestamp, or outside of the segment
+        if (! GST_CLOCK_TIME_IS_VALID(aRunningTime))
+        {
+            return;
+        }
+
+        snap_pacing = aRunningTime;
+        snap_period = NANOS_PER_MILLISEC * snap_period;
+    }
+
+    // possibly --- overloaded --- the snaps interval is stretched
+    if (frame_load_ladder_get_level(&aSaverPtr->load_ladder, NULL) >= e_LOAD_STRETCH)
+    {
+        snap_period *= LOAD_STRETCH_FACTOR;
+    }
+
+    if ( (snap_pacing < aSaverPtr->snap_pace_next_at) || (aSaverPtr->snap_pace_next_at == GST_CLOCK_TIME_NONE) )
+    {
+        return;
+    }
+
+    // next snap is due at the next period boundary --- skipped boundaries are not snapped
+    aSaverPtr->snap_pace_next_at = ((snap_pacing / snap_period) + 1) * snap_period;
+
+    uint32_t playtime_ms = (uint32_t) ((gst_clock_get_time(The_SysClock_Ptr) - The_LaunchTime_ns) / NANOS_PER_MILLISEC);
+
+    // possibly --- disable snaps --- effectively "never" reached
+    if (! do_appsink_trigger_next_frame_snap( aSaverPtr, playtime_ms ))
+    {
+        aSaverPtr->num_snap_signals = aSaverPtr->num_queued_frames;
+
+        aSaverPtr->snap_pace_next_at = GST_CLOCK_TIME_NONE;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: result = do_appsink_callback_for_new_frame(aAppSinkPtr, aContextPtr)
+//
+// appsink callback for new-frame events
+//=======================================================================================
+static GstFlowReturn do_appsink_callback_for_new_frame(GstAppSink * aAppSinkPtr,
+                                                       gpointer     aContextPtr)
+{
+    GstFlowReturn   flow_result = GST_FLOW_OK;
+
+    FramesSaver_t *   saver_ptr = (FramesSaver_t *) aContextPtr;
+
+    FlowSplicer_t * splicer_ptr = do_get_splicer_ptr( saver_ptr );
+
+    GstSample     *  sample_ptr = gst_app_sink_pull_sample(aAppSinkPtr);
+
+    GstCaps       *    caps_ptr = sample_ptr ? gst_sample_get_caps(sample_ptr) : NULL;
+
+    GstBuffer     *  buffer_ptr = sample_ptr ? gst_sample_get_buffer(sample_ptr) : NULL;
+
+    // verify valid conditions
+    if ( (buffer_ptr == NULL) || (caps_ptr == NULL) || (saver_ptr == NULL) )
+    {
+        saver_ptr->num_stream_errors += 1;
+
+        gst_sample_unref(sample_ptr);
+
+        gst_caps_unref(caps_ptr);
+
+        return GST_FLOW_ERROR;
+    }
+
+    saver_ptr->num_stream_frames += 1;
+
+    if (splicer_ptr->params.one_snap_ms > 0)
+    {
+        if (splicer_ptr->params.snaps_pace != e_PACE_BY_CLOCK)
+        {
+            GstSegment * segment_ptr = gst_sample_get_segment(sample_ptr);
+
+            GstClockTime running_time = (segment_ptr == NULL) ? GST_CLOCK_TIME_NONE :
+                                        gst_segment_to_running_time(segment_ptr, GST_FORMAT_TIME, GST_BUFFER_PTS(buffer_ptr));
+
+            do_pace_next_frame_snap( saver_ptr, running_time );
+        }
+
+        if (saver_ptr->num_snap_signals > saver_ptr->num_queued_frames)
+        {
+            flow_result = do_enqueue_frame_buffer(buffer_ptr, do_cache_video_info(saver_ptr, caps_ptr), saver_ptr);
+        }
+    }
+
+    gst_sample_unref(sample_ptr);
+
+    gst_caps_unref(caps_ptr);
+
+    return flow_result;
+}
+
+
+//=======================================================================================
+// synopsis: result = do_appsink_callback_probe_inp_pad_BUF(aPadPtr, aInfoPtr, aCtxPtr)
+//
+// appsink callback for input-pad BUFFER events
+//=======================================================================================
+static GstPadProbeReturn do_appsink_callback_probe_inp_pad_BUF(GstPad          * aPadPtr,
+                                                               GstPadProbeInfo * aInfoPtr,
+                                                               gpointer          aCtxPtr)
+{
+    FramesSaver_t *   saver_ptr = (FramesSaver_t *) aCtxPtr;
+
+    FlowSplicer_t * splicer_ptr = do_get_splicer_ptr( saver_ptr );
+
+    GstBuffer    * buffer_ptr = GST_PAD_PROBE_INFO_BUFFER(aInfoPtr);
+
+    GstEvent     *  event_ptr = GST_PAD_PROBE_INFO_DATA(aInfoPtr);
+
+    GstEventType  event_type = GST_EVENT_TYPE(event_ptr);
+
+    if ( (buffer_ptr == NULL) || (event_type == GST_EVENT_UNKNOWN) )
+    {
+        return GST_PAD_PROBE_OK;
+    }
+
+#ifdef _USE_APPSINK_CALLBACKS_
+    if ( saver_ptr->attached_plugin_ptr == NULL )
+    {
+        // GST_DEBUG_OBJECT(aPadPtr, "appsink-inp-pad --- BUF event !!! ");
+        return GST_PAD_PROBE_OK;
+    }
+#endif
+
+    saver_ptr->num_stream_frames += 1;
+
+    // note: "buffer" here --- "sample" in do_appsink_callback_for_new_frame()
+    if ( (splicer_ptr->params.one_snap_ms > 0) &&
+         (saver_ptr->num_snap_signals > saver_ptr->num_queued_frames) )
+    {
+        GstCaps * caps_ptr = gst_pad_get_current_caps(aPadPtr);
+
+        do_enqueue_frame_buffer( buffer_ptr, do_cache_video_info(saver_ptr, caps_ptr), saver_ptr );
 
-        aSaverPtr->frame_snap_wait_ns = next_snap_nanos;
+        if (caps_ptr != NULL)
+        {
+            gst_caps_unref(caps_ptr);
+        }
     }
 
-    gboolean is_more_snaps_ok = TRUE;
+    return GST_PAD_PROBE_OK;
+}
 
-    if ((splicer_ptr->params.max_num_snaps_saved > 0) &&
-        (splicer_ptr->params.max_num_snaps_saved <= aSaverPtr->num_saved_frames))
-    {
-        GST_DEBUG(PREFIX_FORMAT "playtime=%u ... #SAVED=%u ... Reached-Limit \n", aSaverPtr->instance_ID,
-                elapsedPlaytimeMillis,
-                splicer_ptr->params.max_num_snaps_saved);
 
-         is_more_snaps_ok = FALSE;
-    }
-    else if ((splicer_ptr->params.max_num_failed_snap > 0) &&
-             (splicer_ptr->params.max_num_failed_snap <= aSaverPtr->num_saver_errors))
-    {
-        GST_DEBUG(PREFIX_FORMAT "playtime=%u ... #FAILS=%u ... Reached-Limit \n", aSaverPtr->instance_ID,
-                elapsedPlaytimeMillis,
-                splicer_ptr->params.max_num_failed_snap);
+//=======================================================================================
+// synopsis: result = do_appsink_callback_probe_inp_pad_EOS(aPadPtr, aInfoPtr, aCtxPtr)
+//
+// appsink callback for input-pad events --- se for EOS
+//=======================================================================================
+static GstPadProbeReturn do_appsink_callback_probe_inp_pad_EOS(GstPad          * aPadPtr,
+                                                               GstPadProbeInfo * aInfoPtr,
+                                                               gpointer          aCtxPtr)
+{
+    GstEvent* event_data_ptr = GST_PAD_PROBE_INFO_DATA(aInfoPtr);
 
-         is_more_snaps_ok = FALSE;
-    }
-    else if ((aSaverPtr->attached_plugin_ptr != NULL) && (splicer_ptr->params.max_wait_ms > 0))
+    GstEventType  event_type = GST_EVENT_TYPE(event_data_ptr);
+
+    if (event_type != GST_EVENT_EOS)
     {
-        GST_DEBUG(PREFIX_FORMAT "playtime=%u ... #snaps=%u ... #saved=%u ... errors=%u,%u ... frames=%u\n", aSaverPtr->instance_ID,
-                elapsedPlaytimeMillis,
-                aSaverPtr->num_snap_signals,
-                aSaverPtr->num_saved_frames,
-                aSaverPtr->num_saver_errors,
-                aSaverPtr->num_stream_errors,
-                aSaverPtr->num_stream_frames);
+        return GST_PAD_PROBE_PASS;
     }
 
-    return is_more_snaps_ok;
+    GST_DEBUG_OBJECT(aPadPtr, "appsink-inp-pad --- EOS event !!! ");
+
+    return GST_PAD_PROBE_OK;
 }
 
 
@@ -1286,11 +1915,11 @@ gboolean do_pipeline_validate_splicer_parameters(FramesSaver_t * aSaverPtr)
 
 
 //=======================================================================================
-// synopsis: is_ok = do_pipeline_callback_for_idle_time()
+// synopsis: delay = do_pipeline_callback_for_snap_timer(aCtxPtr)
 //
-// callback when the pipeline's main-loop-thread is idle --- return TRUE always
+// callback when a snap or wait-state deadline is due --- returns micros until next one
 //=======================================================================================
-static gboolean do_pipeline_callback_for_idle_time(gpointer aCtxPtr)
+static gint64 do_pipeline_callback_for_snap_timer(gpointer aCtxPtr)
 {
     FramesSaver_t   * saver_ptr = (FramesSaver_t *) aCtxPtr;
 
@@ -1306,6 +1935,12 @@ static gboolean do_pipeline_callback_for_idle_time(gpointer aCtxPtr)
     // possibly --- TEE was inserted or is not wanted
     if ( (saver_ptr->wait_state_ends_ns == 0) || (saver_ptr->tee_element_ptr == NULL) )
     {
+        // possibly --- snaps are paced by the arriving buffers --- the timer is not needed
+        if (splicer_ptr->params.snaps_pace != e_PACE_BY_CLOCK)
+        {
+            return -1;
+        }
+
         if (elapsed_ns > saver_ptr->frame_snap_wait_ns)
         {
             gboolean more_ok = do_appsink_trigger_next_frame_snap( saver_ptr, playtime_ms );
@@ -1313,13 +1948,19 @@ static gboolean do_pipeline_callback_for_idle_time(gpointer aCtxPtr)
             // possibly --- disable snaps --- effectively "infinit" wait time
             if (! more_ok)
             {
-                saver_ptr->num_snap_signals = saver_ptr->num_saved_frames;
+                saver_ptr->num_snap_signals = saver_ptr->num_queued_frames;
 
                 saver_ptr->frame_snap_wait_ns += INFINIT_NANOS;
             }
         }
 
-        return TRUE;
+        // sleep until the next snap --- wait= and snap= changes reschedule the timer
+        if (saver_ptr->frame_snap_wait_ns < elapsed_ns)
+        {
+            return 0;
+        }
+
+        return (gint64) ((saver_ptr->frame_snap_wait_ns - elapsed_ns) / 1000) + 1;
     }
 
     // possibly --- try-or-retry to insert TEE into pipeline
@@ -1351,15 +1992,11 @@ static gboolean do_pipeline_callback_for_idle_time(gpointer aCtxPtr)
 
             gst_element_set_state( saver_ptr->parent_pipeline_ptr, GST_STATE_READY );
         }
-        else // NOTE: here we could report the typical intervals between "idle" callbacks
-        {
-
-        }
 
-        return TRUE;
+        return TEE_RETRY_MICROS;
     }
 
-    return TRUE;
+    return (gint64) ((saver_ptr->wait_state_ends_ns - now_nanos) / 1000) + 1;
 }
 
 
@@ -1625,9 +2262,7 @@ static gboolean do_prepare_to_play( FramesSaver_t * aSaverPtr, gboolean canSplic
     aSaverPtr->num_stream_frames = 0;
     aSaverPtr->num_stream_errors = 0;
 
-    aSaverPtr->num_saver_errors = 0;
-    aSaverPtr->num_saved_frames = 0;
-    aSaverPtr->num_snap_signals = 0;
+    do_flush_frame_snaps( aSaverPtr );
 
     if ( canSplicePipeline )
     {
@@ -1637,14 +2272,8 @@ static gboolean do_prepare_to_play( FramesSaver_t * aSaverPtr, gboolean canSplic
         }
     }
 
-    if(aSaverPtr->isIdleTaskInitialized != 1) {
-        /* Idle task addition must only be called once or we will have one created every time this is called
-         * and we can only destroy one upon object's destruction */
-
-        g_idle_add(do_pipeline_callback_for_idle_time, aSaverPtr);
-        aSaverPtr->isIdleTaskInitialized = 1;
-        GST_DEBUG("Idle task initialized.");
-    }
+    // the timer is started once --- starting it again only makes it due now
+    frame_snap_timer_start( &aSaverPtr->snap_timer, do_pipeline_callback_for_snap_timer, aSaverPtr, 0 );
 
     return TRUE;
 }
@@ -1699,7 +2328,7 @@ static gboolean do_pipeline_test_run_main_loop(FramesSaver_t * aSaverPtr)
 //=======================================================================================
 int Frame_Saver_Filter_Attach(GstElement * aPluginPtr)
 {
-    int index = do_find_plugin_index(aPluginPtr);     // -1 if not found
+    FramesSaver_t * a_saver_ptr = do_find_plugin_saver(aPluginPtr);     // NULL if not found
 
     // verify validity of plugin element
     if (aPluginPtr == NULL)
@@ -1708,10 +2337,8 @@ int Frame_Saver_Filter_Attach(GstElement * aPluginPtr)
         return -1;
     }
 
-    FramesSaver_t * a_saver_ptr = &The_FramesSavers_Array[index];
-
     // possibly --- plugin is known --- allowed
-    if (index >= 0)
+    if (a_saver_ptr != NULL)
     {
         do_DBG_print("Attach_GST --- KNOWN \n", a_saver_ptr);
         return 0;
@@ -1729,28 +2356,20 @@ int Frame_Saver_Filter_Attach(GstElement * aPluginPtr)
         return -3;  // failed to acquire mutex
     }
 
-    // establish the starting index for finding the first unused slot
-    index = (The_Plugins_Count < MAX_NUM_PLUGINS) ? -1 : MAX_NUM_PLUGINS;
+    // allocate the saver --- memory is used only while the plugin is attached
+    FramesSaver_t *   saver_ptr = g_try_new0(FramesSaver_t, 1);
 
-    // find the first unused slot in the array
-    while ( (++index < MAX_NUM_PLUGINS) && (The_FramesSavers_Array[index].instance_ID > 0) )
-    {
-        ; // next
-    }
+    FlowSplicer_t * splicer_ptr = saver_ptr ? do_get_splicer_ptr(saver_ptr) : NULL;
 
-    FramesSaver_t *   saver_ptr = &The_FramesSavers_Array[index];
+    if ( saver_ptr == NULL )
+    {
+        nativeReleaseMutex(The_Mutex_Handle);
 
-    FlowSplicer_t * splicer_ptr = do_get_splicer_ptr(saver_ptr);
+        do_DBG_print("Attach_GST --- ERROR --- OUT-OF-MEMORY \n", NULL);
 
-    if ( index >= MAX_NUM_PLUGINS )
-    {
-        do_DBG_print("Attach_GST --- ERROR --- REACHED-LIMIT \n", saver_ptr);
-    }
-    else if ( saver_ptr->attached_plugin_ptr != NULL )
-    {
-        do_DBG_print("Attach_GST --- ERROR --- ENTRY-IS-USED \n", saver_ptr);
+        return -1;
     }
-    else    // mark the slot as being used --- TO-DO: find-pipeline-as-root-parent
+    else    // TO-DO: find-pipeline-as-root-parent
     {
         ++The_Plugins_Count;
 
@@ -1758,16 +2377,27 @@ int Frame_Saver_Filter_Attach(GstElement * aPluginPtr)
 
         saver_ptr->parent_pipeline_ptr = (GstElement *) gst_element_get_parent(aPluginPtr);
 
-        saver_ptr->instance_ID = index + 1;
+        saver_ptr->instance_ID = ++The_Instances_Serial;
+
+        int queue_index;
+
+        for ( queue_index = 0;  queue_index < (int) G_N_ELEMENTS(saver_ptr->encoder_queues);  ++queue_index )
+        {
+            frame_encoder_queue_init( &saver_ptr->encoder_queues[queue_index] );
+        }
+
+        frame_load_ladder_init( &saver_ptr->load_ladder );
 
         frame_saver_params_initialize( &splicer_ptr->params );
 
+        g_object_set_qdata( G_OBJECT(aPluginPtr), The_Saver_Quark, saver_ptr );
+
         do_DBG_print("Attach_GST --- SUCCESS \n", saver_ptr);
     }
 
     nativeReleaseMutex(The_Mutex_Handle);
 
-    return (saver_ptr->attached_plugin_ptr == aPluginPtr) ? 0 : -1;
+    return 0;
 }
 
 
@@ -1790,10 +2420,10 @@ int Frame_Saver_Filter_Detach(GstElement * aPluginPtr)
         return -3;  // failed to acquire mutex
     }
 
-    int index = do_find_plugin_index(aPluginPtr);     // -1 if not found
+    FramesSaver_t * saver_ptr = do_find_plugin_saver(aPluginPtr);     // NULL if not found
 
     // possibly --- plugin is unknown
-    if (index < 0)
+    if (saver_ptr == NULL)
     {
         nativeReleaseMutex(The_Mutex_Handle);
 
@@ -1802,17 +2432,20 @@ int Frame_Saver_Filter_Detach(GstElement * aPluginPtr)
         return -1;
     }
 
-    FramesSaver_t * saver_ptr = &The_FramesSavers_Array[index];
+    g_object_set_qdata( G_OBJECT(aPluginPtr), The_Saver_Quark, NULL );
+
+    frame_snap_timer_stop(&saver_ptr->snap_timer); // no more snap callbacks
 
-    // mark the slot as empty and unused
-    saver_ptr->attached_plugin_ptr = NULL;
-    saver_ptr->parent_pipeline_ptr = NULL;
-    saver_ptr->instance_ID         = 0;
+    do_flush_frame_snaps(saver_ptr);  // release frames not yet saved
 
-    g_idle_remove_by_data(saver_ptr); // remove the idle loop callback.
+    gst_caps_replace(&saver_ptr->video_caps_ptr, NULL);
 
     do_DBG_print("Detach_GST --- SUCCESS \n", saver_ptr);
 
+    frame_load_ladder_clear(&saver_ptr->load_ladder);
+
+    g_free(saver_ptr);
+
     // release and/or delete mutex
     if ( --The_Plugins_Count == 0 )
     {
@@ -1830,34 +2463,38 @@ int Frame_Saver_Filter_Detach(GstElement * aPluginPtr)
 
 
 //=======================================================================================
-// synopsis: result = Frame_Saver_Filter_Receive_Buffer(aPluginPtr, aBufferPtr, aCapsTextPtr)
+// synopsis: result = Frame_Saver_Filter_Receive_Buffer(aPluginPtr, aBufferPtr, aRunningTime, aVideoInfoPtr)
 //
 // called at by the actual plugin upon buffer arrival --- returns GST_FLOW_OK
 //=======================================================================================
-int Frame_Saver_Filter_Receive_Buffer(GstElement * aPluginPtr,
-                                      GstBuffer  * aBufferPtr,
-                                      const char * aCapsTextPtr)
+int Frame_Saver_Filter_Receive_Buffer(GstElement         * aPluginPtr,
+                                      GstBuffer          * aBufferPtr,
+                                      GstClockTime         aRunningTime,
+                                      const GstVideoInfo * aVideoInfoPtr)
 {
     int result = (int) GST_FLOW_ERROR;
 
-    int  index = do_find_plugin_index(aPluginPtr);     // -1 if not found
+    FramesSaver_t *   saver_ptr = do_find_plugin_saver(aPluginPtr);     // NULL if not found
 
-    if (index < 0)
+    if (saver_ptr == NULL)
     {
         return result;
     }
 
-    FramesSaver_t *   saver_ptr = &The_FramesSavers_Array[index];
-
     FlowSplicer_t * splicer_ptr = do_get_splicer_ptr(saver_ptr);
 
     saver_ptr->num_stream_frames += 1;
 
     if (splicer_ptr->params.one_snap_ms > 0)
     {
-        if (saver_ptr->num_snap_signals > saver_ptr->num_saved_frames)
+        if (splicer_ptr->params.snaps_pace != e_PACE_BY_CLOCK)
+        {
+            do_pace_next_frame_snap( saver_ptr, aRunningTime );
+        }
+
+        if (saver_ptr->num_snap_signals > saver_ptr->num_queued_frames)
         {
-            result = do_save_frame_buffer( (GstBuffer *) aBufferPtr, aCapsTextPtr, saver_ptr );
+            result = do_enqueue_frame_buffer( (GstBuffer *) aBufferPtr, aVideoInfoPtr, saver_ptr );
         }
     }
 
@@ -1872,12 +2509,10 @@ int Frame_Saver_Filter_Receive_Buffer(GstElement * aPluginPtr,
 //=======================================================================================
 int Frame_Saver_Filter_Transition(GstElement * aPluginPtr, GstStateChange aTransition)
 {
-    int index = do_find_plugin_index(aPluginPtr);     // -1 if not found
+    FramesSaver_t * saver_ptr = do_find_plugin_saver(aPluginPtr);     // NULL if not found
 
-    if (index >= 0)
+    if (saver_ptr != NULL)
     {
-        FramesSaver_t *   saver_ptr = &The_FramesSavers_Array[index];
-
         FlowSplicer_t * splicer_ptr = do_get_splicer_ptr(saver_ptr);
 
         do_DBG_print("Transition \n", saver_ptr);
@@ -1911,12 +2546,12 @@ int Frame_Saver_Filter_Set_Params(GstElement  * aPluginPtr,
 
     char params_specs[MAX_PARAMS_SPECS_LNG];
 
-    int index = do_find_plugin_index(aPluginPtr);     // -1 if not found
+    FramesSaver_t *   saver_ptr = do_find_plugin_saver(aPluginPtr);     // NULL if not found
 
     int error = 0;
 
     // possibly --- plugin is unknown
-    if (index < 0)
+    if (saver_ptr == NULL)
     {
         return -1;
     }
@@ -1927,8 +2562,6 @@ int Frame_Saver_Filter_Set_Params(GstElement  * aPluginPtr,
         return -2;
     }
 
-    FramesSaver_t *   saver_ptr = &The_FramesSavers_Array[index];
-
     FlowSplicer_t * splicer_ptr = do_get_splicer_ptr(saver_ptr);
 
     if (strncmp(aNewValuePtr, "wait=", 5) == 0)
@@ -1945,6 +2578,8 @@ int Frame_Saver_Filter_Set_Params(GstElement  * aPluginPtr,
 
                 saver_ptr->frame_snap_wait_ns += INFINIT_NANOS;
 
+                saver_ptr->snap_pace_next_at = GST_CLOCK_TIME_NONE;
+
                 psz_note = "note=(PAUSED)";
             }
             else if ( (The_SysClock_Ptr != NULL) && was_paused )
@@ -1961,8 +2596,12 @@ int Frame_Saver_Filter_Set_Params(GstElement  * aPluginPtr,
 
                 saver_ptr->frame_snap_wait_ns = elapsed_ns + next_nanos;
 
+                saver_ptr->snap_pace_next_at = 0;
+
                 psz_note = "note=(RESUMED)";
             }
+
+            frame_snap_timer_schedule(&saver_ptr->snap_timer, 0);
         }
         else
         {
@@ -1989,14 +2628,14 @@ int Frame_Saver_Filter_Set_Params(GstElement  * aPluginPtr,
                     splicer_ptr->params.max_num_snaps_saved,
                     splicer_ptr->params.max_num_failed_snap);
 
-            saver_ptr->num_saver_errors = 0;
-            saver_ptr->num_saved_frames = 0;
-            saver_ptr->num_snap_signals = 0;
+            do_flush_frame_snaps(saver_ptr);
 
             saver_ptr->num_stream_frames = 0;
             saver_ptr->num_stream_errors = 0;
 
             strcpy(saver_ptr->work_folder_path, splicer_ptr->params.folder_path);
+
+            frame_snap_timer_schedule(&saver_ptr->snap_timer, 0);
         }
         else
         {
@@ -2031,6 +2670,209 @@ int Frame_Saver_Filter_Set_Params(GstElement  * aPluginPtr,
             error = 5;
         }
     }
+    else if (strncmp(aNewValuePtr, "pool=", 5) == 0)
+    {
+        if ( (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE) &&
+             (frame_encoder_pool_set_size(splicer_ptr->params.num_pool_workers) == 0) )
+        {
+            sprintf(aDstValuePtr, "pool=%u", splicer_ptr->params.num_pool_workers);
+        }
+        else
+        {
+            error = 6;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "pace=", 5) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            sprintf(aDstValuePtr, "pace=%s", &params_specs[5]);
+
+            saver_ptr->snap_pace_next_at = 0;
+
+            // possibly --- the timer stopped while snaps were paced by the stream
+            if (saver_ptr->snap_timer.func_ptr != NULL)
+            {
+                frame_snap_timer_start(&saver_ptr->snap_timer, do_pipeline_callback_for_snap_timer, saver_ptr, 0);
+            }
+        }
+        else
+        {
+            error = 7;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "fmt=", 4) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            sprintf(aDstValuePtr, "fmt=%s,%u", splicer_ptr->params.image_format, splicer_ptr->params.image_quality);
+        }
+        else
+        {
+            error = 8;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "png=", 4) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            char png_options[80];
+
+            frame_saver_params_write_png_options(&splicer_ptr->params, png_options, sizeof(png_options));
+
+            sprintf(aDstValuePtr, "png=%s", png_options);
+        }
+        else
+        {
+            error = 9;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "scale=", 6) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            if ( (splicer_ptr->params.scale_cols == 0) && (splicer_ptr->params.scale_rows == 0) )
+            {
+                sprintf(aDstValuePtr, "scale=off");
+            }
+            else
+            {
+                sprintf(aDstValuePtr, "scale=%u,%u", splicer_ptr->params.scale_cols, splicer_ptr->params.scale_rows);
+            }
+        }
+        else
+        {
+            error = 10;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "crop=", 5) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            char crop_options[60];
+
+            frame_saver_params_write_crop_options(&splicer_ptr->params, crop_options, sizeof(crop_options));
+
+            sprintf(aDstValuePtr, "crop=%s", crop_options);
+        }
+        else
+        {
+            error = 11;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "rend=", 5) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            char renditions[MAX_RENDITIONS_SPECS_LNG + 1];
+
+            frame_saver_params_write_renditions(&splicer_ptr->params, renditions, sizeof(renditions));
+
+            sprintf(aDstValuePtr, "rend=%s", renditions);
+        }
+        else
+        {
+            error = 12;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "queue=", 6) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            char queue_options[60];
+
+            int index = (int) G_N_ELEMENTS(saver_ptr->encoder_queues);
+
+            while (--index >= 0)
+            {
+                frame_encoder_queue_set_limits(&saver_ptr->encoder_queues[index],
+                                               splicer_ptr->params.queue_depth,
+                                               (QUEUE_POLICY_e) splicer_ptr->params.queue_policy);
+            }
+
+            // the budget is shared by all instances --- as the pool's workers are
+            frame_encoder_pool_set_budget( (gsize) splicer_ptr->params.queue_budget_mb << 20 );
+
+            frame_saver_params_write_queue_options(&splicer_ptr->params, queue_options, sizeof(queue_options));
+
+            sprintf(aDstValuePtr, "queue=%s", queue_options);
+        }
+        else
+        {
+            error = 13;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "prio=", 5) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            int index = (int) G_N_ELEMENTS(saver_ptr->encoder_queues);
+
+            while (--index >= 0)
+            {
+                frame_encoder_queue_set_weight(&saver_ptr->encoder_queues[index], splicer_ptr->params.queue_weight);
+            }
+
+            sprintf(aDstValuePtr, "prio=%u", splicer_ptr->params.queue_weight);
+        }
+        else
+        {
+            error = 14;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "load=", 5) == 0)
+    {
+        if (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE)
+        {
+            char load_options[40];
+
+            frame_load_ladder_configure(&saver_ptr->load_ladder,
+                                        (LOAD_LEVEL_e) splicer_ptr->params.load_level,
+                                        splicer_ptr->params.load_high_ms,
+                                        splicer_ptr->params.load_low_ms);
+
+            frame_saver_params_write_load_options(&splicer_ptr->params, load_options, sizeof(load_options));
+
+            sprintf(aDstValuePtr, "load=%s", load_options);
+        }
+        else
+        {
+            error = 15;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "cpus=", 5) == 0)
+    {
+        // the placement is shared by all instances --- as the pool's workers are
+        if ( (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE) &&
+             (frame_encoder_placement_set(splicer_ptr->params.encoder_cpus,
+                                          (ENCODER_SCHED_e) splicer_ptr->params.encoder_sched,
+                                          (int) splicer_ptr->params.encoder_nice) == 0) )
+        {
+            sprintf(aDstValuePtr, "cpus=%s", splicer_ptr->params.encoder_cpus);
+        }
+        else
+        {
+            error = 16;
+        }
+    }
+    else if (strncmp(aNewValuePtr, "sched=", 6) == 0)
+    {
+        if ( (frame_saver_params_parse_from_text(&splicer_ptr->params, params_specs) == TRUE) &&
+             (frame_encoder_placement_set(splicer_ptr->params.encoder_cpus,
+                                          (ENCODER_SCHED_e) splicer_ptr->params.encoder_sched,
+                                          (int) splicer_ptr->params.encoder_nice) == 0) )
+        {
+            char sched_options[20];
+
+            frame_saver_params_write_sched_options(&splicer_ptr->params, sched_options, sizeof(sched_options));
+
+            sprintf(aDstValuePtr, "sched=%s", sched_options);
+        }
+        else
+        {
+            error = 17;
+        }
+    }
 
     GST_ERROR(PREFIX_FORMAT "Set_Params --- Error=%d --- NOW=(%s) %s \n", saver_ptr->instance_ID, error, aDstValuePtr, psz_note);
 
@@ -2038,6 +2880,73 @@ int Frame_Saver_Filter_Set_Params(GstElement  * aPluginPtr,
 }
 
 
+//=======================================================================================
+// synopsis: length = Frame_Saver_Filter_Get_Stats(aPluginPtr, aBufferPtr, aMaxLength)
+//
+// called at by the actual plugin to report counters --- returns length of text, else -1
+//=======================================================================================
+int Frame_Saver_Filter_Get_Stats(GstElement * aPluginPtr,
+                                 gchar      * aBufferPtr,
+                                 gint         aMaxLength)
+{
+    FramesSaver_t * saver_ptr = do_find_plugin_saver(aPluginPtr);     // NULL if not found
+
+    if ( (saver_ptr == NULL) || (aBufferPtr == NULL) || (aMaxLength < 1) )
+    {
+        return -1;
+    }
+
+    gint64 late_mean_us = 0,
+           late_max_us  = 0;
+
+    guint  num_timeouts = frame_snap_timer_get_lateness(&saver_ptr->snap_timer, &late_mean_us, &late_max_us);
+
+    guint  num_drops = 0,
+           num_waits = 0;
+
+    gint64 wait_sum_us = 0,
+           wait_max_us = 0;
+
+    guint  num_steps = 0;
+
+    LOAD_LEVEL_e load_level = frame_load_ladder_get_level(&saver_ptr->load_ladder, &num_steps);
+
+    int index = (int) G_N_ELEMENTS(saver_ptr->encoder_queues);
+
+    // frames dropped by the overload policy --- apart from the encoders' errors
+    while (--index >= 0)
+    {
+        gint64 sum_us = 0,
+               max_us = 0;
+
+        num_drops += frame_encoder_queue_get_drops(&saver_ptr->encoder_queues[index]);
+
+        num_waits += frame_encoder_queue_get_waits(&saver_ptr->encoder_queues[index], &sum_us, &max_us);
+
+        wait_sum_us += sum_us;
+        wait_max_us  = MAX(wait_max_us, max_us);
+    }
+
+    return snprintf(aBufferPtr, aMaxLength,
+                    "stat=frames:%u,snaps:%u,queued:%u,saved:%u,errors:%u,drops:%u,allocs:%u,timeouts:%u,late_us:%ld/%ld,wait_us:%ld/%ld,load:%s,steps:%u,shed:%u",
+                    saver_ptr->num_stream_frames,
+                    saver_ptr->num_snap_signals,
+                    saver_ptr->num_queued_frames,
+                    g_atomic_int_get( (gint *) &saver_ptr->num_saved_frames ),
+                    g_atomic_int_get( (gint *) &saver_ptr->num_saver_errors ),
+                    num_drops,
+                    g_atomic_int_get( (gint *) &saver_ptr->num_encoder_allocs ),
+                    num_timeouts,
+                    (long) late_mean_us,
+                    (long) late_max_us,
+                    (long) ((num_waits > 0) ? (wait_sum_us / num_waits) : 0),
+                    (long) wait_max_us,
+                    frame_load_ladder_get_name(load_level),
+                    num_steps,
+                    saver_ptr->num_shed_snaps);
+}
+
+
 //=======================================================================================
 // synopsis: result = frame_saver_filter_tester(argc, argv)
 //
@@ -2055,13 +2964,22 @@ int frame_saver_filter_tester( int argc, char ** argv )
 
     gst_init(NULL, NULL);
 
-    FramesSaver_t   *  saver_ptr = &The_FramesSavers_Array[0];
+    FramesSaver_t   *  saver_ptr = g_new0(FramesSaver_t, 1);
 
     FlowSplicer_t  * splicer_ptr = do_get_splicer_ptr(saver_ptr);
 
     SplicerParams_t * params_ptr = &splicer_ptr->params;
 
-    saver_ptr->instance_ID = 1;
+    saver_ptr->instance_ID = ++The_Instances_Serial;
+
+    int queue_index;
+
+    for ( queue_index = 0;  queue_index < (int) G_N_ELEMENTS(saver_ptr->encoder_queues);  ++queue_index )
+    {
+        frame_encoder_queue_init( &saver_ptr->encoder_queues[queue_index] );
+    }
+
+    frame_load_ladder_init( &saver_ptr->load_ladder );
 
     frame_saver_params_initialize( params_ptr );
 
@@ -2076,6 +2994,26 @@ int frame_saver_filter_tester( int argc, char ** argv )
     }
     else
     {
+        for ( queue_index = 0;  queue_index < (int) G_N_ELEMENTS(saver_ptr->encoder_queues);  ++queue_index )
+        {
+            frame_encoder_queue_set_limits( &saver_ptr->encoder_queues[queue_index],
+                                            params_ptr->queue_depth,
+                                            (QUEUE_POLICY_e) params_ptr->queue_policy );
+
+            frame_encoder_queue_set_weight( &saver_ptr->encoder_queues[queue_index], params_ptr->queue_weight );
+        }
+
+        frame_encoder_pool_set_budget( (gsize) params_ptr->queue_budget_mb << 20 );
+
+        frame_encoder_placement_set( params_ptr->encoder_cpus,
+                                     (ENCODER_SCHED_e) params_ptr->encoder_sched,
+                                     (int) params_ptr->encoder_nice );
+
+        frame_load_ladder_configure( &saver_ptr->load_ladder,
+                                     (LOAD_LEVEL_e) params_ptr->load_level,
+                                     params_ptr->load_high_ms,
+                                     params_ptr->load_low_ms );
+
         result = (int) do_pipeline_create_instance(saver_ptr);  // 0 is success
 
         if (result != 0)
@@ -2090,5 +3028,15 @@ int frame_saver_filter_tester( int argc, char ** argv )
         do_frame_saver_element_cleanup( saver_ptr );
     }
 
+    frame_snap_timer_stop( &saver_ptr->snap_timer );
+
+    do_flush_frame_snaps( saver_ptr );
+
+    gst_caps_replace( &saver_ptr->video_caps_ptr, NULL );
+
+    frame_load_ladder_clear( &saver_ptr->load_ladder );
+
+    g_free( saver_ptr );
+
     return result;   // returns 0 on success
 }
@@ -19,6 +19,7 @@
 #define __Frame_Saver_Filter_H__
 
 #include <gst/gst.h>
+#include <gst/video/video.h>
 
 
 #ifdef __cplusplus
@@ -43,13 +44,17 @@ extern int Frame_Saver_Filter_Detach(GstElement * aPluginPtr);
 
 
 //=======================================================================================
-// synopsis: result = Frame_Saver_Filter_Receive_Buffer(aPluginPtr, aBufferPtr, aCapsTextPtr)
+// synopsis: result = Frame_Saver_Filter_Receive_Buffer(aPluginPtr, aBufferPtr, aRunningTime, aVideoInfoPtr)
 //
 // called at by the actual plugin upon buffer arrival --- returns GST_FLOW_OK
+//
+// aRunningTime is the buffer's running-time, or GST_CLOCK_TIME_NONE when unknown;
+// aVideoInfoPtr is the video info negotiated by the plugin --- it is copied per snap
 //=======================================================================================
-extern int Frame_Saver_Filter_Receive_Buffer(GstElement * aPluginPtr, 
-                                             GstBuffer  * aBufferPtr, 
-                                             const char * aCapsTextPtr);
+extern int Frame_Saver_Filter_Receive_Buffer(GstElement         * aPluginPtr, 
+                                             GstBuffer          * aBufferPtr, 
+                                             GstClockTime         aRunningTime,
+                                             const GstVideoInfo * aVideoInfoPtr);
 
 
 //=======================================================================================
@@ -70,6 +75,16 @@ extern int Frame_Saver_Filter_Set_Params(GstElement  * aPluginPtr,
                                          gchar       * aParamSpecPtr);
 
 
+//=======================================================================================
+// synopsis: length = Frame_Saver_Filter_Get_Stats(aPluginPtr, aBufferPtr, aMaxLength)
+//
+// called at by the actual plugin to report counters --- returns length of text, else -1
+//=======================================================================================
+extern int Frame_Saver_Filter_Get_Stats(GstElement * aPluginPtr,
+                                        gchar      * aBufferPtr,
+                                        gint         aMaxLength);
+
+
 //=======================================================================================
 // synopsis: result = frame_saver_filter_tester(argc, argv)
 //
@@ -9,6 +9,15 @@
  *              5. 2016-11-24   JBendor     Support dynamic params update
  *              6. 2016-12-08   JBendor     Support the actual Gstreamer plugin
  *              7. 2016-12-20   JBendor     Updated
+ *              8. 2026-10-17               Added "png=" deflate options
+ *              9. 2026-10-17               Added strips to "png=" options
+ *             10. 2026-10-17               Added "scale=" for scaled-down images
+ *             11. 2026-10-17               Added "crop=" for a region of the frames
+ *             12. 2026-10-17               Added "rend=" for more images of each snap
+ *             13. 2026-10-17               Added "queue=" for overload policies
+ *             14. 2026-10-17               Added "prio=" for a share of the encoder pool
+ *             15. 2026-10-17               Added "load=" for the overload ladder
+ *             16. 2026-10-17               Added "cpus=" and "sched=" for the encoder threads
  *
  * Description: implements parameters used by the Frame_Saver_Filter
  *
@@ -19,6 +28,21 @@
 
 #include "wrapped_natives.h"
 #include "frame_saver_params.h"
+#include "frame_encoder_pool.h"
+#include "frame_encoder_placement.h"
+#include "frame_load_ladder.h"
+#include "frame_encoders.h"
+
+
+static const char * The_Pace_Names[] = { "clock", "stream", "frames" };  // by SNAPS_PACE_e
+
+static const char * The_Queue_Policy_Names[] = { "drop-newest", "drop-oldest", "latest" };  // by QUEUE_POLICY_e
+
+static const char * The_Sched_Names[] = { "normal", "nice", "idle" };  // by ENCODER_SCHED_e
+
+static const char * The_Png_Filter_Names[] = { "none", "sub", "up", "avg", "paeth" };  // by bits of PNG_FILTERS_e
+
+static const char * The_Png_Strategy_Names[] = { "auto", "filtered", "huffman", "rle", "fixed" };  // by PNG_STRATEGY_e
 
 
 //=======================================================================================
@@ -445,6 +469,464 @@ gboolean pipeline_params_parse_one(const char * aSpecsPtr, SplicerParams_t * aPa
 }
 
 
+//=======================================================================================
+// synopsis: is_ok = do_parse_png_options(aSpecsPtr, aParamsPtr)
+//
+// parses "LEVEL,FILTERS,STRATEGY,STRIPS" where FILTERS is e.g. "sub+up" --- returns TRUE for success
+//=======================================================================================
+static gboolean do_parse_png_options(const char * aSpecsPtr, SplicerParams_t * aParamsPtr)
+{
+    char  level[8] = "auto", filters[48] = "auto", strategy[16] = "auto", strips[8] = "auto";
+
+    gint  png_level = -1;
+    guint png_filters = 0;
+    int   png_strategy = (int) G_N_ELEMENTS(The_Png_Strategy_Names);
+    guint png_strips = 0;
+
+    char * name_ptr, * next_ptr;
+
+    if (sscanf(aSpecsPtr, "%7[^,],%47[^,],%15[^,],%7s", level, filters, strategy, strips) < 1)
+    {
+        return FALSE;
+    }
+
+    if ( (strcmp(strips, "auto") != 0) &&
+         ((sscanf(strips, "%u", &png_strips) != 1) || (png_strips < 1) || (png_strips > MAX_PNG_STRIPS)) )
+    {
+        return FALSE;
+    }
+
+    if ( (strcmp(level, "auto") != 0) &&
+         ((sscanf(level, "%d", &png_level) != 1) || (png_level < 0) || (png_level > 9)) )
+    {
+        return FALSE;
+    }
+
+    for ( name_ptr = filters;  name_ptr != NULL;  name_ptr = next_ptr )
+    {
+        int bit = (int) G_N_ELEMENTS(The_Png_Filter_Names);
+
+        next_ptr = strchr(name_ptr, '+');
+
+        if (next_ptr != NULL)
+        {
+            *next_ptr++ = 0;
+        }
+
+        while ( (--bit >= 0) && (strcmp(name_ptr, The_Png_Filter_Names[bit]) != 0) )
+        {
+            continue;
+        }
+
+        if (bit >= 0)
+        {
+            png_filters |= (1u << bit);
+        }
+        else if (strcmp(name_ptr, "all") == 0)
+        {
+            png_filters |= e_PNG_FILTER_ALL;
+        }
+        else if (strcmp(name_ptr, "auto") != 0)
+        {
+            return FALSE;
+        }
+    }
+
+    while ( (--png_strategy >= 0) && (strcmp(strategy, The_Png_Strategy_Names[png_strategy]) != 0) )
+    {
+        continue;
+    }
+
+    if (png_strategy < 0)
+    {
+        return FALSE;
+    }
+
+    aParamsPtr->png_level    = png_level;
+    aParamsPtr->png_filters  = png_filters;
+    aParamsPtr->png_strategy = (guint) png_strategy;
+    aParamsPtr->png_strips   = png_strips;
+
+    return TRUE;
+}
+
+
+//=======================================================================================
+// synopsis: is_ok = do_parse_renditions(aSpecsPtr, aParamsPtr)
+//
+// parses "off" or "FMT,Q,COLS,ROWS,LEFT,TOP,COLS,ROWS" joined by '+' where all numbers are
+// optional --- e.g. "jpeg,60,320" --- returns TRUE for success
+//=======================================================================================
+static gboolean do_parse_renditions(const char * aSpecsPtr, SplicerParams_t * aParamsPtr)
+{
+    RenditionParams_t renditions[MAX_EXTRA_RENDITIONS];
+
+    char specs[MAX_RENDITIONS_SPECS_LNG + 1];
+
+    char * spec_ptr, * next_ptr;
+
+    guint num_renditions = 0;
+
+    if (strcmp(aSpecsPtr, "off") == 0)
+    {
+        aParamsPtr->num_renditions = 0;
+        return TRUE;
+    }
+
+    if (snprintf(specs, sizeof(specs), "%s", aSpecsPtr) >= (int) sizeof(specs))
+    {
+        return FALSE;
+    }
+
+    memset(renditions, 0, sizeof(renditions));
+
+    for ( spec_ptr = specs;  spec_ptr != NULL;  spec_ptr = next_ptr )
+    {
+        next_ptr = strchr(spec_ptr, '+');
+
+        if (next_ptr != NULL)
+        {
+            *next_ptr++ = 0;
+        }
+
+        if (num_renditions >= MAX_EXTRA_RENDITIONS)
+        {
+            return FALSE;
+        }
+
+        RenditionParams_t * rendition_ptr = &renditions[num_renditions++];
+
+        int count = sscanf(spec_ptr, "%15[^,],%u,%u,%u,%u,%u,%u,%u", rendition_ptr->image_format,
+                                                                     &rendition_ptr->image_quality,
+                                                                     &rendition_ptr->scale_cols,
+                                                                     &rendition_ptr->scale_rows,
+                                                                     &rendition_ptr->crop_left,
+                                                                     &rendition_ptr->crop_top,
+                                                                     &rendition_ptr->crop_cols,
+                                                                     &rendition_ptr->crop_rows);
+
+        const FrameEncoder_t * encoder_ptr = (count < 1) ? NULL : frame_encoders_find(rendition_ptr->image_format);
+
+        if ( (encoder_ptr == NULL) || (count == 5) || (count == 6) || (count == 7) ||
+             (rendition_ptr->image_quality > 100) ||
+             (rendition_ptr->scale_cols > MAX_SCALED_SIZE) || (rendition_ptr->scale_rows > MAX_SCALED_SIZE) ||
+             (rendition_ptr->crop_left >= MAX_CROPPED_SIZE) || (rendition_ptr->crop_top >= MAX_CROPPED_SIZE) ||
+             (rendition_ptr->crop_cols > MAX_CROPPED_SIZE) || (rendition_ptr->crop_rows > MAX_CROPPED_SIZE) )
+        {
+            return FALSE;
+        }
+
+        strcpy(rendition_ptr->image_format, encoder_ptr->name);
+
+        if (rendition_ptr->image_quality == 0)
+        {
+            rendition_ptr->image_quality = (guint) encoder_ptr->default_quality;
+        }
+    }
+
+    memcpy(aParamsPtr->renditions, renditions, sizeof(renditions));
+
+    aParamsPtr->num_renditions = num_renditions;
+
+    return TRUE;
+}
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_png_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "LEVEL,FILTERS,STRATEGY,STRIPS" as parsed for the "png=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_png_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength)
+{
+    int length = (aParamsPtr->png_level < 0) ? snprintf(aBufferPtr, aMaxLength, "auto,")
+                                             : snprintf(aBufferPtr, aMaxLength, "%d,", aParamsPtr->png_level);
+    int bit;
+
+    if ( (aParamsPtr->png_filters == 0) || (aParamsPtr->png_filters == e_PNG_FILTER_ALL) )
+    {
+        length += snprintf(aBufferPtr + length, MAX(aMaxLength - length, 0), "%s", aParamsPtr->png_filters ? "all" : "auto");
+    }
+
+    for ( bit = 0;  bit < (int) G_N_ELEMENTS(The_Png_Filter_Names);  ++bit )
+    {
+        if ( (aParamsPtr->png_filters & (1u << bit)) && (aParamsPtr->png_filters != e_PNG_FILTER_ALL) )
+        {
+            length += snprintf(aBufferPtr + length, MAX(aMaxLength - length, 0), "%s%s",
+                               (aParamsPtr->png_filters & ((1u << bit) - 1)) ? "+" : "",
+                               The_Png_Filter_Names[bit]);
+        }
+    }
+
+    length += snprintf(aBufferPtr + length, MAX(aMaxLength - length, 0), ",%s",
+                       The_Png_Strategy_Names[aParamsPtr->png_strategy]);
+
+    length += (aParamsPtr->png_strips == 0) ? snprintf(aBufferPtr + length, MAX(aMaxLength - length, 0), ",auto")
+                                            : snprintf(aBufferPtr + length, MAX(aMaxLength - length, 0), ",%u", aParamsPtr->png_strips);
+
+    return length;
+}
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_crop_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "off", "roi" or "LEFT,TOP,COLS,ROWS" as parsed for the "crop=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_crop_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength)
+{
+    if (aParamsPtr->crop_to_roi)
+    {
+        return snprintf(aBufferPtr, aMaxLength, "roi");
+    }
+
+    if ( (aParamsPtr->crop_left == 0) && (aParamsPtr->crop_top  == 0) &&
+         (aParamsPtr->crop_cols == 0) && (aParamsPtr->crop_rows == 0) )
+    {
+        return snprintf(aBufferPtr, aMaxLength, "off");
+    }
+
+    return snprintf(aBufferPtr, aMaxLength, "%u,%u,%u,%u", aParamsPtr->crop_left,
+                                                           aParamsPtr->crop_top,
+                                                           aParamsPtr->crop_cols,
+                                                           aParamsPtr->crop_rows);
+}
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_renditions(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "off" or "FMT,Q,COLS,ROWS[,LEFT,TOP,COLS,ROWS]+..." as parsed for the "rend=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_renditions(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength)
+{
+    int length = (aParamsPtr->num_renditions == 0) ? snprintf(aBufferPtr, aMaxLength, "off") : 0;
+
+    guint index;
+
+    for ( index = 0;  index < aParamsPtr->num_renditions;  ++index )
+    {
+        const RenditionParams_t * rendition_ptr = &aParamsPtr->renditions[index];
+
+        length += snprintf(aBufferPtr + length, MAX(aMaxLength - length, 0), "%s%s,%u,%u,%u",
+                           (index > 0) ? "+" : "",
+                           rendition_ptr->image_format,
+                           rendition_ptr->image_quality,
+                           rendition_ptr->scale_cols,
+                           rendition_ptr->scale_rows);
+
+        if ( (rendition_ptr->crop_left > 0) || (rendition_ptr->crop_top  > 0) ||
+             (rendition_ptr->crop_cols > 0) || (rendition_ptr->crop_rows > 0) )
+        {
+            length += snprintf(aBufferPtr + length, MAX(aMaxLength - length, 0), ",%u,%u,%u,%u",
+                               rendition_ptr->crop_left,
+                               rendition_ptr->crop_top,
+                               rendition_ptr->crop_cols,
+                               rendition_ptr->crop_rows);
+        }
+    }
+
+    return length;
+}
+
+
+//=======================================================================================
+// synopsis: is_ok = do_parse_queue_options(aSpecsPtr, aParamsPtr)
+//
+// parses "DEPTH,POLICY,BUDGET" where BUDGET is megabytes, each may be "auto" --- returns TRUE for success
+//=======================================================================================
+static gboolean do_parse_queue_options(const char * aSpecsPtr, SplicerParams_t * aParamsPtr)
+{
+    char  depth[8] = "auto", policy[16] = "auto", budget[8] = "auto";
+
+    guint queue_depth = DEFAULT_QUEUE_DEPTH, queue_budget_mb = DEFAULT_POOL_BUDGET_MB;
+
+    int   queue_policy = (int) G_N_ELEMENTS(The_Queue_Policy_Names);
+
+    if (sscanf(aSpecsPtr, "%7[^,],%15[^,],%7s", depth, policy, budget) < 1)
+    {
+        return FALSE;
+    }
+
+    if ( (strcmp(depth, "auto") != 0) &&
+         ((sscanf(depth, "%u", &queue_depth) != 1) || (queue_depth > MAX_POOL_PENDING_JOBS)) )
+    {
+        return FALSE;
+    }
+
+    if ( (strcmp(budget, "auto") != 0) &&
+         ((sscanf(budget, "%u", &queue_budget_mb) != 1) || (queue_budget_mb > MAX_POOL_BUDGET_MB)) )
+    {
+        return FALSE;
+    }
+
+    while ( (--queue_policy >= 0) && (strcmp(policy, The_Queue_Policy_Names[queue_policy]) != 0) )
+    {
+        continue;
+    }
+
+    if ( (queue_policy < 0) && (strcmp(policy, "auto") != 0) )
+    {
+        return FALSE;
+    }
+
+    aParamsPtr->queue_depth     = queue_depth;
+    aParamsPtr->queue_policy    = (guint) MAX(queue_policy, e_QUEUE_DROP_NEWEST);
+    aParamsPtr->queue_budget_mb = queue_budget_mb;
+
+    return TRUE;
+}
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_queue_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "DEPTH,POLICY,BUDGET" as parsed for the "queue=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_queue_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength)
+{
+    return snprintf(aBufferPtr, aMaxLength, "%u,%s,%u", aParamsPtr->queue_depth,
+                                                        The_Queue_Policy_Names[aParamsPtr->queue_policy],
+                                                        aParamsPtr->queue_budget_mb);
+}
+
+
+//=======================================================================================
+// synopsis: is_ok = do_parse_load_options(aSpecsPtr, aParamsPtr)
+//
+// parses "off" or "LEVEL,HIGH,LOW" where HIGH and LOW are millis, each may be "auto" --- returns TRUE for success
+//=======================================================================================
+static gboolean do_parse_load_options(const char * aSpecsPtr, SplicerParams_t * aParamsPtr)
+{
+    char  level[16] = "auto", high[8] = "auto", low[8] = "auto";
+
+    guint high_ms = 0, low_ms = 0;
+
+    int   load_level = (int) e_LOAD_NUM_LEVELS;
+
+    if (sscanf(aSpecsPtr, "%15[^,],%7[^,],%7s", level, high, low) < 1)
+    {
+        return FALSE;
+    }
+
+    if ( (strcmp(high, "auto") != 0) && (sscanf(high, "%u", &high_ms) != 1) )
+    {
+        return FALSE;
+    }
+
+    if ( (strcmp(low, "auto") != 0) && (sscanf(low, "%u", &low_ms) != 1) )
+    {
+        return FALSE;
+    }
+
+    // possibly --- the thresholds are reversed --- no level would be calm
+    if ( (high_ms > 0) && (low_ms >= high_ms) )
+    {
+        return FALSE;
+    }
+
+    while ( (--load_level >= 0) && (strcmp(level, frame_load_ladder_get_name((LOAD_LEVEL_e) load_level)) != 0) )
+    {
+        continue;
+    }
+
+    // auto --- all the levels
+    if ( (load_level < 0) && (strcmp(level, "auto") != 0) )
+    {
+        return FALSE;
+    }
+
+    aParamsPtr->load_level   = (load_level < 0) ? e_LOAD_SHED : (guint) load_level;
+    aParamsPtr->load_high_ms = high_ms;
+    aParamsPtr->load_low_ms  = low_ms;
+
+    return TRUE;
+}
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_load_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "off" or "LEVEL,HIGH,LOW" as parsed for the "load=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_load_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength)
+{
+    if (aParamsPtr->load_level == e_LOAD_NORMAL)
+    {
+        return snprintf(aBufferPtr, aMaxLength, "off");
+    }
+
+    return snprintf(aBufferPtr, aMaxLength, "%s,%u,%u", frame_load_ladder_get_name((LOAD_LEVEL_e) aParamsPtr->load_level),
+                                                        aParamsPtr->load_high_ms,
+                                                        aParamsPtr->load_low_ms);
+}
+
+
+//=======================================================================================
+// synopsis: is_ok = do_parse_sched_options(aSpecsPtr, aParamsPtr)
+//
+// parses "normal", "idle" or "nice,N" where N is 1..19 (default 10) --- returns TRUE for success
+//=======================================================================================
+static gboolean do_parse_sched_options(const char * aSpecsPtr, SplicerParams_t * aParamsPtr)
+{
+    char  sched[16] = "";
+    guint nice = DEFAULT_ENCODER_NICE;
+    char  trailer;
+
+    int   num_fields = sscanf(aSpecsPtr, "%15[^,],%u%c", sched, &nice, &trailer);
+
+    int   sched_index = (int) G_N_ELEMENTS(The_Sched_Names);
+
+    if ( (num_fields < 1) || (num_fields > 2) )
+    {
+        return FALSE;
+    }
+
+    while ( (--sched_index >= 0) && (strcmp(sched, The_Sched_Names[sched_index]) != 0) )
+    {
+        continue;
+    }
+
+    // auto --- the process's scheduling
+    if (strcmp(sched, "auto") == 0)
+    {
+        sched_index = (int) e_SCHED_NORMAL;
+    }
+
+    // only the nice scheduling takes a number
+    if ( (sched_index < 0) || ((num_fields == 2) && (sched_index != (int) e_SCHED_NICE)) )
+    {
+        return FALSE;
+    }
+
+    if ( (nice < 1) || (nice > MAX_ENCODER_NICE) )
+    {
+        return FALSE;
+    }
+
+    aParamsPtr->encoder_sched = (guint) sched_index;
+    aParamsPtr->encoder_nice  = nice;
+
+    return TRUE;
+}
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_sched_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "normal", "idle" or "nice,N" as parsed for the "sched=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_sched_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength)
+{
+    if (aParamsPtr->encoder_sched != e_SCHED_NICE)
+    {
+        return snprintf(aBufferPtr, aMaxLength, "%s", The_Sched_Names[aParamsPtr->encoder_sched]);
+    }
+
+    return snprintf(aBufferPtr, aMaxLength, "%s,%u", The_Sched_Names[aParamsPtr->encoder_sched], aParamsPtr->encoder_nice);
+}
+
+
 //=======================================================================================
 // synopsis: length = frame_saver_params_write_to_buffer(aParamsPtr, aBufferPtr, aMaxLength)
 //
@@ -452,7 +934,31 @@ gboolean pipeline_params_parse_one(const char * aSpecsPtr, SplicerParams_t * aPa
 //=======================================================================================
 gint frame_saver_params_write_to_buffer(SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength)
 {
-    #define FMT ("%s %s=%u %s=(%u,%u,%u) %s=%u %s=%u %s=(%s) %s=(%s) %s=(%s,%s,%s) %s=(%s,%s,%s) \n\n")
+    #define FMT ("%s %s=%u %s=(%u,%u,%u) %s=%u %s=%u %s=%u %s=(%s) %s=%u %s=(%s) %s=(%s) %s=(%s) %s=%s %s=(%s,%u) %s=(%s) %s=(%u,%u) %s=(%s) %s=(%s) %s=(%s) %s=(%s) %s=(%s,%s,%s) %s=(%s,%s,%s) \n\n")
+
+    char png_options[80];
+
+    frame_saver_params_write_png_options(aParamsPtr, png_options, sizeof(png_options));
+
+    char crop_options[60];
+
+    frame_saver_params_write_crop_options(aParamsPtr, crop_options, sizeof(crop_options));
+
+    char renditions[MAX_RENDITIONS_SPECS_LNG + 1];
+
+    frame_saver_params_write_renditions(aParamsPtr, renditions, sizeof(renditions));
+
+    char queue_options[60];
+
+    frame_saver_params_write_queue_options(aParamsPtr, queue_options, sizeof(queue_options));
+
+    char load_options[40];
+
+    frame_saver_params_write_load_options(aParamsPtr, load_options, sizeof(load_options));
+
+    char sched_options[20];
+
+    frame_saver_params_write_sched_options(aParamsPtr, sched_options, sizeof(sched_options));
 
     char * bangs_ptr = strchr(aParamsPtr->pipeline_spec, '!');
 
@@ -517,6 +1023,20 @@ gint frame_saver_params_write_to_buffer(SplicerParams_t * aParamsPtr, char * aBu
                                                aParamsPtr->max_num_failed_snap,
                            "\n          wait", aParamsPtr->max_wait_ms,
                            "\n          play", aParamsPtr->max_play_ms,
+                           "\n          pool", aParamsPtr->num_pool_workers,
+                           "\n          queue", queue_options,
+                           "\n          prio", aParamsPtr->queue_weight,
+                           "\n          load", load_options,
+                           "\n          cpus", aParamsPtr->encoder_cpus,
+                           "\n          sched", sched_options,
+                           "\n          pace", The_Pace_Names[aParamsPtr->snaps_pace],
+                           "\n          fmt",  aParamsPtr->image_format,
+                                               aParamsPtr->image_quality,
+                           "\n          png",  png_options,
+                           "\n          scale", aParamsPtr->scale_cols,
+                                               aParamsPtr->scale_rows,
+                           "\n          crop", crop_options,
+                           "\n          rend", renditions,
                            "\n          path", aParamsPtr->folder_path,
                            "\n          pipe", psz_pipeline_type,
                            "\n          link", aParamsPtr->pipeline_name,
@@ -588,6 +1108,26 @@ gboolean frame_saver_params_initialize(SplicerParams_t * aParamsPtr)
     aParamsPtr->max_wait_ms = 3000;
     aParamsPtr->max_play_ms = 9000;
 
+    aParamsPtr->num_pool_workers = DEFAULT_POOL_WORKERS;
+
+    aParamsPtr->queue_depth     = DEFAULT_QUEUE_DEPTH;
+    aParamsPtr->queue_policy    = e_QUEUE_DROP_NEWEST;
+    aParamsPtr->queue_budget_mb = DEFAULT_POOL_BUDGET_MB;
+    aParamsPtr->queue_weight    = DEFAULT_QUEUE_WEIGHT;
+
+    aParamsPtr->load_level   = e_LOAD_NORMAL;
+    aParamsPtr->load_high_ms = 0;
+    aParamsPtr->load_low_ms  = 0;
+
+    strcpy(aParamsPtr->encoder_cpus, "all");
+
+    aParamsPtr->encoder_sched = e_SCHED_NORMAL;
+    aParamsPtr->encoder_nice  = DEFAULT_ENCODER_NICE;
+
+    strcpy(aParamsPtr->image_format, frame_encoders_find(NULL)->name);
+
+    aParamsPtr->png_level = -1;
+
     return (GET_CWD(aParamsPtr->folder_path, sizeof(aParamsPtr->folder_path)) != NULL);
 }
 
@@ -645,6 +1185,164 @@ gboolean frame_saver_params_parse_from_array(SplicerParams_t * aParamsPtr, char
             continue;
         }
 
+        if ( strncmp(psz_param, "pool=", 5) == 0 )
+        {
+            if (strncmp(&psz_param[5], "auto", 4) == 0)
+            {
+                aParamsPtr->num_pool_workers = DEFAULT_POOL_WORKERS;
+            }
+            else
+            {
+                is_ok = (sscanf(&psz_param[5], "%u", &aParamsPtr->num_pool_workers) == 1) &&
+                        (aParamsPtr->num_pool_workers <= MAX_POOL_WORKERS);
+            }
+            continue;
+        }
+
+        if ( strncmp(psz_param, "queue=", 6) == 0 )
+        {
+            is_ok = do_parse_queue_options(&psz_param[6], aParamsPtr);
+            continue;
+        }
+
+        if ( strncmp(psz_param, "load=", 5) == 0 )
+        {
+            is_ok = do_parse_load_options(&psz_param[5], aParamsPtr);
+            continue;
+        }
+
+        if ( strncmp(psz_param, "cpus=", 5) == 0 )
+        {
+            const char * cpus_ptr = (strcmp(&psz_param[5], "auto") == 0) ? "all" : &psz_param[5];
+
+            is_ok = (frame_encoder_placement_count_cpus(cpus_ptr) >= 0);
+
+            if (is_ok)
+            {
+                snprintf(aParamsPtr->encoder_cpus, sizeof(aParamsPtr->encoder_cpus), "%s", cpus_ptr);
+            }
+            continue;
+        }
+
+        if ( strncmp(psz_param, "sched=", 6) == 0 )
+        {
+            is_ok = do_parse_sched_options(&psz_param[6], aParamsPtr);
+            continue;
+        }
+
+        if ( strncmp(psz_param, "prio=", 5) == 0 )
+        {
+            if (strncmp(&psz_param[5], "auto", 4) == 0)
+            {
+                aParamsPtr->queue_weight = DEFAULT_QUEUE_WEIGHT;
+            }
+            else
+            {
+                is_ok = (sscanf(&psz_param[5], "%u", &aParamsPtr->queue_weight) == 1) &&
+                        (aParamsPtr->queue_weight >= 1) && (aParamsPtr->queue_weight <= MAX_QUEUE_WEIGHT);
+            }
+            continue;
+        }
+
+        if ( strncmp(psz_param, "pace=", 5) == 0 )
+        {
+            int pace = (int) G_N_ELEMENTS(The_Pace_Names);
+
+            while ( (--pace >= 0) && (strcmp(&psz_param[5], The_Pace_Names[pace]) != 0) )
+            {
+                continue;
+            }
+
+            is_ok = (pace >= 0);
+
+            aParamsPtr->snaps_pace = is_ok ? (SNAPS_PACE_e) pace : aParamsPtr->snaps_pace;
+
+            continue;
+        }
+
+        if ( strncmp(psz_param, "fmt=", 4) == 0 )
+        {
+            char  name[MAX_FORMAT_NAME_LNG + 1];
+            guint quality = 0;
+
+            int count = sscanf(&psz_param[4], "%15[^,],%u", name, &quality);
+
+            const FrameEncoder_t * encoder_ptr = (count < 1) ? NULL : frame_encoders_find(name);
+
+            is_ok = (encoder_ptr != NULL) && (quality <= 100);
+
+            if (is_ok)
+            {
+                strcpy(aParamsPtr->image_format, encoder_ptr->name);
+
+                aParamsPtr->image_quality = (quality > 0) ? quality : (guint) encoder_ptr->default_quality;
+            }
+
+            continue;
+        }
+
+        if ( strncmp(psz_param, "png=", 4) == 0 )
+        {
+            is_ok = do_parse_png_options(&psz_param[4], aParamsPtr);
+            continue;
+        }
+
+        if ( strncmp(psz_param, "scale=", 6) == 0 )
+        {
+            guint max_cols = 0, max_rows = 0;
+
+            // "scale=W,H" where 0 is unbounded, "scale=N" fits in N x N, "scale=off" saves full frames
+            if (strcmp(&psz_param[6], "off") != 0)
+            {
+                int count = sscanf(&psz_param[6], "%u,%u", &max_cols, &max_rows);
+
+                max_rows = (count == 1) ? max_cols : max_rows;
+
+                is_ok = (count >= 1) && (max_cols <= MAX_SCALED_SIZE) && (max_rows <= MAX_SCALED_SIZE);
+            }
+
+            if (is_ok)
+            {
+                aParamsPtr->scale_cols = max_cols;
+                aParamsPtr->scale_rows = max_rows;
+            }
+
+            continue;
+        }
+
+        if ( strncmp(psz_param, "crop=", 5) == 0 )
+        {
+            guint left = 0, top = 0, cols = 0, rows = 0;
+
+            // "crop=X,Y,W,H" where 0 size reaches the frame's edge, "crop=roi" follows the
+            // region-of-interest meta of each frame, "crop=off" saves whole frames
+            gboolean to_roi = (strcmp(&psz_param[5], "roi") == 0);
+
+            if ( (! to_roi) && (strcmp(&psz_param[5], "off") != 0) )
+            {
+                is_ok = (sscanf(&psz_param[5], "%u,%u,%u,%u", &left, &top, &cols, &rows) == 4) &&
+                        (left < MAX_CROPPED_SIZE) && (top  < MAX_CROPPED_SIZE) &&
+                        (cols <= MAX_CROPPED_SIZE) && (rows <= MAX_CROPPED_SIZE);
+            }
+
+            if (is_ok)
+            {
+                aParamsPtr->crop_left   = left;
+                aParamsPtr->crop_top    = top;
+                aParamsPtr->crop_cols   = cols;
+                aParamsPtr->crop_rows   = rows;
+                aParamsPtr->crop_to_roi = to_roi;
+            }
+
+            continue;
+        }
+
+        if ( strncmp(psz_param, "rend=", 5) == 0 )
+        {
+            is_ok = do_parse_renditions(&psz_param[5], aParamsPtr);
+            continue;
+        }
+
         if ( strncmp(psz_param, "path=", 5) == 0 )
         {
             int lng = snprintf(aParamsPtr->folder_path, sizeof(aParamsPtr->folder_path), "%s", &psz_param[5]);
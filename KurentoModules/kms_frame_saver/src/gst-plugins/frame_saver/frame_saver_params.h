@@ -11,6 +11,15 @@
  *              5. 2016-11-24   JBendor     Support dynamic params update
  *              6. 2016-12-08   JBendor     Support the actual Gstreamer plugin
  *              7. 2016-12-20   JBendor     Updated
+ *              8. 2026-10-17               Added "png=" deflate options
+ *              9. 2026-10-17               Added strips to "png=" options
+ *             10. 2026-10-17               Added "scale=" for scaled-down images
+ *             11. 2026-10-17               Added "crop=" for a region of the frames
+ *             12. 2026-10-17               Added "rend=" for more images of each snap
+ *             13. 2026-10-17               Added "queue=" for overload policies
+ *             14. 2026-10-17               Added "prio=" for a share of the encoder pool
+ *             15. 2026-10-17               Added "load=" for the overload ladder
+ *             16. 2026-10-17               Added "cpus=" and "sched=" for the encoder threads
  *
  * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
  *               Unauthorized copying of this file is strictly prohibited.
@@ -37,6 +46,12 @@
 #define  MAX_PIPELINE_CFG_LNG           (900)
 #define  MAX_PARAMS_SPECS_LNG           (4000)
 #define  MAX_PARAMS_ARRAY_LNG           (20)
+#define  MAX_FORMAT_NAME_LNG            (15)
+#define  MAX_SCALED_SIZE                (16384)
+#define  MAX_CROPPED_SIZE               (32768)
+#define  MAX_EXTRA_RENDITIONS           (3)
+#define  MAX_RENDITIONS_SPECS_LNG       (200)
+#define  MAX_CPUS_SPECS_LNG             (200)
 
 #define DEFAULT_VID_SRC_NAME            ("videotestsrc0")
 #define DEFAULT_VID_CVT_NAME            ("videoconvert0")
@@ -46,6 +61,31 @@
 //=======================================================================================
 // custom types
 //=======================================================================================
+typedef enum
+{
+    e_PACE_BY_CLOCK = 0,            // snaps every 'snap' milliseconds of system clock
+    e_PACE_BY_STREAM,               // snaps every 'snap' milliseconds of running-time
+    e_PACE_BY_FRAMES                // snaps every 'snap' stream frames
+
+} SNAPS_PACE_e;
+
+
+typedef struct
+{
+    gchar   image_format[MAX_FORMAT_NAME_LNG + 1];  // name of the image encoder
+    guint   image_quality;          // quality of lossy encoders, 1..100
+
+    guint   scale_cols,             // scaled down to fit --- 0=unbounded
+            scale_rows;
+
+    guint   crop_left,              // cropped to this rectangle first
+            crop_top,
+            crop_cols,              // 0=up to the frame's edge
+            crop_rows;
+
+} RenditionParams_t;
+
+
 typedef struct
 {
     guint   one_tick_ms,            // timer-ticks interval as milliseconds
@@ -56,6 +96,43 @@ typedef struct
     guint   max_num_snaps_saved,    // maximum number of saves --- 0=unlimited
             max_num_failed_snap;    // maximum number of fails --- 0=unlimited
 
+    guint   num_pool_workers;       // shared encoder threads --- 0=encode on caller
+
+    guint   queue_depth;            // pending frames of each rendition --- 0=bounded by the pool
+    guint   queue_policy;           // QUEUE_POLICY_e --- what a full queue drops
+    guint   queue_budget_mb;        // megabytes of pending frames of all instances --- 0=unbounded
+    guint   queue_weight;           // share of the pool's workers, 1..16 --- relative to other instances
+
+    guint   load_level;             // LOAD_LEVEL_e --- deepest degradation under overload, 0=off
+    guint   load_high_ms,           // encode latency which degrades the snaps --- 0=auto
+            load_low_ms;            // encode latency which restores them --- 0=auto
+
+    gchar   encoder_cpus[MAX_CPUS_SPECS_LNG + 1];   // CPUs of the encoder threads --- "all", "nodeN" or a list
+    guint   encoder_sched;          // ENCODER_SCHED_e --- scheduling of the encoder threads
+    guint   encoder_nice;           // nice value of the "nice" scheduling, 1..19
+
+    SNAPS_PACE_e snaps_pace;        // what paces the frame snaps --- default is clock
+
+    gchar   image_format[MAX_FORMAT_NAME_LNG + 1];  // name of the image encoder --- default is png
+    guint   image_quality;          // quality of lossy encoders, 1..100 --- 0=encoder's default
+
+    gint    png_level;              // deflate level 0..9 --- -1=library's default
+    guint   png_filters;            // bits of PNG_FILTERS_e --- 0=library's default
+    guint   png_strategy;           // PNG_STRATEGY_e --- 0=library's default
+    guint   png_strips;             // strips deflated in parallel --- 0=serial
+
+    guint   scale_cols,             // saved images are scaled down to fit --- 0=unbounded
+            scale_rows;
+
+    guint   crop_left,              // saved images are cropped to this rectangle first
+            crop_top,
+            crop_cols,              // 0=up to the frame's edge
+            crop_rows;
+    gboolean crop_to_roi;           // crops to the frame's region-of-interest meta, if any
+
+    RenditionParams_t renditions[MAX_EXTRA_RENDITIONS];     // more images of each snap
+    guint   num_renditions;         // count of the extra renditions --- 0=one image per snap
+
     gchar   folder_path[PATH_MAX + 1];
 
     gchar   producer_name[MAX_ELEMENT_NAME_LNG + 1];
@@ -96,6 +173,54 @@ gint pipeline_params_parse_caps(const char * aCapsPtr,
 gboolean pipeline_params_parse_one(const char * aSpecsPtr, SplicerParams_t * aParamsPtr);
 
 
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_png_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "LEVEL,FILTERS,STRATEGY,STRIPS" as parsed for the "png=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_png_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength);
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_crop_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "off", "roi" or "LEFT,TOP,COLS,ROWS" as parsed for the "crop=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_crop_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength);
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_renditions(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "off" or "FMT,Q,COLS,ROWS[,LEFT,TOP,COLS,ROWS]+..." as parsed for the "rend=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_renditions(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength);
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_queue_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "DEPTH,POLICY,BUDGET" as parsed for the "queue=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_queue_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength);
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_load_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "off" or "LEVEL,HIGH,LOW" as parsed for the "load=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_load_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength);
+
+
+//=======================================================================================
+// synopsis: length = frame_saver_params_write_sched_options(aParamsPtr, aBufferPtr, aMaxLength)
+//
+// writes "normal", "idle" or "nice,N" as parsed for the "sched=" parameter --- returns length
+//=======================================================================================
+gint frame_saver_params_write_sched_options(const SplicerParams_t * aParamsPtr, char * aBufferPtr, gint aMaxLength);
+
+
 //=======================================================================================
 // synopsis: length = frame_saver_params_write_to_buffer(aParamsPtr, aBufferPtr, aMaxLength)
 //
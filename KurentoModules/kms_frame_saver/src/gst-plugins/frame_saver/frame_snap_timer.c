@@ -0,0 +1,286 @@
+/*
+ * ======================================================================================
+ * File:        frame_snap_timer.c
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Description: One GSource, shared by all frame-saver instances, which wakes up the
+ *              default main context only when the earliest deadline is due. Active
+ *              timers are kept in a GSequence sorted by their due time, and the
+ *              source's ready-time always follows the head of that sequence, hence
+ *              the main loop sleeps between snaps however many filters are alive.
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#include "frame_snap_timer.h"
+
+
+static GMutex       The_Timers_Mutex;           // static GMutex needs no initialization
+
+static GCond        The_Timers_Cond;            // signaled when a timer's call ends
+
+static GSequence  * The_Timers_Sequence = NULL; // active timers sorted by due time
+
+static GSource    * The_Timers_Source = NULL;   // wakes up at the earliest due time
+
+static GThread    * The_Dispatch_Thread = NULL; // thread calling timers --- else NULL
+
+
+//=======================================================================================
+// synopsis: order = do_compare_due_times(aOnePtr, aTwoPtr, aUnusedPtr)
+//
+// orders timers by due time --- ties are ordered by address
+//=======================================================================================
+static gint do_compare_due_times(gconstpointer aOnePtr, gconstpointer aTwoPtr, gpointer aUnusedPtr)
+{
+    const FrameSnapTimer_t * one_ptr = (const FrameSnapTimer_t *) aOnePtr;
+    const FrameSnapTimer_t * two_ptr = (const FrameSnapTimer_t *) aTwoPtr;
+
+    if (one_ptr->due_time_us != two_ptr->due_time_us)
+    {
+        return (one_ptr->due_time_us < two_ptr->due_time_us) ? -1 : 1;
+    }
+
+    return (one_ptr < two_ptr) ? -1 : (one_ptr > two_ptr);
+}
+
+
+//=======================================================================================
+// synopsis: do_update_ready_time()
+//
+// called with the mutex held --- arms the shared source for the earliest due time
+//=======================================================================================
+static void do_update_ready_time()
+{
+    GSequenceIter * head_iter = g_sequence_get_begin_iter(The_Timers_Sequence);
+
+    if ( g_sequence_iter_is_end(head_iter) )
+    {
+        g_source_set_ready_time(The_Timers_Source, -1);     // nothing to do --- sleep
+    }
+    else
+    {
+        FrameSnapTimer_t * head_ptr = (FrameSnapTimer_t *) g_sequence_get(head_iter);
+
+        g_source_set_ready_time(The_Timers_Source, head_ptr->due_time_us);
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_insert_timer(aTimerPtr, aDueTimeMicros)
+//
+// called with the mutex held --- (re)inserts a timer into the sorted sequence
+//=======================================================================================
+static void do_insert_timer(FrameSnapTimer_t * aTimerPtr, gint64 aDueTimeMicros)
+{
+    if (aTimerPtr->sequence_iter != NULL)
+    {
+        g_sequence_remove( (GSequenceIter *) aTimerPtr->sequence_iter );
+    }
+
+    aTimerPtr->due_time_us = aDueTimeMicros;
+
+    aTimerPtr->sequence_iter = g_sequence_insert_sorted(The_Timers_Sequence,
+                                                        aTimerPtr,
+                                                        do_compare_due_times,
+                                                        NULL);
+}
+
+
+//=======================================================================================
+// synopsis: is_ok = do_dispatch_due_timers(aSourcePtr, aUnusedFunc, aUnusedPtr)
+//
+// calls every timer which is due --- returns TRUE always
+//=======================================================================================
+static gboolean do_dispatch_due_timers(GSource * aSourcePtr, GSourceFunc aUnusedFunc, gpointer aUnusedPtr)
+{
+    g_mutex_lock(&The_Timers_Mutex);
+
+    The_Dispatch_Thread = g_thread_self();
+
+    for ( ; ; )
+    {
+        GSequenceIter * head_iter = g_sequence_get_begin_iter(The_Timers_Sequence);
+
+        gint64          now_micros = g_get_monotonic_time();
+
+        if ( g_sequence_iter_is_end(head_iter) )
+        {
+            break;
+        }
+
+        FrameSnapTimer_t * timer_ptr = (FrameSnapTimer_t *) g_sequence_get(head_iter);
+
+        if (timer_ptr->due_time_us > now_micros)
+        {
+            break;
+        }
+
+        gint64 late_micros = now_micros - timer_ptr->due_time_us;
+
+        g_sequence_remove(head_iter);
+
+        timer_ptr->sequence_iter = NULL;
+        timer_ptr->is_running    = TRUE;
+        timer_ptr->num_calls    += 1;
+        timer_ptr->sum_late_us  += late_micros;
+        timer_ptr->max_late_us   = MAX(timer_ptr->max_late_us, late_micros);
+
+        g_mutex_unlock(&The_Timers_Mutex);
+
+        gint64 delay_micros = timer_ptr->func_ptr(timer_ptr->context_ptr);
+
+        g_mutex_lock(&The_Timers_Mutex);
+
+        timer_ptr->is_running = FALSE;
+
+        if ( timer_ptr->is_active && (delay_micros >= 0) )
+        {
+            gint64 due_micros = g_get_monotonic_time() + delay_micros;
+
+            // possibly --- an earlier call was scheduled while this call was running
+            if ( (timer_ptr->sequence_iter == NULL) || (due_micros < timer_ptr->due_time_us) )
+            {
+                do_insert_timer(timer_ptr, due_micros);
+            }
+        }
+        else if (timer_ptr->sequence_iter != NULL)
+        {
+            g_sequence_remove( (GSequenceIter *) timer_ptr->sequence_iter );
+
+            timer_ptr->sequence_iter = NULL;
+        }
+
+        g_cond_broadcast(&The_Timers_Cond);
+    }
+
+    The_Dispatch_Thread = NULL;
+
+    do_update_ready_time();
+
+    g_mutex_unlock(&The_Timers_Mutex);
+
+    return G_SOURCE_CONTINUE;
+}
+
+
+static GSourceFuncs The_Timers_Source_Funcs = { NULL, NULL, do_dispatch_due_timers, NULL, NULL, NULL };
+
+
+//=======================================================================================
+// synopsis: frame_snap_timer_start(aTimerPtr, aFuncPtr, aContextPtr, aDelayMicros)
+//
+// activates a timer on the shared source of the default main context
+//=======================================================================================
+void frame_snap_timer_start(FrameSnapTimer_t     * aTimerPtr,
+                            FrameSnapTimerFunc_t   aFuncPtr,
+                            gpointer               aContextPtr,
+                            gint64                 aDelayMicros)
+{
+    g_mutex_lock(&The_Timers_Mutex);
+
+    // once only --- the shared source lives as long as the process
+    if (The_Timers_Source == NULL)
+    {
+        The_Timers_Sequence = g_sequence_new(NULL);
+
+        The_Timers_Source = g_source_new(&The_Timers_Source_Funcs, sizeof(GSource));
+
+        g_source_set_name(The_Timers_Source, "FrameSaverSnapTimers");
+
+        g_source_set_ready_time(The_Timers_Source, -1);
+
+        g_source_attach(The_Timers_Source, NULL);
+    }
+
+    if (! aTimerPtr->is_active)
+    {
+        aTimerPtr->func_ptr      = aFuncPtr;
+        aTimerPtr->context_ptr   = aContextPtr;
+        aTimerPtr->sequence_iter = NULL;
+        aTimerPtr->is_running    = FALSE;
+        aTimerPtr->is_active     = TRUE;
+    }
+
+    do_insert_timer(aTimerPtr, g_get_monotonic_time() + MAX(aDelayMicros, 0));
+
+    do_update_ready_time();
+
+    g_mutex_unlock(&The_Timers_Mutex);
+}
+
+
+//=======================================================================================
+// synopsis: frame_snap_timer_schedule(aTimerPtr, aDelayMicros)
+//
+// moves the next call of an active timer --- earlier only, unless it is not scheduled
+//=======================================================================================
+void frame_snap_timer_schedule(FrameSnapTimer_t * aTimerPtr, gint64 aDelayMicros)
+{
+    g_mutex_lock(&The_Timers_Mutex);
+
+    gint64 due_micros = g_get_monotonic_time() + MAX(aDelayMicros, 0);
+
+    if ( aTimerPtr->is_active &&
+         ((aTimerPtr->sequence_iter == NULL) || (due_micros < aTimerPtr->due_time_us)) )
+    {
+        do_insert_timer(aTimerPtr, due_micros);
+
+        do_update_ready_time();
+    }
+
+    g_mutex_unlock(&The_Timers_Mutex);
+}
+
+
+//=======================================================================================
+// synopsis: frame_snap_timer_stop(aTimerPtr)
+//
+// deactivates a timer --- waits for a call in progress on another thread
+//=======================================================================================
+void frame_snap_timer_stop(FrameSnapTimer_t * aTimerPtr)
+{
+    g_mutex_lock(&The_Timers_Mutex);
+
+    aTimerPtr->is_active = FALSE;
+
+    if (aTimerPtr->sequence_iter != NULL)
+    {
+        g_sequence_remove( (GSequenceIter *) aTimerPtr->sequence_iter );
+
+        aTimerPtr->sequence_iter = NULL;
+
+        do_update_ready_time();
+    }
+
+    while ( aTimerPtr->is_running && (The_Dispatch_Thread != g_thread_self()) )
+    {
+        g_cond_wait(&The_Timers_Cond, &The_Timers_Mutex);
+    }
+
+    g_mutex_unlock(&The_Timers_Mutex);
+}
+
+
+//=======================================================================================
+// synopsis: frame_snap_timer_get_lateness(aTimerPtr, aMeanPtr, aMaxPtr)
+//
+// reports the scheduling jitter as microseconds --- returns number of calls
+//=======================================================================================
+guint frame_snap_timer_get_lateness(FrameSnapTimer_t * aTimerPtr, gint64 * aMeanPtr, gint64 * aMaxPtr)
+{
+    g_mutex_lock(&The_Timers_Mutex);
+
+    guint num_calls = aTimerPtr->num_calls;
+
+    *aMeanPtr = (num_calls > 0) ? (aTimerPtr->sum_late_us / num_calls) : 0;
+    *aMaxPtr  = aTimerPtr->max_late_us;
+
+    g_mutex_unlock(&The_Timers_Mutex);
+
+    return num_calls;
+}
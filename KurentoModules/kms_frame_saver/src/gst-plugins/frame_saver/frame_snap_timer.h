@@ -0,0 +1,92 @@
+/*
+ * ======================================================================================
+ * File:        frame_snap_timer.h
+ *
+ * Purpose:     external interface (API) for code in "frame_snap_timer.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Frame_Snap_Timer_H__
+
+#define __Frame_Snap_Timer_H__
+
+#include <glib.h>
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+
+// returns microseconds until the next call --- negative stops the timer
+typedef gint64 (*FrameSnapTimerFunc_t)(gpointer aContextPtr);
+
+
+typedef struct _FrameSnapTimer_t
+{
+    FrameSnapTimerFunc_t    func_ptr;
+    gpointer                context_ptr;
+
+    gint64                  due_time_us;        // monotonic time of the next call
+    gpointer                sequence_iter;      // NULL when not scheduled
+
+    gboolean                is_active,          // TRUE from start until stop
+                            is_running;         // TRUE while func_ptr is called
+
+    guint                   num_calls;          // count of calls of func_ptr
+    gint64                  sum_late_us,        // total of lateness of all calls
+                            max_late_us;        // maximum lateness of one call
+
+} FrameSnapTimer_t;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+//=======================================================================================
+// synopsis: frame_snap_timer_start(aTimerPtr, aFuncPtr, aContextPtr, aDelayMicros)
+//
+// activates a timer on the shared source of the default main context
+//=======================================================================================
+void frame_snap_timer_start(FrameSnapTimer_t     * aTimerPtr,
+                            FrameSnapTimerFunc_t   aFuncPtr,
+                            gpointer               aContextPtr,
+                            gint64                 aDelayMicros);
+
+
+//=======================================================================================
+// synopsis: frame_snap_timer_schedule(aTimerPtr, aDelayMicros)
+//
+// moves the next call of an active timer --- earlier only, unless it is not scheduled
+//=======================================================================================
+void frame_snap_timer_schedule(FrameSnapTimer_t * aTimerPtr, gint64 aDelayMicros);
+
+
+//=======================================================================================
+// synopsis: frame_snap_timer_stop(aTimerPtr)
+//
+// deactivates a timer --- waits for a call in progress on another thread
+//=======================================================================================
+void frame_snap_timer_stop(FrameSnapTimer_t * aTimerPtr);
+
+
+//=======================================================================================
+// synopsis: frame_snap_timer_get_lateness(aTimerPtr, aMeanPtr, aMaxPtr)
+//
+// reports the scheduling jitter as microseconds --- returns number of calls
+//=======================================================================================
+guint frame_snap_timer_get_lateness(FrameSnapTimer_t * aTimerPtr, gint64 * aMeanPtr, gint64 * aMaxPtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Frame_Snap_Timer_H__
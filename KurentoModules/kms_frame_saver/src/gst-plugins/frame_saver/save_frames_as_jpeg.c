@@ -0,0 +1,358 @@
+/*
+* ======================================================================================
+* File:        save_frames_as_jpeg.c
+*
+* Purpose:     saves image frames as JPEG files
+*
+* History:     1. 2026-10-17               Created
+*              2. 2026-10-17               GRAY frames in raw-data mode too
+*
+* Description: YUV frames are passed to the JPEG encoder in raw-data mode --- the Y,U,V
+*              rows are handed over without any color conversion or resampling, and rows
+*              are only copied when samples are interleaved or rows are too short for the
+*              DCT blocks. GRAY frames (e.g. the Y plane alone, see "fmt=gray-jpeg") are
+*              passed in raw-data mode as one component. RGB frames are converted row by row.
+*
+* Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+*               Unauthorized copying of this file is strictly prohibited.
+* ======================================================================================
+*/
+
+#include "save_frames_as_jpeg.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+#ifndef _NOT_USING_JPEG_LIBRARY_
+    #include <jpeglib.h>
+#endif
+
+
+#ifndef MIN
+    #define MIN(A,B)    ( ((A) < (B)) ? (A) : (B) )
+#endif
+
+#ifndef MAX
+    #define MAX(A,B)    ( ((A) > (B)) ? (A) : (B) )
+#endif
+
+#define PAD_TO_DCT_BLOCKS(N)    ( ((N) + 7) & ~7 )
+
+
+#ifndef _NOT_USING_JPEG_LIBRARY_
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef struct
+{
+    struct jpeg_error_mgr   manager;
+    jmp_buf                 jump_buffer;
+
+} JpegErrorHandler_t;
+
+
+//=======================================================================================
+// synopsis: do_exit_on_jpeg_error(aInfoPtr)
+//
+// replaces the default handler which terminates the process --- jumps back to the caller
+//=======================================================================================
+static void do_exit_on_jpeg_error(j_common_ptr aInfoPtr)
+{
+    JpegErrorHandler_t * handler_ptr = (JpegErrorHandler_t *) aInfoPtr->err;
+
+    longjmp(handler_ptr->jump_buffer, 1);
+}
+
+
+//=======================================================================================
+// synopsis: row_ptr = do_get_samples_row(aFramePtr, aComp, aRow, aNumSamples, aScratchPtr)
+//
+// returns the row of a component --- a padded copy if interleaved or shorter than DCT blocks
+//=======================================================================================
+static JSAMPROW do_get_samples_row(const PixelsFrame_t * aFramePtr,
+                                   int                   aComp,
+                                   int                   aRow,
+                                   int                   aNumSamples,
+                                   uint8_t             * aScratchPtr)
+{
+    const uint8_t * row_ptr = aFramePtr->comps_array[aComp] + (aRow * aFramePtr->strides_array[aComp]);
+
+    int pstride = aFramePtr->pstrides_array[aComp];
+
+    int index;
+
+    if ( (pstride == 1) && (aFramePtr->strides_array[aComp] >= PAD_TO_DCT_BLOCKS(aNumSamples)) )
+    {
+        return (JSAMPROW) row_ptr;
+    }
+
+    for ( index = 0;  index < aNumSamples;  ++index )
+    {
+        aScratchPtr[index] = row_ptr[index * pstride];
+    }
+
+    // repeat the last sample up to the end of the last DCT block
+    memset(aScratchPtr + aNumSamples, aScratchPtr[aNumSamples - 1], PAD_TO_DCT_BLOCKS(aNumSamples) - aNumSamples);
+
+    return (JSAMPROW) aScratchPtr;
+}
+
+
+//=======================================================================================
+// synopsis: do_write_YUV_rows(aInfoPtr, aFramePtr, aScratchPtr)
+//
+// writes Y,U,V rows in raw-data mode --- one strip of DCT blocks per call
+//=======================================================================================
+static void do_write_YUV_rows(struct jpeg_compress_struct * aInfoPtr,
+                              const PixelsFrame_t         * aFramePtr,
+                              uint8_t                     * aScratchPtr)
+{
+    JSAMPROW   luma_rows[2 * DCTSIZE], cb_rows[DCTSIZE], cr_rows[DCTSIZE];
+
+    JSAMPARRAY planes_array[3] = { luma_rows, cb_rows, cr_rows };
+
+    int num_luma_rows = DCTSIZE << aFramePtr->rows_shift;
+
+    int  num_C_cols = (aFramePtr->num_cols + 1) / 2;
+    int  num_C_rows = (aFramePtr->num_rows + aFramePtr->rows_shift) >> aFramePtr->rows_shift;
+
+    uint8_t * luma_scratch = aScratchPtr;
+    uint8_t *   cb_scratch = luma_scratch + (2 * DCTSIZE * PAD_TO_DCT_BLOCKS(aFramePtr->num_cols));
+    uint8_t *   cr_scratch = cb_scratch + (DCTSIZE * PAD_TO_DCT_BLOCKS(num_C_cols));
+
+    int index;
+
+    while (aInfoPtr->next_scanline < aInfoPtr->image_height)
+    {
+        int luma_row = aInfoPtr->next_scanline;
+        int   C_row  = luma_row >> aFramePtr->rows_shift;
+
+        // rows below the frame repeat the last row
+        for ( index = 0;  index < num_luma_rows;  ++index )
+        {
+            luma_rows[index] = do_get_samples_row(aFramePtr, 0,
+                                                  MIN(luma_row + index, aFramePtr->num_rows - 1),
+                                                  aFramePtr->num_cols,
+                                                  luma_scratch + (index * PAD_TO_DCT_BLOCKS(aFramePtr->num_cols)));
+        }
+
+        for ( index = 0;  index < DCTSIZE;  ++index )
+        {
+            cb_rows[index] = do_get_samples_row(aFramePtr, 1,
+                                                MIN(C_row + index, num_C_rows - 1),
+                                                num_C_cols,
+                                                cb_scratch + (index * PAD_TO_DCT_BLOCKS(num_C_cols)));
+
+            cr_rows[index] = do_get_samples_row(aFramePtr, 2,
+                                                MIN(C_row + index, num_C_rows - 1),
+                                                num_C_cols,
+                                                cr_scratch + (index * PAD_TO_DCT_BLOCKS(num_C_cols)));
+        }
+
+        jpeg_write_raw_data(aInfoPtr, planes_array, num_luma_rows);
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_write_GRAY_rows(aInfoPtr, aFramePtr, aScratchPtr)
+//
+// writes Y rows in raw-data mode --- one strip of DCT blocks per call
+//=======================================================================================
+static void do_write_GRAY_rows(struct jpeg_compress_struct * aInfoPtr,
+                               const PixelsFrame_t         * aFramePtr,
+                               uint8_t                     * aScratchPtr)
+{
+    JSAMPROW   luma_rows[DCTSIZE];
+
+    JSAMPARRAY planes_array[1] = { luma_rows };
+
+    int index;
+
+    while (aInfoPtr->next_scanline < aInfoPtr->image_height)
+    {
+        int luma_row = aInfoPtr->next_scanline;
+
+        // rows below the frame repeat the last row
+        for ( index = 0;  index < DCTSIZE;  ++index )
+        {
+            luma_rows[index] = do_get_samples_row(aFramePtr, 0,
+                                                  MIN(luma_row + index, aFramePtr->num_rows - 1),
+                                                  aFramePtr->num_cols,
+                                                  aScratchPtr + (index * PAD_TO_DCT_BLOCKS(aFramePtr->num_cols)));
+        }
+
+        jpeg_write_raw_data(aInfoPtr, planes_array, DCTSIZE);
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_write_scanlines(aInfoPtr, aFramePtr, aScratchPtr)
+//
+// writes RGB rows --- converted to RGB24 unless already packed so
+//=======================================================================================
+static void do_write_scanlines(struct jpeg_compress_struct * aInfoPtr,
+                               const PixelsFrame_t         * aFramePtr,
+                               uint8_t                     * aScratchPtr)
+{
+    int is_RGB24 = (aFramePtr->family == e_PIXELS_RGB)                              &&
+                   (aFramePtr->pstrides_array[0] == 3)                              &&
+                   (aFramePtr->comps_array[1] == aFramePtr->comps_array[0] + 1)     &&
+                   (aFramePtr->comps_array[2] == aFramePtr->comps_array[0] + 2);
+
+    while (aInfoPtr->next_scanline < aInfoPtr->image_height)
+    {
+        int row_index = aInfoPtr->next_scanline;
+
+        JSAMPROW row_ptr = (JSAMPROW) (aFramePtr->comps_array[0] + (row_index * aFramePtr->strides_array[0]));
+
+        if (! is_RGB24)
+        {
+            convert_frame_row_to_RGB24(aScratchPtr, aFramePtr, row_index);
+
+            row_ptr = (JSAMPROW) aScratchPtr;
+        }
+
+        jpeg_write_scanlines(aInfoPtr, &row_ptr, 1);
+    }
+}
+
+
+//=======================================================================================
+// synopsis: result = do_stream_pixels_to_JPEG_file(aFramePtr, aQuality, aScratchPtr, aFilePtr)
+//
+// encodes the frame into the file --- returns 0 if OK, else error
+//=======================================================================================
+static int do_stream_pixels_to_JPEG_file(const PixelsFrame_t * aFramePtr,
+                                         int                   aQuality,
+                                         uint8_t             * aScratchPtr,
+                                         FILE                * aFilePtr)
+{
+    struct jpeg_compress_struct info;
+
+    JpegErrorHandler_t error_handler;
+
+    info.err = jpeg_std_error(&error_handler.manager);
+
+    error_handler.manager.error_exit = do_exit_on_jpeg_error;
+
+    if (setjmp(error_handler.jump_buffer) != 0)
+    {
+        jpeg_destroy_compress(&info);
+        return -1;
+    }
+
+    jpeg_create_compress(&info);
+
+    jpeg_stdio_dest(&info, aFilePtr);
+
+    info.image_width      = aFramePtr->num_cols;
+    info.image_height     = aFramePtr->num_rows;
+    info.input_components = (aFramePtr->family == e_PIXELS_GRAY) ? 1 : 3;
+    info.in_color_space   = (aFramePtr->family == e_PIXELS_GRAY) ? JCS_GRAYSCALE :
+                            (aFramePtr->family == e_PIXELS_YUV)  ? JCS_YCbCr     : JCS_RGB;
+
+    jpeg_set_defaults(&info);
+
+    jpeg_set_quality(&info, aQuality, TRUE);
+
+    if (aFramePtr->family == e_PIXELS_GRAY)
+    {
+        info.raw_data_in = TRUE;
+
+        info.comp_info[0].h_samp_factor = 1;
+        info.comp_info[0].v_samp_factor = 1;
+    }
+    else if (aFramePtr->family == e_PIXELS_YUV)
+    {
+        info.raw_data_in = TRUE;
+
+        info.comp_info[0].h_samp_factor = 2;
+        info.comp_info[0].v_samp_factor = 1 << aFramePtr->rows_shift;
+        info.comp_info[1].h_samp_factor = 1;
+        info.comp_info[1].v_samp_factor = 1;
+        info.comp_info[2].h_samp_factor = 1;
+        info.comp_info[2].v_samp_factor = 1;
+    }
+
+    jpeg_start_compress(&info, TRUE);
+
+    if (aFramePtr->family == e_PIXELS_YUV)
+    {
+        do_write_YUV_rows(&info, aFramePtr, aScratchPtr);
+    }
+    else if (aFramePtr->family == e_PIXELS_GRAY)
+    {
+        do_write_GRAY_rows(&info, aFramePtr, aScratchPtr);
+    }
+    else
+    {
+        do_write_scanlines(&info, aFramePtr, aScratchPtr);
+    }
+
+    jpeg_finish_compress(&info);
+
+    jpeg_destroy_compress(&info);
+
+    return 0;
+}
+
+#endif  // _NOT_USING_JPEG_LIBRARY_
+
+
+//=======================================================================================
+// synopsis: result = save_pixels_as_JPEG(aPathPtr, aFramePtr, aQuality)
+//
+// writes frame to a JPEG file --- YUV planes are encoded as is --- returns 0 if OK, else error
+//=======================================================================================
+int save_pixels_as_JPEG(const char * aPathPtr, const PixelsFrame_t * aFramePtr, int aQuality)
+{
+#ifndef _NOT_USING_JPEG_LIBRARY_
+
+    if ( (aPathPtr == NULL) || (aFramePtr == NULL) || (aFramePtr->num_cols < 1) || (aFramePtr->num_rows < 1) ||
+         (aFramePtr->comps_array[0] == NULL) || (aQuality < 1) || (aQuality > 100) )
+    {
+        return -10;
+    }
+
+    if ( (aFramePtr->family == e_PIXELS_YUV) &&
+         ((aFramePtr->comps_array[1] == NULL) || (aFramePtr->comps_array[2] == NULL)) )
+    {
+        return -10;
+    }
+
+    // scratch for a strip of padded Y,U,V rows --- or for one RGB24 row
+    int  padded_cols = PAD_TO_DCT_BLOCKS(aFramePtr->num_cols);
+    int  padded_C_cols = PAD_TO_DCT_BLOCKS((aFramePtr->num_cols + 1) / 2);
+    int  scratch_lng = (2 * DCTSIZE * padded_cols) + (2 * DCTSIZE * padded_C_cols);
+
+    uint8_t * scratch_ptr = malloc( MAX(scratch_lng, aFramePtr->num_cols * 3) );
+
+    if (scratch_ptr == NULL)
+    {
+        return -20;
+    }
+
+    FILE * fp = fopen (aPathPtr, "wb");
+
+    int result = (fp == NULL) ? -40 : do_stream_pixels_to_JPEG_file(aFramePtr, aQuality, scratch_ptr, fp);
+
+    if (fp != NULL)
+    {
+        fclose (fp);
+    }
+
+    free(scratch_ptr);
+
+    return result;
+
+#else
+
+    return -100;    // not supported
+
+#endif
+}
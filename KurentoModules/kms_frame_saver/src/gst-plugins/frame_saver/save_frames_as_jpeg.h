@@ -0,0 +1,43 @@
+/*
+ * ======================================================================================
+ * File:        save_frames_as_jpeg.h
+ *
+ * Purpose:     external interface (API) for code in "save_frames_as_jpeg.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Save_Frames_As_JPEG_H__
+
+#define __Save_Frames_As_JPEG_H__
+
+#include "convert_frame_pixels.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+#define DEFAULT_JPEG_QUALITY    (85)
+
+
+//=======================================================================================
+// synopsis: result = save_pixels_as_JPEG(aPathPtr, aFramePtr, aQuality)
+//
+// writes frame to a JPEG file --- YUV planes are encoded as is --- returns 0 if OK, else error
+//=======================================================================================
+extern int save_pixels_as_JPEG(const char          * aPathPtr,
+                               const PixelsFrame_t * aFramePtr,
+                               int                   aQuality);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Save_Frames_As_JPEG_H__
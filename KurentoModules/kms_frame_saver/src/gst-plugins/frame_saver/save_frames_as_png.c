@@ -6,6 +6,33 @@
 *
 * History:     1. 2016-10-17   JBendor     Created
 *              2. 2016-11-24   JBendor     Updated
+*              3. 2026-10-17               Streams converted rows into PNG encoder
+*              4. 2026-10-17               Tunable deflate level, filters and strategy
+*              5. 2026-10-17               Encodes into worker's scratch, one write per file
+*              6. 2026-10-17               BGR rows by png_set_bgr, RGBx pixmaps saved as RGB
+*              7. 2026-10-17               Deflates strips of rows in parallel
+*              8. 2026-10-17               GRAY frames saved as 8-bit gray images
+*
+* Description: By default rows are streamed into libpng (deflate by zlib, or by zlib-ng
+*              when linked in its zlib-compatible mode). When _USE_LIBDEFLATE_ is defined
+*              the rows are filtered here, deflated in one call by libdeflate and written
+*              as IHDR,IDAT,IEND chunks --- faster at every level, but holds the frame.
+*
+*              Either way the image is encoded into the worker's EncoderScratch_t and is
+*              written to its file by one write(). libpng and zlib allocate from the
+*              scratch's arena and libdeflate's compressor is kept for the next image.
+*
+*              When PngOptions_t.num_strips > 1 the rows are split into horizontal strips
+*              which are filtered and deflated by helper threads, pigz-style: each strip
+*              is a raw deflate stream primed with the 32KB of rows above it, ended by a
+*              sync flush (the last by finish), and the strips are concatenated into one
+*              zlib stream in one IDAT chunk. The checksums of the strips are combined.
+*              zlib is used for the strips with either backend, since libdeflate cannot
+*              end a stream without a final block.
+*
+*              GRAY frames (e.g. the Y plane of a YUV frame, see "fmt=gray") are saved as
+*              8-bit gray images, one byte per pixel --- rows whose samples are adjacent
+*              are written from the frame as they are.
 *
 * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
 *               Unauthorized copying of this file is strictly prohibited.
@@ -13,141 +40,1028 @@
 */
 
 #include "save_frames_as_png.h"
+#include "convert_frame_pixels.h"
+#include "frame_encoder_scratch.h"
+#include "frame_encoder_helpers.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include <png.h>
+#include <png.h>
+#include <zlib.h>
+
+#ifdef _USE_LIBDEFLATE_
+    #include <libdeflate.h>
+#endif
+
+
+#define STREAM_BATCH_BYTES  (32 * 1024)     // RGB24 rows converted per batch --- fits in L2
+
+#define DEFAULT_DEFLATE_LEVEL   (6)         // as zlib's Z_DEFAULT_COMPRESSION
+
+#define PNG_CHUNK_BYTES(N)      ( (N) + 12 )    // length, type, data, CRC
+
+#define PNG_HEADER_BYTES        ( 8 + PNG_CHUNK_BYTES(13) )     // signature and IHDR chunk
+
+#define PNG_FILTER_WORK_BYTES(L)    ( ((L) * 3) + (((L) + 1) * 2) )     // 2 converted rows, a zero
+                                                                        // row, 2 candidate rows
+#define DEFLATE_WINDOW_BYTES    (32 * 1024)
+
+#define PNG_PIXEL_BYTES(F)      ( ((F)->family == e_PIXELS_GRAY) ? 1 : 3 )    // GRAY8 or RGB24
+
+#define STRIP_BATCH_BYTES       (128 * 1024)    // filtered rows deflated per call, per strip
+
+#ifdef _USE_LIBDEFLATE_
+    #define PNG_CRC32(C,P,N)    libdeflate_crc32( (C), (P), (N) )
+#else
+    #define PNG_CRC32(C,P,N)    ( (uint32_t) crc32( (C), (P), (uInt) (N) ) )
+#endif
+
+#ifndef MIN
+    #define MIN(A,B)            ( ((A) < (B)) ? (A) : (B) )
+#endif
+
+#ifndef MAX
+    #define MAX(A,B)            ( ((A) > (B)) ? (A) : (B) )
+#endif
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef struct
+{
+    int         first_row,
+                num_rows;
+
+    size_t      output_offset,      // of the strip's deflated bytes in the output
+                output_bound,
+                output_lng;
+
+    uint32_t    adler,              // of the strip's filtered rows
+                crc;                // of the strip's deflated bytes
+
+    int         result;
+
+} PngStrip_t;
+
+typedef struct
+{
+    const PixelsFrame_t   * frame_ptr;
+    int                     filters;
+    int                     num_strips;
+
+    z_stream              * streams_array;
+    uint8_t               * work_ptr;       // work bytes of each strip
+    size_t                  work_lng;
+    uint8_t               * output_ptr;
+
+    PngStrip_t              strips_array[MAX_PNG_STRIPS];
+
+} PngStripsJob_t;
+
+typedef struct
+{
+    int         level,
+                strategy,
+                num_streams;        // streams made for level and strategy
+
+    z_stream    streams_array[MAX_PNG_STRIPS];
+
+} PngStripsState_t;
+
+
+static const int The_Zlib_Strategies[] = { Z_DEFAULT_STRATEGY, Z_FILTERED, Z_HUFFMAN_ONLY, Z_RLE, Z_FIXED };  // by PNG_STRATEGY_e
+
+
+//=======================================================================================
+// synopsis: count = do_convert_PNG_row(aRowPtr, aFramePtr, aRowIndex)
+//
+// converts one row to GRAY8 samples if the frame is GRAY, else to RGB24 --- returns pixels
+//=======================================================================================
+static int do_convert_PNG_row(uint8_t * aRowPtr, const PixelsFrame_t * aFramePtr, int aRowIndex)
+{
+    if (aFramePtr->family == e_PIXELS_GRAY)
+    {
+        return convert_frame_row_to_GRAY8(aRowPtr, aFramePtr, aRowIndex);
+    }
+
+    return convert_frame_row_to_RGB24(aRowPtr, aFramePtr, aRowIndex);
+}
+
+
+#if !defined(_USE_LIBDEFLATE_) && !defined(_NOT_USING_PNG_LIBRARY_)
+
+//=======================================================================================
+// synopsis: pointer = do_alloc_PNG_memory(aPngPtr, aLength)
+//
+// libpng's (and zlib's) allocator --- takes memory from the scratch's arena
+//=======================================================================================
+static png_voidp do_alloc_PNG_memory(png_structp aPngPtr, png_size_t aLength)
+{
+    return frame_encoder_scratch_alloc( (EncoderScratch_t *) png_get_mem_ptr(aPngPtr), aLength );
+}
+
+
+//=======================================================================================
+// synopsis: do_free_PNG_memory(aPngPtr, aPointer)
+//
+// libpng's (and zlib's) deallocator --- arena memory is kept for the next image
+//=======================================================================================
+static void do_free_PNG_memory(png_structp aPngPtr, png_voidp aPointer)
+{
+    frame_encoder_scratch_free( (EncoderScratch_t *) png_get_mem_ptr(aPngPtr), aPointer );
+}
+
+
+//=======================================================================================
+// synopsis: do_write_PNG_bytes(aPngPtr, aDataPtr, aLength)
+//
+// libpng's writer --- appends the encoded bytes to the scratch's output
+//=======================================================================================
+static void do_write_PNG_bytes(png_structp aPngPtr, png_bytep aDataPtr, png_size_t aLength)
+{
+    if (frame_encoder_scratch_append( (EncoderScratch_t *) png_get_io_ptr(aPngPtr), aDataPtr, aLength ) != 0)
+    {
+        png_error (aPngPtr, "out of memory");
+    }
+}
+
+
+//=======================================================================================
+// synopsis: do_flush_PNG_bytes(aPngPtr)
+//
+// libpng's flusher --- nothing to do, the output is written when the image is complete
+//=======================================================================================
+static void do_flush_PNG_bytes(png_structp aPngPtr)
+{
+    (void) aPngPtr;
+}
+
+#endif
+
+
+#ifndef _USE_LIBDEFLATE_
+
+//=======================================================================================
+// synopsis: do_set_PNG_options(aPngPtr, aOptionsPtr)
+//
+// applies the deflate level, row filters and deflate strategy --- unset ones keep defaults
+//=======================================================================================
+static void do_set_PNG_options(png_structp aPngPtr, const PngOptions_t * aOptionsPtr)
+{
+#ifndef _NOT_USING_PNG_LIBRARY_
+
+    int filters = 0;
+
+    if (aOptionsPtr->level >= 0)
+    {
+        png_set_compression_level (aPngPtr, aOptionsPtr->level);
+    }
+
+    filters |= (aOptionsPtr->filters & e_PNG_FILTER_NONE)  ? PNG_FILTER_NONE  : 0;
+    filters |= (aOptionsPtr->filters & e_PNG_FILTER_SUB)   ? PNG_FILTER_SUB   : 0;
+    filters |= (aOptionsPtr->filters & e_PNG_FILTER_UP)    ? PNG_FILTER_UP    : 0;
+    filters |= (aOptionsPtr->filters & e_PNG_FILTER_AVG)   ? PNG_FILTER_AVG   : 0;
+    filters |= (aOptionsPtr->filters & e_PNG_FILTER_PAETH) ? PNG_FILTER_PAETH : 0;
+
+    if (filters != 0)
+    {
+        png_set_filter (aPngPtr, PNG_FILTER_TYPE_BASE, filters);
+    }
+
+    if (aOptionsPtr->strategy != e_PNG_STRATEGY_AUTO)
+    {
+        png_set_compression_strategy (aPngPtr, The_Zlib_Strategies[aOptionsPtr->strategy]);
+    }
+
+#endif
+}
+
+
+//=======================================================================================
+// synopsis: result = do_stream_pixels_to_PNG_memory(aFramePtr, aOptionsPtr, aRowsPtr, aNumRows, aScratchPtr)
+//
+// converts batches of rows and encodes them into the scratch's output; returns 0 if OK, else error
+//=======================================================================================
+static int do_stream_pixels_to_PNG_memory(const PixelsFrame_t * aFramePtr,
+                                          const PngOptions_t  * aOptionsPtr,
+                                          uint8_t             * aRowsPtr,
+                                          int                   aNumRows,
+                                          EncoderScratch_t    * aScratchPtr)
+{
+#ifndef _NOT_USING_PNG_LIBRARY_
+
+    // RGB24 rows --- are written from the frame without conversion
+    int is_RGB24 = (aFramePtr->family == e_PIXELS_RGB)                              &&
+                   (aFramePtr->pstrides_array[0] == 3)                              &&
+                   (aFramePtr->comps_array[1] == aFramePtr->comps_array[0] + 1)     &&
+                   (aFramePtr->comps_array[2] == aFramePtr->comps_array[0] + 2);
+
+    // BGR24 rows --- as well, libpng swaps the red and blue samples of its row copy
+    int is_BGR24 = (aFramePtr->family == e_PIXELS_RGB)                              &&
+                   (aFramePtr->pstrides_array[0] == 3)                              &&
+                   (aFramePtr->comps_array[1] == aFramePtr->comps_array[2] + 1)     &&
+                   (aFramePtr->comps_array[0] == aFramePtr->comps_array[2] + 2);
+
+    // GRAY8 rows --- as well
+    int is_GRAY8 = (aFramePtr->family == e_PIXELS_GRAY) && (aFramePtr->pstrides_array[0] == 1);
+
+    png_structp png_ptr = png_create_write_struct_2 (PNG_LIBPNG_VER_STRING, NULL, NULL, NULL,
+                                                     aScratchPtr, do_alloc_PNG_memory, do_free_PNG_memory);
+    if (png_ptr == NULL)
+    {
+        return -1;
+    }
+
+    png_infop info_ptr = png_create_info_struct (png_ptr);
+    if (info_ptr == NULL)
+    {
+        png_destroy_write_struct (&png_ptr, &info_ptr);
+        return -2;
+    }
+
+    if (setjmp(png_jmpbuf(png_ptr)) != 0)
+    {
+        png_destroy_write_struct (&png_ptr, &info_ptr);
+        return -3;
+    }
+
+    png_set_write_fn (png_ptr, aScratchPtr, do_write_PNG_bytes, do_flush_PNG_bytes);
+
+    png_set_IHDR (png_ptr,
+                  info_ptr,
+                  aFramePtr->num_cols,
+                  aFramePtr->num_rows,
+                  NUM_SAMPLE_BITS_R_G_B,
+                  (aFramePtr->family == e_PIXELS_GRAY) ? PNG_COLOR_TYPE_GRAY : PNG_COLOR_TYPE_RGB,
+                  PNG_INTERLACE_NONE,
+                  PNG_COMPRESSION_TYPE_DEFAULT,
+                  PNG_FILTER_TYPE_DEFAULT);
+
+    do_set_PNG_options (png_ptr, aOptionsPtr);
+
+    png_write_info (png_ptr, info_ptr);
+
+    if (is_BGR24)
+    {
+        png_set_bgr (png_ptr);
+    }
+
+    int row_stride = aFramePtr->num_cols * PNG_PIXEL_BYTES(aFramePtr);
+
+    int row_index, batch_index;
+
+    for ( row_index = 0;  row_index < aFramePtr->num_rows;  row_index += aNumRows )
+    {
+        int num_rows = aFramePtr->num_rows - row_index;
+
+        if (num_rows > aNumRows)
+        {
+            num_rows = aNumRows;
+        }
+
+        if (is_RGB24 || is_BGR24 || is_GRAY8)
+        {
+            const uint8_t * row_ptr = aFramePtr->comps_array[is_BGR24 ? 2 : 0] + (row_index * aFramePtr->strides_array[0]);
+
+            for ( batch_index = 0;  batch_index < num_rows;  ++batch_index )
+            {
+                png_write_row (png_ptr, (png_bytep) row_ptr);
+
+                row_ptr += aFramePtr->strides_array[0];
+            }
+
+            continue;
+        }
+
+        for ( batch_index = 0;  batch_index < num_rows;  ++batch_index )
+        {
+            do_convert_PNG_row(aRowsPtr + (batch_index * row_stride), aFramePtr, row_index + batch_index);
+        }
+
+        for ( batch_index = 0;  batch_index < num_rows;  ++batch_index )
+        {
+            png_write_row (png_ptr, aRowsPtr + (batch_index * row_stride));
+        }
+    }
+
+    png_write_end (png_ptr, info_ptr);
+
+    png_destroy_write_struct (&png_ptr, &info_ptr);
+
+#endif
+
+    return 0;
+}
+
+#endif  // _USE_LIBDEFLATE_
+
+
+//=======================================================================================
+// synopsis: do_filter_PNG_row(aFilterType, aOutPtr, aRowPtr, aPrevPtr, aRowLng, aPixelLng)
+//
+// applies one PNG filter (0=None,1=Sub,2=Up,3=Average,4=Paeth) to a row of RGB24 or GRAY8
+//=======================================================================================
+static void do_filter_PNG_row(int             aFilterType,
+                              uint8_t       * aOutPtr,
+                              const uint8_t * aRowPtr,
+                              const uint8_t * aPrevPtr,
+                              int             aRowLng,
+                              int             aPixelLng)
+{
+    int index;
+
+    // the first pixel has no left neighbor --- its left and diagonal samples are zero
+    for ( index = 0;  index < aPixelLng;  ++index )
+    {
+        int up = aPrevPtr[index];
+
+        aOutPtr[index] = (uint8_t) (aRowPtr[index] - ((aFilterType == 2) || (aFilterType == 4) ? up  :
+                                                      (aFilterType == 3)                       ? up >> 1 : 0));
+    }
+
+    switch (aFilterType)
+    {
+        case 0:
+            memcpy(aOutPtr + aPixelLng, aRowPtr + aPixelLng, aRowLng - aPixelLng);
+            break;
+
+        case 1:
+            for ( index = aPixelLng;  index < aRowLng;  ++index )
+            {
+                aOutPtr[index] = (uint8_t) (aRowPtr[index] - aRowPtr[index - aPixelLng]);
+            }
+            break;
+
+        case 2:
+            for ( index = aPixelLng;  index < aRowLng;  ++index )
+            {
+                aOutPtr[index] = (uint8_t) (aRowPtr[index] - aPrevPtr[index]);
+            }
+            break;
+
+        case 3:
+            for ( index = aPixelLng;  index < aRowLng;  ++index )
+            {
+                aOutPtr[index] = (uint8_t) (aRowPtr[index] - ((aRowPtr[index - aPixelLng] + aPrevPtr[index]) >> 1));
+            }
+            break;
+
+        default:
+            for ( index = aPixelLng;  index < aRowLng;  ++index )
+            {
+                int left = aRowPtr[index - aPixelLng], up = aPrevPtr[index], diag = aPrevPtr[index - aPixelLng];
+
+                int dist_left = abs(up - diag),
+                    dist_up   = abs(left - diag),
+                    dist_diag = abs(left + up - diag - diag);
+
+                int predictor = ((dist_left <= dist_up) && (dist_left <= dist_diag)) ? left :
+                                (dist_up <= dist_diag) ? up : diag;
+
+                aOutPtr[index] = (uint8_t) (aRowPtr[index] - predictor);
+            }
+            break;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: cost = do_get_PNG_row_cost(aRowPtr, aRowLng)
+//
+// returns the sum of absolute signed residuals --- the usual heuristic to pick a filter
+//=======================================================================================
+static unsigned do_get_PNG_row_cost(const uint8_t * aRowPtr, int aRowLng)
+{
+    unsigned cost = 0;
+
+    int index;
+
+    for ( index = 0;  index < aRowLng;  ++index )
+    {
+        cost += (unsigned) abs((int8_t) aRowPtr[index]);
+    }
+
+    return cost;
+}
+
+
+//=======================================================================================
+// synopsis: length = do_seal_PNG_chunk(aChunkPtr, aTypePtr, aDataLng)
+//
+// adds length, type and CRC around data already at aChunkPtr+8 --- returns chunk length
+//=======================================================================================
+static size_t do_seal_PNG_chunk(uint8_t * aChunkPtr, const char * aTypePtr, size_t aDataLng)
+{
+    uint8_t * crc_ptr = aChunkPtr + 8 + aDataLng;
+
+    aChunkPtr[0] = (uint8_t) (aDataLng >> 24);
+    aChunkPtr[1] = (uint8_t) (aDataLng >> 16);
+    aChunkPtr[2] = (uint8_t) (aDataLng >>  8);
+    aChunkPtr[3] = (uint8_t) (aDataLng);
+
+    memcpy(aChunkPtr + 4, aTypePtr, 4);
+
+    uint32_t crc = PNG_CRC32(0, aChunkPtr + 4, aDataLng + 4);
+
+    crc_ptr[0] = (uint8_t) (crc >> 24);
+    crc_ptr[1] = (uint8_t) (crc >> 16);
+    crc_ptr[2] = (uint8_t) (crc >>  8);
+    crc_ptr[3] = (uint8_t) (crc);
+
+    return PNG_CHUNK_BYTES(aDataLng);
+}
+
+
+//=======================================================================================
+// synopsis: do_filter_PNG_rows(aFramePtr, aFilters, aFirstRow, aNumRows, aFilteredPtr, aWorkPtr)
+//
+// converts and filters rows, each prefixed by its filter type --- picks the cheapest filter
+//=======================================================================================
+static void do_filter_PNG_rows(const PixelsFrame_t * aFramePtr,
+                               int                   aFilters,
+                               int                   aFirstRow,
+                               int                   aNumRows,
+                               uint8_t             * aFilteredPtr,
+                               uint8_t             * aWorkPtr)
+{
+    int pixel_lng = PNG_PIXEL_BYTES(aFramePtr);
+
+    int   row_lng = aFramePtr->num_cols * pixel_lng;
+
+    // RGB24 and GRAY8 rows --- are filtered from the frame without conversion
+    int is_packed = ( (aFramePtr->family == e_PIXELS_RGB)                           &&
+                      (aFramePtr->pstrides_array[0] == 3)                           &&
+                      (aFramePtr->comps_array[1] == aFramePtr->comps_array[0] + 1)  &&
+                      (aFramePtr->comps_array[2] == aFramePtr->comps_array[0] + 2) )  ||
+                    ( (aFramePtr->family == e_PIXELS_GRAY) && (aFramePtr->pstrides_array[0] == 1) );
+
+    uint8_t * rgb_rows[2] = { aWorkPtr, aWorkPtr + row_lng };
+    uint8_t * zeros_ptr   = rgb_rows[1] + row_lng;
+    uint8_t * trial_ptr   = zeros_ptr + row_lng;
+    uint8_t * best_ptr    = trial_ptr + (row_lng + 1);
+
+    const uint8_t * prev_ptr = zeros_ptr;
+
+    int row_index, filter_type;
+
+    memset(zeros_ptr, 0, row_lng);
+
+    // the row above the first row --- is needed by the Up, Average and Paeth filters
+    for ( row_index = (aFirstRow > 0) ? aFirstRow - 1 : 0;  row_index < aFirstRow + aNumRows;  ++row_index )
+    {
+        const uint8_t * row_ptr = aFramePtr->comps_array[0] + (row_index * aFramePtr->strides_array[0]);
+
+        unsigned best_cost = ~0u;
+
+        if (! is_packed)
+        {
+            do_convert_PNG_row(rgb_rows[row_index & 1], aFramePtr, row_index);
+
+            row_ptr = rgb_rows[row_index & 1];
+        }
+
+        if (row_index < aFirstRow)
+        {
+            prev_ptr = row_ptr;
+            continue;
+        }
+
+        for ( filter_type = 0;  filter_type < 5;  ++filter_type )
+        {
+            if ( (aFilters & (1 << filter_type)) == 0 )
+            {
+                continue;
+            }
+
+            trial_ptr[0] = (uint8_t) filter_type;
+
+            do_filter_PNG_row(filter_type, trial_ptr + 1, row_ptr, prev_ptr, row_lng, pixel_lng);
+
+            // a single filter needs no cost
+            unsigned cost = (aFilters == (1 << filter_type)) ? 0 : do_get_PNG_row_cost(trial_ptr + 1, row_lng);
+
+            if (cost < best_cost)
+            {
+                uint8_t * swap_ptr = best_ptr;
+
+                best_ptr  = trial_ptr;
+                trial_ptr = swap_ptr;
+                best_cost = cost;
+            }
+        }
+
+        memcpy(aFilteredPtr + ((size_t) (row_index - aFirstRow) * (row_lng + 1)), best_ptr, row_lng + 1);
+
+        prev_ptr = row_ptr;
+    }
+}
+
+
+//=======================================================================================
+// synopsis: length = do_put_PNG_header(aOutPtr, aFramePtr)
+//
+// writes the PNG signature and the IHDR chunk of an RGB24 or GRAY8 image --- returns their length
+//=======================================================================================
+static size_t do_put_PNG_header(uint8_t * aOutPtr, const PixelsFrame_t * aFramePtr)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+    uint8_t * header_ptr = aOutPtr + sizeof(signature) + 8;
+
+    memcpy(aOutPtr, signature, sizeof(signature));
+
+    header_ptr[0]  = (uint8_t) (aFramePtr->num_cols >> 24);
+    header_ptr[1]  = (uint8_t) (aFramePtr->num_cols >> 16);
+    header_ptr[2]  = (uint8_t) (aFramePtr->num_cols >>  8);
+    header_ptr[3]  = (uint8_t) (aFramePtr->num_cols);
+    header_ptr[4]  = (uint8_t) (aFramePtr->num_rows >> 24);
+    header_ptr[5]  = (uint8_t) (aFramePtr->num_rows >> 16);
+    header_ptr[6]  = (uint8_t) (aFramePtr->num_rows >>  8);
+    header_ptr[7]  = (uint8_t) (aFramePtr->num_rows);
+    header_ptr[8]  = NUM_SAMPLE_BITS_R_G_B;
+    header_ptr[9]  = (aFramePtr->family == e_PIXELS_GRAY) ? 0 : 2;     // gray or RGB
+    header_ptr[10] = 0;     // deflate
+    header_ptr[11] = 0;     // adaptive filters
+    header_ptr[12] = 0;     // progressive
+
+    return sizeof(signature) + do_seal_PNG_chunk(aOutPtr + sizeof(signature), "IHDR", 13);
+}
+
+
+//=======================================================================================
+// synopsis: out_ptr = do_put_uint32_BE(aOutPtr, aValue)
+//
+// stores a big-endian 32-bit value --- returns a pointer past the stored bytes
+//=======================================================================================
+static uint8_t * do_put_uint32_BE(uint8_t * aOutPtr, uint32_t aValue)
+{
+    aOutPtr[0] = (uint8_t) (aValue >> 24);
+    aOutPtr[1] = (uint8_t) (aValue >> 16);
+    aOutPtr[2] = (uint8_t) (aValue >>  8);
+    aOutPtr[3] = (uint8_t) (aValue);
+
+    return aOutPtr + 4;
+}
+
+
+//=======================================================================================
+// synopsis: do_free_PNG_strips_state(aStatePtr)
+//
+// ends the deflate streams kept by a scratch
+//=======================================================================================
+static void do_free_PNG_strips_state(void * aStatePtr)
+{
+    PngStripsState_t * state_ptr = (PngStripsState_t *) aStatePtr;
+
+    while (--state_ptr->num_streams >= 0)
+    {
+        deflateEnd(&state_ptr->streams_array[state_ptr->num_streams]);
+    }
+
+    free(state_ptr);
+}
 
 
 //=======================================================================================
-// synopsis: pointer = do_get_RGB24_pixel_ptr_at(aPixmapPtr, aCol, aRow)
+// synopsis: state_ptr = do_get_PNG_strips_state(aScratchPtr, aLevel, aStrategy, aNumStreams)
 //
-// returns a pointer to the RGB24 pixel at the point (aCol, aRow)
+// returns the scratch's raw deflate streams --- made anew only when the settings change
 //=======================================================================================
-static RGB24_Pix_t * do_get_RGB24_pixel_ptr_at (PixmapInfo_t * aPixmapPtr, int aCol, int aRow)
+static PngStripsState_t * do_get_PNG_strips_state(EncoderScratch_t * aScratchPtr, int aLevel, int aStrategy, int aNumStreams)
 {
-    RGB24_Pix_t   * pixels_ptr = (RGB24_Pix_t *) aPixmapPtr->pixels;
+    PngStripsState_t * state_ptr = (PngStripsState_t *) aScratchPtr->compressor_ptr;
+
+    if ( (state_ptr == NULL) || (aScratchPtr->compressor_free_func != do_free_PNG_strips_state) ||
+         (state_ptr->level != aLevel) || (state_ptr->strategy != aStrategy) )
+    {
+        if ( (aScratchPtr->compressor_ptr != NULL) && (aScratchPtr->compressor_free_func != NULL) )
+        {
+            aScratchPtr->compressor_free_func(aScratchPtr->compressor_ptr);
+        }
+
+        state_ptr = (PngStripsState_t *) calloc(1, sizeof(PngStripsState_t));
+
+        aScratchPtr->compressor_ptr       = state_ptr;
+        aScratchPtr->compressor_free_func = (state_ptr != NULL) ? do_free_PNG_strips_state : NULL;
+        aScratchPtr->num_heap_allocs     += 1;
+
+        if (state_ptr == NULL)
+        {
+            return NULL;
+        }
+
+        state_ptr->level    = aLevel;
+        state_ptr->strategy = aStrategy;
+    }
+
+    while (state_ptr->num_streams < aNumStreams)
+    {
+        z_stream * stream_ptr = &state_ptr->streams_array[state_ptr->num_streams];
+
+        // raw deflate --- the zlib header and trailer are written around all the strips
+        if (deflateInit2(stream_ptr, aLevel, Z_DEFLATED, -15, 8, aStrategy) != Z_OK)
+        {
+            return NULL;
+        }
 
-    uint8_t * ptr_col_in_row_0 = (uint8_t *) &pixels_ptr[aCol];
+        state_ptr->num_streams   += 1;
+        aScratchPtr->num_heap_allocs += 1;
+    }
 
-    return (RGB24_Pix_t *) (ptr_col_in_row_0 + (aPixmapPtr->stride * aRow));
+    return state_ptr;
 }
 
 
 //=======================================================================================
-// synopsis: pointer = do_get_RGB32_pixel_ptr_at(aPixmapPtr, aCol, aRow)
+// synopsis: do_deflate_PNG_strip(aJobPtr, aStripIndex)
 //
-// returns a pointer to the RGB32 pixel at the point (aCol, aRow)
+// filters and deflates the rows of one strip into its part of the output --- a helper task
 //=======================================================================================
-static RGB32_Pix_t * do_get_RGB32_pixel_ptr_at (PixmapInfo_t * aPixmapPtr, int aCol, int aRow)
+static void do_deflate_PNG_strip(void * aJobPtr, int aStripIndex)
 {
-    RGB32_Pix_t   * pixels_ptr = (RGB32_Pix_t *) aPixmapPtr->pixels;
+    PngStripsJob_t * job_ptr = (PngStripsJob_t *) aJobPtr;
+
+    PngStrip_t     * strip_ptr = &job_ptr->strips_array[aStripIndex];
+
+    z_stream       * stream_ptr = &job_ptr->streams_array[aStripIndex];
+
+    uint8_t        * work_ptr = job_ptr->work_ptr + (aStripIndex * job_ptr->work_lng);
+
+    int filtered_lng = (job_ptr->frame_ptr->num_cols * PNG_PIXEL_BYTES(job_ptr->frame_ptr)) + 1;
+
+    int   batch_rows = MAX(1, STRIP_BATCH_BYTES / filtered_lng);
+
+    uint8_t * batch_ptr = work_ptr + PNG_FILTER_WORK_BYTES(filtered_lng - 1);
+
+    int row_index = strip_ptr->first_row,   end_row = strip_ptr->first_row + strip_ptr->num_rows;
+
+    int is_last = (aStripIndex == job_ptr->num_strips - 1);
+
+    strip_ptr->adler  = (uint32_t) adler32(0, NULL, 0);
+    strip_ptr->result = (deflateReset(stream_ptr) == Z_OK) ? 0 : -1;
+
+    // the strip's stream is primed with the rows above it, as if one stream deflated all rows
+    int num_dict_rows = MIN(row_index, (DEFLATE_WINDOW_BYTES + filtered_lng - 1) / filtered_lng);
+
+    if ( (strip_ptr->result == 0) && (num_dict_rows > 0) )
+    {
+        size_t dict_lng = MIN( (size_t) num_dict_rows * filtered_lng, (size_t) DEFLATE_WINDOW_BYTES );
+
+        do_filter_PNG_rows(job_ptr->frame_ptr, job_ptr->filters, row_index - num_dict_rows, num_dict_rows, batch_ptr, work_ptr);
+
+        if (deflateSetDictionary(stream_ptr, batch_ptr + ((size_t) num_dict_rows * filtered_lng) - dict_lng, (uInt) dict_lng) != Z_OK)
+        {
+            strip_ptr->result = -2;
+        }
+    }
+
+    stream_ptr->next_out  = job_ptr->output_ptr + strip_ptr->output_offset;
+    stream_ptr->avail_out = (uInt) strip_ptr->output_bound;
+
+    while ( (strip_ptr->result == 0) && (row_index < end_row) )
+    {
+        int num_rows = MIN(batch_rows, end_row - row_index);
+
+        do_filter_PNG_rows(job_ptr->frame_ptr, job_ptr->filters, row_index, num_rows, batch_ptr, work_ptr);
+
+        row_index += num_rows;
+
+        stream_ptr->next_in  = batch_ptr;
+        stream_ptr->avail_in = (uInt) (num_rows * filtered_lng);
+
+        strip_ptr->adler = (uint32_t) adler32(strip_ptr->adler, batch_ptr, stream_ptr->avail_in);
+
+        // a sync flush ends the strip at a byte boundary, with no final block
+        int flush = (row_index < end_row) ? Z_NO_FLUSH : (is_last ? Z_FINISH : Z_SYNC_FLUSH);
+
+        int status = deflate(stream_ptr, flush);
+
+        if ( (stream_ptr->avail_in != 0) || (stream_ptr->avail_out == 0) ||
+             (status != ((flush == Z_FINISH) ? Z_STREAM_END : Z_OK)) )
+        {
+            strip_ptr->result = -3;
+        }
+    }
 
-    uint8_t * ptr_col_in_row_0 = (uint8_t *) &pixels_ptr[aCol];
+    strip_ptr->output_lng = strip_ptr->output_bound - stream_ptr->avail_out;
 
-    return (RGB32_Pix_t *) (ptr_col_in_row_0 + (aPixmapPtr->stride * aRow));
+    strip_ptr->crc = PNG_CRC32(0, job_ptr->output_ptr + strip_ptr->output_offset, strip_ptr->output_lng);
 }
 
 
 //=======================================================================================
-// synopsis: result = do_save_RGB_frame_to_PNG_file (aPixmapPtr, file_path)
+// synopsis: result = do_split_pixels_to_PNG_memory(aFramePtr, aOptionsPtr, aScratchPtr)
 //
-// Write bitmap to a PNG file specified by path; returns 0 if OK, else error
+// deflates strips of rows in parallel into one IDAT chunk of the scratch's output --- 0 if OK
 //=======================================================================================
-static int do_save_RGB_frame_to_PNG_file (PixmapInfo_t * aPixmapPtr, const char * file_path)
+static int do_split_pixels_to_PNG_memory(const PixelsFrame_t * aFramePtr,
+                                         const PngOptions_t  * aOptionsPtr,
+                                         EncoderScratch_t    * aScratchPtr)
 {
-#ifndef _NOT_USING_PNG_LIBRARY_
+    int level = (aOptionsPtr->level >= 0) ? aOptionsPtr->level : DEFAULT_DEFLATE_LEVEL;
 
-    png_uint_32 row_idx = 0;
+    int row_lng = aFramePtr->num_cols * PNG_PIXEL_BYTES(aFramePtr);
 
-    png_uint_32 is_RGBA = (aPixmapPtr->depth == 32);
+    PngStripsJob_t job;
 
-    png_structp png_ptr = png_create_write_struct (PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-    if (png_ptr == NULL)
+    int strip_index;
+
+    job.frame_ptr  = aFramePtr;
+    job.filters    = (aOptionsPtr->filters != 0) ? aOptionsPtr->filters : e_PNG_FILTER_ALL;     // as libpng
+    job.num_strips = MIN( MIN(aOptionsPtr->num_strips, MAX_PNG_STRIPS), aFramePtr->num_rows );
+    job.work_lng   = PNG_FILTER_WORK_BYTES(row_lng) + ((size_t) MAX(1, STRIP_BATCH_BYTES / (row_lng + 1)) * (row_lng + 1));
+    job.work_ptr   = frame_encoder_scratch_buffer(aScratchPtr, job.work_lng * job.num_strips);
+
+    PngStripsState_t * state_ptr = do_get_PNG_strips_state(aScratchPtr, level, The_Zlib_Strategies[aOptionsPtr->strategy], job.num_strips);
+
+    if ( (job.work_ptr == NULL) || (state_ptr == NULL) )
     {
         return -1;
     }
 
-    png_infop info_ptr = png_create_info_struct (png_ptr);
-    if (info_ptr == NULL)
+    job.streams_array = state_ptr->streams_array;
+
+    // zlib header --- IDAT's data starts after its length and type
+    size_t zlib_offset = PNG_HEADER_BYTES + 8,   output_lng = zlib_offset + 2;
+
+    for ( strip_index = 0;  strip_index < job.num_strips;  ++strip_index )
+    {
+        PngStrip_t * strip_ptr = &job.strips_array[strip_index];
+
+        strip_ptr->first_row = (int) (((int64_t) aFramePtr->num_rows * strip_index) / job.num_strips);
+        strip_ptr->num_rows  = (int) (((int64_t) aFramePtr->num_rows * (strip_index + 1)) / job.num_strips) - strip_ptr->first_row;
+
+        // the bound of one deflate call, a sync flush marker and some slack
+        strip_ptr->output_offset = output_lng;
+        strip_ptr->output_bound  = deflateBound(&job.streams_array[strip_index],
+                                                (uLong) strip_ptr->num_rows * (row_lng + 1)) + 16;
+
+        output_lng += strip_ptr->output_bound;
+    }
+
+    // adler, IDAT's CRC and the IEND chunk
+    job.output_ptr = frame_encoder_scratch_reserve(aScratchPtr, output_lng + 8 + PNG_CHUNK_BYTES(0));
+
+    if (job.output_ptr == NULL)
     {
-        png_destroy_write_struct (&png_ptr, &info_ptr);
         return -2;
     }
 
-    if (setjmp(png_jmpbuf(png_ptr)) != 0)
+    frame_encoder_helpers_run(do_deflate_PNG_strip, &job, job.num_strips);
+
+    uint8_t * zlib_ptr = job.output_ptr + zlib_offset;
+
+    // zlib's header tells the level as zlib does --- and is a multiple of 31
+    int level_flags = ((level < 2) || (aOptionsPtr->strategy >= e_PNG_STRATEGY_HUFFMAN)) ? 0 :
+                      (level < 6) ? 1 : (level == 6) ? 2 : 3;
+
+    zlib_ptr[0] = 0x78;     // deflate with a 32KB window
+    zlib_ptr[1] = (uint8_t) (level_flags << 6);
+    zlib_ptr[1] = (uint8_t) (zlib_ptr[1] + 31 - (((zlib_ptr[0] << 8) + zlib_ptr[1]) % 31));
+
+    memcpy(zlib_ptr - 4, "IDAT", 4);
+
+    uLong adler = adler32(0, NULL, 0);
+    uLong   crc = crc32(0, zlib_ptr - 4, 4 + 2);   // IDAT's type and zlib's header
+
+    uint8_t * end_ptr = zlib_ptr + 2;
+
+    // the strips are moved down to follow one another
+    for ( strip_index = 0;  strip_index < job.num_strips;  ++strip_index )
     {
-        png_destroy_write_struct (&png_ptr, &info_ptr);
-        return -3;
+        PngStrip_t * strip_ptr = &job.strips_array[strip_index];
+
+        if (strip_ptr->result != 0)
+        {
+            return -3;
+        }
+
+        memmove(end_ptr, job.output_ptr + strip_ptr->output_offset, strip_ptr->output_lng);
+
+        end_ptr += strip_ptr->output_lng;
+
+        adler = adler32_combine(adler, strip_ptr->adler, (z_off_t) strip_ptr->num_rows * (row_lng + 1));
+        crc   = crc32_combine(crc, strip_ptr->crc, (z_off_t) strip_ptr->output_lng);
+    }
+
+    end_ptr = do_put_uint32_BE(end_ptr, (uint32_t) adler);
+
+    crc = crc32(crc, end_ptr - 4, 4);
+
+    do_put_uint32_BE(zlib_ptr - 8, (uint32_t) (end_ptr - zlib_ptr));
+
+    end_ptr = do_put_uint32_BE(end_ptr, (uint32_t) crc);
+
+    do_put_PNG_header(job.output_ptr, aFramePtr);
+
+    end_ptr += do_seal_PNG_chunk(end_ptr, "IEND", 0);
+
+    aScratchPtr->output_used += (size_t) (end_ptr - job.output_ptr);
+
+    return 0;
+}
+
+
+#ifdef _USE_LIBDEFLATE_
+
+//=======================================================================================
+// synopsis: do_free_deflate_compressor(aCompressorPtr)
+//
+// frees the compressor kept by a scratch
+//=======================================================================================
+static void do_free_deflate_compressor(void * aCompressorPtr)
+{
+    libdeflate_free_compressor( (struct libdeflate_compressor *) aCompressorPtr );
+}
+
+
+//=======================================================================================
+// synopsis: compressor_ptr = do_get_deflate_compressor(aScratchPtr, aLevel)
+//
+// returns the scratch's compressor --- made anew only when the level changes
+//=======================================================================================
+static struct libdeflate_compressor * do_get_deflate_compressor(EncoderScratch_t * aScratchPtr, int aLevel)
+{
+    if ( (aScratchPtr->compressor_ptr != NULL) &&
+         (aScratchPtr->compressor_free_func == do_free_deflate_compressor) &&
+         (aScratchPtr->compressor_key == aLevel) )
+    {
+        return (struct libdeflate_compressor *) aScratchPtr->compressor_ptr;
     }
 
-    FILE * fp = fopen (file_path, "wb");
-    if (! fp)
+    if ( (aScratchPtr->compressor_ptr != NULL) && (aScratchPtr->compressor_free_func != NULL) )
     {
-        png_destroy_write_struct (&png_ptr, &info_ptr);
-        return -4;
+        aScratchPtr->compressor_free_func(aScratchPtr->compressor_ptr);
     }
 
-    png_set_IHDR (png_ptr,
-                  info_ptr,
-                  aPixmapPtr->width,
-                  aPixmapPtr->height,
-                  NUM_SAMPLE_BITS_R_G_B,
-                  (is_RGBA ? PNG_COLOR_TYPE_RGB_ALPHA : PNG_COLOR_TYPE_RGB),
-                  PNG_INTERLACE_NONE,
-                  PNG_COMPRESSION_TYPE_DEFAULT,
-                  PNG_FILTER_TYPE_DEFAULT);
+    aScratchPtr->compressor_ptr       = libdeflate_alloc_compressor(aLevel);
+    aScratchPtr->compressor_key       = aLevel;
+    aScratchPtr->compressor_free_func = do_free_deflate_compressor;
+    aScratchPtr->num_heap_allocs     += 1;
+
+    return (struct libdeflate_compressor *) aScratchPtr->compressor_ptr;
+}
 
-    png_uint_32 length = (png_uint_32) ((aPixmapPtr->height + 1) * sizeof(png_bytep));
 
-    png_bytep* row_pointers = png_malloc (png_ptr, length);
+//=======================================================================================
+// synopsis: result = do_deflate_pixels_to_PNG_memory(aFramePtr, aOptionsPtr, aScratchPtr)
+//
+// filters all rows, deflates them by one libdeflate call into the scratch's output --- 0 if OK
+//=======================================================================================
+static int do_deflate_pixels_to_PNG_memory(const PixelsFrame_t * aFramePtr,
+                                           const PngOptions_t  * aOptionsPtr,
+                                           EncoderScratch_t    * aScratchPtr)
+{
+    int row_lng = aFramePtr->num_cols * PNG_PIXEL_BYTES(aFramePtr);
 
-    if (is_RGBA)
+    int filters = (aOptionsPtr->filters != 0) ? aOptionsPtr->filters : e_PNG_FILTER_ALL;     // as libpng
+
+    struct libdeflate_compressor * compressor_ptr =
+        do_get_deflate_compressor( aScratchPtr, (aOptionsPtr->level >= 0) ? aOptionsPtr->level : DEFAULT_DEFLATE_LEVEL );
+
+    if (compressor_ptr == NULL)
     {
-        for (row_idx = 0;  row_idx < aPixmapPtr->height;  ++row_idx)
-        {
-            RGB32_Pix_t * row_ptr = do_get_RGB32_pixel_ptr_at(aPixmapPtr, 0, row_idx);
+        return -1;
+    }
 
-            row_pointers[row_idx] = (png_bytep) row_ptr;
-        }
+    size_t filtered_lng = (size_t) aFramePtr->num_rows * (row_lng + 1);
+
+    size_t deflate_bound = libdeflate_zlib_compress_bound(compressor_ptr, filtered_lng);
+
+    uint8_t * filtered_ptr = frame_encoder_scratch_buffer(aScratchPtr, filtered_lng + PNG_FILTER_WORK_BYTES(row_lng));
+
+    // signature, IHDR, IDAT and IEND chunks
+    uint8_t *   output_ptr = frame_encoder_scratch_reserve(aScratchPtr, PNG_HEADER_BYTES + PNG_CHUNK_BYTES(deflate_bound) + PNG_CHUNK_BYTES(0));
+
+    if ( (filtered_ptr == NULL) || (output_ptr == NULL) )
+    {
+        return -2;
     }
-    else
+
+    do_filter_PNG_rows(aFramePtr, filters, 0, aFramePtr->num_rows, filtered_ptr, filtered_ptr + filtered_lng);
+
+    uint8_t * chunk_ptr = output_ptr + do_put_PNG_header(output_ptr, aFramePtr);
+
+    size_t deflate_lng = libdeflate_zlib_compress(compressor_ptr, filtered_ptr, filtered_lng, chunk_ptr + 8, deflate_bound);
+
+    if (deflate_lng == 0)
     {
-        for (row_idx = 0;  row_idx < aPixmapPtr->height;  ++row_idx)
-        {
-            RGB24_Pix_t * row_ptr = do_get_RGB24_pixel_ptr_at(aPixmapPtr, 0, row_idx);
+        return -3;
+    }
 
-            row_pointers[row_idx] = (png_bytep) row_ptr;
-        }
+    chunk_ptr += do_seal_PNG_chunk(chunk_ptr, "IDAT", deflate_lng);
+    chunk_ptr += do_seal_PNG_chunk(chunk_ptr, "IEND", 0);
+
+    aScratchPtr->output_used += (size_t) (chunk_ptr - output_ptr);
+
+    return 0;
+}
+
+#endif  // _USE_LIBDEFLATE_
+
+
+//=======================================================================================
+// synopsis: result = save_pixels_as_PNG(aPathPtr, aFramePtr, aOptionsPtr, aScratchPtr)
+//
+// encodes the frame in memory, then writes it to a PNG file --- returns 0 if OK, else error
+//=======================================================================================
+int save_pixels_as_PNG(const char          * aPathPtr,
+                       const PixelsFrame_t * aFramePtr,
+                       const PngOptions_t  * aOptionsPtr,
+                       EncoderScratch_t    * aScratchPtr)
+{
+    static const PngOptions_t default_options = { -1, 0, e_PNG_STRATEGY_AUTO, 0 };
+
+    EncoderScratch_t local_scratch;
+
+    EncoderScratch_t * scratch_ptr = aScratchPtr;
+
+    if ( (aPathPtr == NULL) || (aFramePtr == NULL) || (aFramePtr->num_cols < 1) || (aFramePtr->num_rows < 1) )
+    {
+        return -10;
     }
 
-    png_init_io (png_ptr, fp);
+    if (aOptionsPtr == NULL)
+    {
+        aOptionsPtr = &default_options;
+    }
 
-    png_set_rows (png_ptr, info_ptr, row_pointers);
+    // possibly --- the caller keeps no scratch --- use one for this image only
+    if (scratch_ptr == NULL)
+    {
+        memset(&local_scratch, 0, sizeof(local_scratch));
 
-    png_write_png (png_ptr, info_ptr, PNG_TRANSFORM_IDENTITY, NULL);
+        scratch_ptr = &local_scratch;
+    }
 
-    png_free (png_ptr, row_pointers);
+    frame_encoder_scratch_begin(scratch_ptr);
 
-    row_pointers = NULL;
+    int row_stride = aFramePtr->num_cols * PNG_PIXEL_BYTES(aFramePtr);
 
-    png_destroy_write_struct (&png_ptr, &info_ptr);
+    int   num_rows = (row_stride >= STREAM_BATCH_BYTES) ? 1 : (STREAM_BATCH_BYTES / row_stride);
 
-    png_ptr = NULL;
-    info_ptr = NULL;
+    uint8_t * rows_ptr = frame_encoder_scratch_buffer(scratch_ptr, row_stride * num_rows);
 
-    fclose (fp);
+    int result = 0;
 
+    if (rows_ptr == NULL)
+    {
+        result = -20;
+    }
+    // verify the frame's layout before encoding
+    else if (do_convert_PNG_row(rows_ptr, aFramePtr, 0) != aFramePtr->num_cols)
+    {
+        result = -30;
+    }
+    else if (aOptionsPtr->num_strips > 1)
+    {
+        result = do_split_pixels_to_PNG_memory(aFramePtr, aOptionsPtr, scratch_ptr);
+    }
+    else
+    {
+#ifdef _USE_LIBDEFLATE_
+        result = do_deflate_pixels_to_PNG_memory(aFramePtr, aOptionsPtr, scratch_ptr);
 #else
+        result = do_stream_pixels_to_PNG_memory(aFramePtr, aOptionsPtr, rows_ptr, num_rows, scratch_ptr);
+#endif
+    }
 
-    do_get_RGB24_pixel_ptr_at(aPixmapPtr, 0, 0);    // supress "unused static" warning
-    do_get_RGB32_pixel_ptr_at(aPixmapPtr, 0, 0);    // supress "unused static" warning
+    if ( (result == 0) && (frame_encoder_scratch_write_file(scratch_ptr, aPathPtr) != 0) )
+    {
+        result = -40;
+    }
 
-#endif
+    if (scratch_ptr == &local_scratch)
+    {
+        frame_encoder_scratch_release(&local_scratch);
+    }
 
-    return 0;
+    return result;
+}
+
+
+//=======================================================================================
+// synopsis: result = do_save_RGB_pixmap(aPathPtr, aPixmapPtr)
+//
+// writes RGB24 or RGBx pixels as an RGB PNG file (the 4th byte is dropped); 0 if OK, else error
+//=======================================================================================
+static int do_save_RGB_pixmap(const char * aPathPtr, PixmapInfo_t * aPixmapPtr)
+{
+    const uint8_t * pixels_ptr = (const uint8_t *) aPixmapPtr->pixels;
+
+    int pixel_bytes = (int) aPixmapPtr->depth / 8;
+
+    int  row_stride = (int) aPixmapPtr->stride;
+
+    PixelsFrame_t frame = { e_PIXELS_RGB, (int) aPixmapPtr->width, (int) aPixmapPtr->height, 0,
+                            { pixels_ptr, pixels_ptr + 1, pixels_ptr + 2 },
+                            { row_stride, row_stride, row_stride },
+                            { pixel_bytes, pixel_bytes, pixel_bytes } };
+
+    return save_pixels_as_PNG(aPathPtr, &frame, NULL, NULL);
 }
 
 
@@ -203,7 +1117,7 @@ static int do_save_RGB24_frame(const char * aPathPtr, PixmapInfo_t * aPixmapPtr)
         return result;
     }
 
-    int errors = do_save_RGB_frame_to_PNG_file ( aPixmapPtr, aPathPtr );
+    int errors = do_save_RGB_pixmap ( aPathPtr, aPixmapPtr );
 
     return errors;  // 0 is OK, else error
 }
@@ -262,158 +1176,12 @@ static int do_save_RGB32_frame(const char * aPathPtr, PixmapInfo_t * aPixmapPtr)
         return result;
     }
 
-    int errors = do_save_RGB_frame_to_PNG_file ( aPixmapPtr, aPathPtr );
+    int errors = do_save_RGB_pixmap ( aPathPtr, aPixmapPtr );
 
     return errors;  // 0 is OK, else error
 }
 
 
-/*
-* =============================================================================
-* YUV encodings have Y,U=Cb,V=Cr samples stored in packed or planar formats.
-* YUV values can have the range [0,255] or limited to [16,235] & [16,240].
-* In Packed formats byte-samples are packed into one array of macropixels.
-* In Planar formats Y,U,V are in consecutive arrays (U,V are sub-sampled).
-* More details are provided at "http://www.fourcc.org/yuv.php".
-*
-* ITUR_Convert_YUV_to_RGB(int Y, int U, int V)
-*      int32_t Cb = U - 128;
-*      int32_t Cr = V - 128;
-*      int32_t R  = Y + (1.4065 * Cb);
-*      int32_t B  = Y + (1.7790 * Cr);
-*      int32_t G  = Y - (0.3455 * Cb) - (0.7169 * Cr);
-*      if (R < 0) R=0; else if (R > 255) R = 255;
-*      if (B < 0) B=0; else if (B > 255) B = 255;
-*      if (G < 0) G=0; else if (G > 255) G = 255;
-*      int32_t RGB = 0xFF000000 | (R << 16) | (G << 8) | B;
-* =============================================================================
-*/
-static char sz_YUV_decoder_error[299] = { '!', 0 };
-
-
-//=======================================================================================
-// synopsis: result = do_decode_YUV420_frame(out_RGB_ptr, YUV_src_ptr, aCols, aRows, aType)
-//
-// Writes bitmap to a PNG file specified by path; returns 0 if OK, else error
-//=======================================================================================
-static int32_t do_decode_YUV420_frame(void    *output_RGB_ptr,
-                                      uint8_t *YUV_source_ptr,
-                                      int32_t  numFrameCols,
-                                      int32_t  numFrameRows,
-                                      int32_t  srcFrameType)
-{
-#define _VERIFY_I420_ARGS___________________NO
-#define _STRICT_I420_TYPE_
-
-#define _RGB32_PIXEL_TYPE___________________NO
-#define _RGB24_PIXEL_TYPE_
-
-#define CLAMP_8BITS(X) { if (X < 0) { X = 0; } else if (X > 255) { X = 255; } }
-#define MAKE_ARGB_8888(pRGB,R,B,G)   ( ++pRGB, pRGB->red=(uint8_t)R, pRGB->blue=(uint8_t)B, pRGB->green=(uint8_t)G )
-#define MAKE_RGB24_888(pRGB,R,B,G)   ( ++pRGB, pRGB->red=(uint8_t)R, pRGB->blue=(uint8_t)B, pRGB->green=(uint8_t)G )
-
-#ifdef _RGB24_PIXEL_TYPE_
-    #define MAKE_RGB_PIXEL(pRGB,R,G,B)   ( MAKE_RGB24_888(pRGB,R,B,G) )
-    RGB24_Pix_t* ptr_RGB_pixel = ((RGB24_Pix_t*) output_RGB_ptr) - 1;
-#endif
-
-#ifdef _RGB32_PIXEL_TYPE_
-    #define MAKE_RGB_PIXEL(pRGB,R,G,B)   ( MAKE_ARGB_8888(pRGB,R,B,G) )
-    RGB32_Pix_t* ptr_RGB_pixel = ((RGB32_Pix_t*) output_RGB_ptr) - 1;
-#endif
-
-    int32_t     col_index, row_index, R, G, B, Y1, Y2, U, V, D, E, F;
-
-    int32_t     num_frame_cols = numFrameCols;
-    int32_t     num_frame_rows = numFrameRows;
-
-    int32_t       Y_row_stride = num_frame_cols;                        // intensity rows stride
-    int32_t       Y_frame_size = (Y_row_stride * num_frame_rows);       // intensity frame length
-
-    int32_t       C_row_stride = ((num_frame_cols >> 1) + 0x3) & ~0x3;  // chroma rows stride
-    int32_t       C_frame_size = (C_row_stride * num_frame_rows) / 2;   // chroma frame length
-
-    uint8_t    *ptr_Y_encoding = YUV_source_ptr - 1;
-    uint8_t    *end_Y_encoding = ptr_Y_encoding + Y_frame_size;
-    uint8_t    *ptr_U_encoding = NULL;
-    uint8_t    *ptr_V_encoding = NULL;
-
-    *sz_YUV_decoder_error = 0;
-
-#ifdef _VERIFY_I420_ARGS_
-    if ( (num_frame_cols < 0) || (num_frame_cols & 1) || (srcFrameType < 1) ||
-         (num_frame_rows < 0) || (num_frame_rows & 1) || (srcFrameType > 4) )
-    {
-        sprintf (sz_YUV_decoder_error, "invalid arguments");
-        return -1;
-    }
-#endif
-
-#ifdef _STRICT_I420_TYPE_
-    if (srcFrameType != 1)
-    {
-        sprintf (sz_YUV_decoder_error, "expecting I420_IYUV as Frame Type");
-        return -2;
-    }
-#endif
-
-    for ( row_index = 0;  row_index < num_frame_rows;  ++row_index )
-    {
-        ptr_U_encoding = end_Y_encoding + ( (row_index >> 1) * C_row_stride );
-        ptr_V_encoding = ptr_U_encoding + C_frame_size;
-
-#ifndef _STRICT_I420_TYPE_
-        if (srcFrameType == 2) // "I420_YV12"
-        {
-            ptr_V_encoding  = ptr_U_encoding;
-            ptr_U_encoding += C_frame_size;
-        }
-        else if (srcFrameType == 3) // "I420_NV12"
-        {
-            ptr_V_encoding = ptr_U_encoding + 1;
-        }
-        else if (srcFrameType == 4) // "I420_NV21"
-        {
-            ptr_V_encoding  = ptr_U_encoding;
-            ptr_U_encoding += 1;
-        }
-        else if (srcFrameType != 1) // "I420_IYUV"
-        {
-            sprintf (sz_YUV_decoder_error, "invalid Frame Type");
-            return -3;
-        }
-#endif
-
-        for ( col_index = 0;  col_index < num_frame_cols;  col_index += 2 )
-        {
-            Y1 = ( 0xFF & (int32_t) *(++ptr_Y_encoding) );
-            Y2 = ( 0xFF & (int32_t) *(++ptr_Y_encoding) );
-
-            U = ( 0xFF & (int32_t) *(++ptr_U_encoding) ) - 128;
-            V = ( 0xFF & (int32_t) *(++ptr_V_encoding) ) - 128;
-
-            D = ( ((88 * U) + (184 * V)) >> 8 );    // approx. ((0.3455 * U) + (0.7169 * V))
-            E = ( (455 * U) >> 8 );                 // approx. (1.7790 * U)
-            F = ( (360 * V) >> 8 );                 // approx. (1.4065 * V)
-
-            G = Y1 - D;      CLAMP_8BITS( G );
-            B = Y1 + E;      CLAMP_8BITS( B );
-            R = Y1 + F;      CLAMP_8BITS( R );
-
-            MAKE_RGB_PIXEL(ptr_RGB_pixel, R, G, B);
-
-            G = Y2 - D;      CLAMP_8BITS( G );
-            B = Y2 + E;      CLAMP_8BITS( B );
-            R = Y2 + F;      CLAMP_8BITS( R );
-
-            MAKE_RGB_PIXEL(ptr_RGB_pixel, R, G, B);
-        }
-    }
-
-    return Y_frame_size;
-}
-
-
 //=======================================================================================
 // synopsis: count = convert_BGR_frame_to_RGB(aPixelsPtr, aDepth, aStride, aCols, aRows)
 //
@@ -555,20 +1323,19 @@ int save_frame_as_PNG(const char * aPathPtr,
 
     if (strstr(aFormatPtr, "I420") != NULL)   // YUV
     {
-        RGB24_Pix_t * ptr_RGB24_pixels = malloc(sizeof(RGB24_Pix_t) * num_frame_pixels);
+        int   Y_row_stride = aFrameCols;                                // intensity rows stride
+        int   C_row_stride = ((aFrameCols >> 1) + 0x3) & ~0x3;          // chroma rows stride
+        int   C_frame_size = (C_row_stride * aFrameRows) / 2;           // chroma frame length
 
-        int result = do_decode_YUV420_frame(ptr_RGB24_pixels, aPixelsPtr, aFrameCols, aFrameRows, 1);
+        PixelsFrame_t frame = { e_PIXELS_YUV, aFrameCols, aFrameRows, 1,
+                                { aPixelsPtr, NULL, NULL },
+                                { Y_row_stride, C_row_stride, C_row_stride },
+                                { 1, 1, 1 } };
 
-        if (result == num_frame_pixels)
-        {
-            pixmap_info.depth  = 24;
-            pixmap_info.stride = aFrameCols * 3;
-            pixmap_info.pixels = ptr_RGB24_pixels;
-
-            result = do_save_RGB24_frame(aPathPtr, &pixmap_info);
-        }
+        frame.comps_array[1] = frame.comps_array[0] + (Y_row_stride * aFrameRows);
+        frame.comps_array[2] = frame.comps_array[1] + C_frame_size;
 
-        free(ptr_RGB24_pixels);
+        int result = save_pixels_as_PNG(aPathPtr, &frame, NULL, NULL);
 
         return (result ? -60 : 0);
     }
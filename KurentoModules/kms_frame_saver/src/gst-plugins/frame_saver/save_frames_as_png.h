@@ -6,6 +6,10 @@
  *
  * History:     1. 2016-11-03   JBendor     Created
  *              2. 2016-11-24   JBendor     Updated
+ *              3. 2026-10-17               Streams converted rows into PNG encoder
+ *              4. 2026-10-17               Tunable deflate level, filters and strategy
+ *              5. 2026-10-17               Encodes into worker's scratch, one write per file
+ *              6. 2026-10-17               Deflates strips of rows in parallel
  *
  * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
  *               Unauthorized copying of this file is strictly prohibited.
@@ -16,6 +20,9 @@
 
 #define __Save_Frames_As_PNG_H__
 
+#include "convert_frame_pixels.h"
+#include "frame_encoder_scratch.h"
+
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -56,6 +63,42 @@ typedef struct
 #define NUM_SAMPLE_BITS_R_G_B   (8)
 
 
+typedef enum
+{
+    e_PNG_FILTER_NONE  = 0x01,      // bits of PngOptions_t.filters --- 0 is the library's default
+    e_PNG_FILTER_SUB   = 0x02,
+    e_PNG_FILTER_UP    = 0x04,
+    e_PNG_FILTER_AVG   = 0x08,
+    e_PNG_FILTER_PAETH = 0x10,
+    e_PNG_FILTER_ALL   = 0x1F
+
+} PNG_FILTERS_e;
+
+
+typedef enum
+{
+    e_PNG_STRATEGY_AUTO = 0,        // the library's default
+    e_PNG_STRATEGY_FILTERED,
+    e_PNG_STRATEGY_HUFFMAN,
+    e_PNG_STRATEGY_RLE,
+    e_PNG_STRATEGY_FIXED
+
+} PNG_STRATEGY_e;
+
+
+#define MAX_PNG_STRIPS          (16)
+
+
+typedef struct
+{
+    int             level;          // deflate level 0..9 --- -1 is the library's default
+    int             filters;        // PNG_FILTERS_e bits --- several bits select adaptively
+    PNG_STRATEGY_e  strategy;       // ignored by libdeflate unless strips are used
+    int             num_strips;     // strips of rows deflated in parallel --- 0 or 1 is serial
+
+} PngOptions_t;
+
+
 //=======================================================================================
 // synopsis: count = convert_BGR_frame_to_RGB(aPixelsPtr, aDepth, aStride, aCols, aRows)
 //
@@ -82,6 +125,17 @@ extern int save_frame_as_PNG(const char * aPathPtr,
                              int          aFrameRows);
 
 
+//=======================================================================================
+// synopsis: result = save_pixels_as_PNG(aPathPtr, aFramePtr, aOptionsPtr, aScratchPtr)
+//
+// encodes the frame in memory, then writes it to a PNG file --- returns 0 if OK, else error
+//=======================================================================================
+extern int save_pixels_as_PNG(const char          * aPathPtr,
+                              const PixelsFrame_t * aFramePtr,
+                              const PngOptions_t  * aOptionsPtr,      // NULL for defaults
+                              EncoderScratch_t    * aScratchPtr);     // NULL for none
+
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
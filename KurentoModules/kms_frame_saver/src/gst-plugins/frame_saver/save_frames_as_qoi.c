@@ -0,0 +1,271 @@
+/*
+* ======================================================================================
+* File:        save_frames_as_qoi.c
+*
+* Purpose:     saves image frames as QOI files
+*
+* History:     1. 2026-10-17               Created
+*
+* Description: QOI ("Quite OK Image" format, https://qoiformat.org) is a lossless format
+*              that encodes each pixel in one pass with a few table lookups and no entropy
+*              coder --- an order of magnitude faster than deflate, in files about 20-40%
+*              larger than PNG. Rows are converted to RGB24 one at a time (RGB24 frames as
+*              is), encoded into a batch buffer, and the buffer is written when full.
+*
+* Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+*               Unauthorized copying of this file is strictly prohibited.
+* ======================================================================================
+*/
+
+#include "save_frames_as_qoi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define QOI_BATCH_BYTES     (64 * 1024)     // encoded bytes written per fwrite()
+
+#define QOI_OP_INDEX        (0x00)          // 00xxxxxx
+#define QOI_OP_DIFF         (0x40)          // 01xxxxxx
+#define QOI_OP_LUMA         (0x80)          // 10xxxxxx
+#define QOI_OP_RUN          (0xC0)          // 11xxxxxx
+#define QOI_OP_RGB          (0xFE)          // 11111110
+
+#define QOI_MAX_RUN         (62)
+#define QOI_HEADER_BYTES    (14)
+#define QOI_MAX_PIXEL_BYTES (4)             // QOI_OP_RGB --- the worst case
+
+// pixels are packed as R,G,B,A in the bytes of a uint32_t --- alpha is always opaque
+#define QOI_PACK_RGB(R,G,B) ( (uint32_t)(R) | ((uint32_t)(G) << 8) | ((uint32_t)(B) << 16) | 0xFF000000u )
+
+#define QOI_HASH_RGB(R,G,B) ( ((R) * 3 + (G) * 5 + (B) * 7 + 255 * 11) & 63 )
+
+
+//=======================================================================================
+// custom types
+//=======================================================================================
+typedef struct
+{
+    uint32_t    prev_pixel;
+    int         run_length;
+    uint32_t    index_array[64];
+
+} QoiEncoder_t;
+
+
+//=======================================================================================
+// synopsis: out_ptr = do_put_uint32_BE(aOutPtr, aValue)
+//
+// stores a big-endian 32-bit value --- returns a pointer past the stored bytes
+//=======================================================================================
+static uint8_t * do_put_uint32_BE(uint8_t * aOutPtr, uint32_t aValue)
+{
+    aOutPtr[0] = (uint8_t) (aValue >> 24);
+    aOutPtr[1] = (uint8_t) (aValue >> 16);
+    aOutPtr[2] = (uint8_t) (aValue >>  8);
+    aOutPtr[3] = (uint8_t) (aValue);
+
+    return aOutPtr + 4;
+}
+
+
+//=======================================================================================
+// synopsis: out_ptr = do_encode_RGB24_row(aEncoderPtr, aRgbPtr, aNumCols, aOutPtr)
+//
+// encodes one row of RGB24 pixels --- returns a pointer past the encoded bytes
+//=======================================================================================
+static uint8_t * do_encode_RGB24_row(QoiEncoder_t  * aEncoderPtr,
+                                     const uint8_t * aRgbPtr,
+                                     int             aNumCols,
+                                     uint8_t       * aOutPtr)
+{
+    uint32_t prev_pixel = aEncoderPtr->prev_pixel;
+
+    int      run_length = aEncoderPtr->run_length;
+
+    const uint8_t * end_ptr = aRgbPtr + (aNumCols * 3);
+
+    for ( ;  aRgbPtr < end_ptr;  aRgbPtr += 3 )
+    {
+        uint32_t pixel = QOI_PACK_RGB(aRgbPtr[0], aRgbPtr[1], aRgbPtr[2]);
+
+        if (pixel == prev_pixel)
+        {
+            if (++run_length == QOI_MAX_RUN)
+            {
+                *aOutPtr++ = (uint8_t) (QOI_OP_RUN | (run_length - 1));
+                run_length = 0;
+            }
+            continue;
+        }
+
+        if (run_length > 0)
+        {
+            *aOutPtr++ = (uint8_t) (QOI_OP_RUN | (run_length - 1));
+            run_length = 0;
+        }
+
+        int hash = QOI_HASH_RGB(aRgbPtr[0], aRgbPtr[1], aRgbPtr[2]);
+
+        if (aEncoderPtr->index_array[hash] == pixel)
+        {
+            *aOutPtr++ = (uint8_t) (QOI_OP_INDEX | hash);
+        }
+        else
+        {
+            // channel differences wrap around, as in the decoder
+            int8_t diff_R = (int8_t) (aRgbPtr[0] - (uint8_t) (prev_pixel));
+            int8_t diff_G = (int8_t) (aRgbPtr[1] - (uint8_t) (prev_pixel >> 8));
+            int8_t diff_B = (int8_t) (aRgbPtr[2] - (uint8_t) (prev_pixel >> 16));
+
+            int8_t diff_RG = (int8_t) (diff_R - diff_G);
+            int8_t diff_BG = (int8_t) (diff_B - diff_G);
+
+            aEncoderPtr->index_array[hash] = pixel;
+
+            if ( (diff_R >= -2) && (diff_R <= 1) && (diff_G >= -2) && (diff_G <= 1) && (diff_B >= -2) && (diff_B <= 1) )
+            {
+                *aOutPtr++ = (uint8_t) (QOI_OP_DIFF | ((diff_R + 2) << 4) | ((diff_G + 2) << 2) | (diff_B + 2));
+            }
+            else if ( (diff_G >= -32) && (diff_G <= 31) && (diff_RG >= -8) && (diff_RG <= 7) && (diff_BG >= -8) && (diff_BG <= 7) )
+            {
+                aOutPtr[0] = (uint8_t) (QOI_OP_LUMA | (diff_G + 32));
+                aOutPtr[1] = (uint8_t) (((diff_RG + 8) << 4) | (diff_BG + 8));
+                aOutPtr += 2;
+            }
+            else
+            {
+                aOutPtr[0] = QOI_OP_RGB;
+                aOutPtr[1] = aRgbPtr[0];
+                aOutPtr[2] = aRgbPtr[1];
+                aOutPtr[3] = aRgbPtr[2];
+                aOutPtr += 4;
+            }
+        }
+
+        prev_pixel = pixel;
+    }
+
+    aEncoderPtr->prev_pixel = prev_pixel;
+    aEncoderPtr->run_length = run_length;
+
+    return aOutPtr;
+}
+
+
+//=======================================================================================
+// synopsis: result = do_stream_pixels_to_QOI_file(aFramePtr, aRowPtr, aOutPtr, aFilePtr)
+//
+// converts and encodes one row at a time, writes full batches --- returns 0 if OK, else error
+//=======================================================================================
+static int do_stream_pixels_to_QOI_file(const PixelsFrame_t * aFramePtr,
+                                        uint8_t             * aRowPtr,
+                                        uint8_t             * aOutPtr,
+                                        FILE                * aFilePtr)
+{
+    static const uint8_t end_marker[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+    // RGB24 rows --- are encoded from the frame without conversion
+    int is_RGB24 = (aFramePtr->family == e_PIXELS_RGB)                              &&
+                   (aFramePtr->pstrides_array[0] == 3)                              &&
+                   (aFramePtr->comps_array[1] == aFramePtr->comps_array[0] + 1)     &&
+                   (aFramePtr->comps_array[2] == aFramePtr->comps_array[0] + 2);
+
+    QoiEncoder_t encoder;
+
+    uint8_t * out_ptr = aOutPtr;
+
+    int row_index;
+
+    memset(&encoder, 0, sizeof(encoder));
+
+    encoder.prev_pixel = QOI_PACK_RGB(0, 0, 0);
+
+    memcpy(out_ptr, "qoif", 4);
+    out_ptr = do_put_uint32_BE(out_ptr + 4, (uint32_t) aFramePtr->num_cols);
+    out_ptr = do_put_uint32_BE(out_ptr,     (uint32_t) aFramePtr->num_rows);
+    *out_ptr++ = 3;     // channels: RGB
+    *out_ptr++ = 0;     // colorspace: sRGB
+
+    for ( row_index = 0;  row_index < aFramePtr->num_rows;  ++row_index )
+    {
+        const uint8_t * row_ptr = aFramePtr->comps_array[0] + (row_index * aFramePtr->strides_array[0]);
+
+        if (! is_RGB24)
+        {
+            convert_frame_row_to_RGB24(aRowPtr, aFramePtr, row_index);
+
+            row_ptr = aRowPtr;
+        }
+
+        out_ptr = do_encode_RGB24_row(&encoder, row_ptr, aFramePtr->num_cols, out_ptr);
+
+        if (out_ptr - aOutPtr >= QOI_BATCH_BYTES)
+        {
+            if (fwrite(aOutPtr, out_ptr - aOutPtr, 1, aFilePtr) != 1)
+            {
+                return -1;
+            }
+
+            out_ptr = aOutPtr;
+        }
+    }
+
+    if (encoder.run_length > 0)
+    {
+        *out_ptr++ = (uint8_t) (QOI_OP_RUN | (encoder.run_length - 1));
+    }
+
+    memcpy(out_ptr, end_marker, sizeof(end_marker));
+
+    out_ptr += sizeof(end_marker);
+
+    return (fwrite(aOutPtr, out_ptr - aOutPtr, 1, aFilePtr) == 1) ? 0 : -2;
+}
+
+
+//=======================================================================================
+// synopsis: result = save_pixels_as_QOI(aPathPtr, aFramePtr)
+//
+// writes frame to a lossless QOI file (RGB, no alpha) --- returns 0 if OK, else error
+//=======================================================================================
+int save_pixels_as_QOI(const char * aPathPtr, const PixelsFrame_t * aFramePtr)
+{
+    if ( (aPathPtr == NULL) || (aFramePtr == NULL) || (aFramePtr->num_cols < 1) || (aFramePtr->num_rows < 1) )
+    {
+        return -10;
+    }
+
+    int row_stride = aFramePtr->num_cols * 3;
+
+    // a batch may overflow by one encoded row, plus the header and the end marker
+    int  out_lng = QOI_BATCH_BYTES + (aFramePtr->num_cols * QOI_MAX_PIXEL_BYTES) + QOI_HEADER_BYTES + 16;
+
+    uint8_t * row_ptr = malloc(row_stride + out_lng);
+
+    if (row_ptr == NULL)
+    {
+        return -20;
+    }
+
+    // verify the frame's layout before creating the file
+    if (convert_frame_row_to_RGB24(row_ptr, aFramePtr, 0) != aFramePtr->num_cols)
+    {
+        free(row_ptr);
+        return -30;
+    }
+
+    FILE * fp = fopen (aPathPtr, "wb");
+
+    int result = (fp == NULL) ? -40 : do_stream_pixels_to_QOI_file(aFramePtr, row_ptr, row_ptr + row_stride, fp);
+
+    if ( (fp != NULL) && (fclose (fp) != 0) && (result == 0) )
+    {
+        result = -50;
+    }
+
+    free(row_ptr);
+
+    return result;
+}
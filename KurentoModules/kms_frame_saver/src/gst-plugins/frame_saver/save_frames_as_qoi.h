@@ -0,0 +1,39 @@
+/*
+ * ======================================================================================
+ * File:        save_frames_as_qoi.h
+ *
+ * Purpose:     external interface (API) for code in "save_frames_as_qoi.c"
+ *
+ * History:     1. 2026-10-17               Created
+ *
+ * Copyright (c) 2016 TELMATE INC. All Rights Reserved. Proprietary and confidential.
+ *               Unauthorized copying of this file is strictly prohibited.
+ * ======================================================================================
+ */
+
+#ifndef __Save_Frames_As_QOI_H__
+
+#define __Save_Frames_As_QOI_H__
+
+#include "convert_frame_pixels.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+
+//=======================================================================================
+// synopsis: result = save_pixels_as_QOI(aPathPtr, aFramePtr)
+//
+// writes frame to a lossless QOI file (RGB, no alpha) --- returns 0 if OK, else error
+//=======================================================================================
+extern int save_pixels_as_QOI(const char          * aPathPtr,
+                              const PixelsFrame_t * aFramePtr);
+
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+
+#endif // __Save_Frames_As_QOI_H__
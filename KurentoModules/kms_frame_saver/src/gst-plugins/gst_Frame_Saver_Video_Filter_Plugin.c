@@ -53,7 +53,20 @@ typedef enum
     e_PROP_LINK,    // "link=PipelineName,ProducerName,ConsumerName"
     e_PROP_PADS,    // "pads=ProducerOut,ConsumerInput,ConsumerOut"
     e_PROP_PATH,    // "path=PathForWorkingFolderForSavedImageFiles"
+    e_PROP_POOL,    // "pool=NumberOfSharedEncoderThreads"
+    e_PROP_PACE,    // "pace=clock or pace=stream or pace=frames"
+    e_PROP_FMT,     // "fmt=png, fmt=qoi, fmt=gray or fmt=jpeg,Quality or fmt=gray-jpeg,Quality"
+    e_PROP_PNG,     // "png=Level,Filters,Strategy,Strips"
+    e_PROP_SCALE,   // "scale=MaxCols,MaxRows or scale=off"
+    e_PROP_CROP,    // "crop=Left,Top,Cols,Rows or crop=roi or crop=off"
+    e_PROP_REND,    // "rend=Format,Quality,MaxCols,MaxRows,Left,Top,Cols,Rows+... or rend=off"
+    e_PROP_QUEUE,   // "queue=Depth,Policy,BudgetMB"
+    e_PROP_PRIO,    // "prio=WeightOfSharedEncoderThreads"
+    e_PROP_LOAD,    // "load=DeepestLevel,HighMillis,LowMillis or load=off"
+    e_PROP_CPUS,    // "cpus=all, cpus=nodeN or cpus=ListOfEncoderCpus"
+    e_PROP_SCHED,   // "sched=normal, sched=idle or sched=nice,NiceValue"
     e_PROP_NOTE,    // "note=none or note=MostRecentError"
+    e_PROP_STAT,    // "stat=frames:N,snaps:N,...,wait_us:Mean/Max,load:Level,steps:N,shed:N"
     e_PROP_SILENT   // silent=0 or silent=1 --- 1 disables messages
 
 } PLUGIN_PARAMS_e;
@@ -78,13 +91,30 @@ typedef struct _GstFrameSaverPluginPrivate
                  sz_link[100],
                  sz_pads[100],
                  sz_path[300],
+                 sz_pool[30],
+                 sz_pace[30],
+                 sz_fmt[30],
+                 sz_png[50],
+                 sz_scale[30],
+                 sz_crop[60],
+                 sz_rend[220],
+                 sz_queue[60],
+                 sz_prio[30],
+                 sz_load[50],
+                 sz_cpus[220],
+                 sz_sched[30],
                  sz_note[300],
+                 sz_stat[300],
                  sz_caps[300];
+    GstVideoInfo video_info;    // negotiated by set_info --- format is UNKNOWN before
 
 } GstFrameSaverPluginPrivate;
 
-#define VIDEO_SRC_CAPS      GST_VIDEO_CAPS_MAKE("{ BGR }")
-#define VIDEO_SINK_CAPS     GST_VIDEO_CAPS_MAKE("{ BGR }")
+#define VIDEO_RAW_FORMATS   "{ I420, YV12, NV12, NV21, YUY2, UYVY, YVYU, "                  \
+                            "RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, GRAY8 }"
+
+#define VIDEO_SRC_CAPS      GST_VIDEO_CAPS_MAKE(VIDEO_RAW_FORMATS)
+#define VIDEO_SINK_CAPS     GST_VIDEO_CAPS_MAKE(VIDEO_RAW_FORMATS)
 
 extern GType gst_frame_saver_plugin_get_type(void);     // body defined by macro: G_DEFINE_TYPE
 static void  gst_frame_saver_plugin_init (GstFrameSaverPlugin * aPtr);  // initialize instance
@@ -105,9 +135,10 @@ G_DEFINE_TYPE_WITH_CODE (GstFrameSaverPlugin,
 
     extern int Frame_Saver_Filter_Detach(GstElement * pluginPtr);
     extern int Frame_Saver_Filter_Attach(GstElement * pluginPtr);
-    extern int Frame_Saver_Filter_Receive_Buffer(GstElement * pluginPtr, GstBuffer * aBufferPtr, const char * aCapsTextPtr);
+    extern int Frame_Saver_Filter_Receive_Buffer(GstElement * pluginPtr, GstBuffer * aBufferPtr, GstClockTime aRunningTime, const GstVideoInfo * aVideoInfoPtr);
     extern int Frame_Saver_Filter_Transition(GstElement * pluginPtr, GstStateChange aTransition) ;
     extern int Frame_Saver_Filter_Set_Params(GstElement * pluginPtr, const gchar * aNewValuePtr, gchar * aPrvSpecsPtr);
+    extern int Frame_Saver_Filter_Get_Stats(GstElement * pluginPtr, gchar * aBufferPtr, gint aMaxLength);
 
 #else
 
@@ -121,7 +152,7 @@ G_DEFINE_TYPE_WITH_CODE (GstFrameSaverPlugin,
         GST_LOG("%s --- %s \n", THIS_PLUGIN_NAME, __func__);
         return 0;
     }
-    static int Frame_Saver_Filter_Receive_Buffer(GstElement * pluginPtr, GstBuffer * aBufferPtr, const char * aCapsTextPtr)
+    static int Frame_Saver_Filter_Receive_Buffer(GstElement * pluginPtr, GstBuffer * aBufferPtr, GstClockTime aRunningTime, const GstVideoInfo * aVideoInfoPtr)
     {
         GST_LOG("%s --- %s \n", THIS_PLUGIN_NAME, __func__);
         return 0;
@@ -136,6 +167,11 @@ G_DEFINE_TYPE_WITH_CODE (GstFrameSaverPlugin,
         GST_LOG("%s --- %s \n", THIS_PLUGIN_NAME, __func__);
         return 0;
     }
+    static int Frame_Saver_Filter_Get_Stats(GstElement * pluginPtr, gchar * aBufferPtr, gint aMaxLength)
+    {
+        GST_LOG("%s --- %s \n", THIS_PLUGIN_NAME, __func__);
+        return -1;
+    }
 
 #endif
 
@@ -200,6 +236,9 @@ static void gst_frame_saver_plugin_init(GstFrameSaverPlugin * aPluginPtr)
 
     initialize_instance(aPluginPtr, GET_PRIVATE_STRUCT_PTR(aPluginPtr));
 
+    // the filter never modifies frames --- buffers pass through without being mapped
+    gst_base_transform_set_passthrough( GST_BASE_TRANSFORM(aPluginPtr), TRUE );
+
     Frame_Saver_Filter_Attach( GST_ELEMENT(aPluginPtr) );
 
     return;
@@ -248,6 +287,66 @@ static void gst_frame_saver_plugin_set_property(GObject * object, guint prop_id,
         psz_now = ptr_private->sz_path;
         break;
 
+    case e_PROP_POOL:
+        snprintf( ptr_private->sz_pool, sizeof(ptr_private->sz_pool), "pool=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_pool;
+        break;
+
+    case e_PROP_PACE:
+        snprintf( ptr_private->sz_pace, sizeof(ptr_private->sz_pace), "pace=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_pace;
+        break;
+
+    case e_PROP_FMT:
+        snprintf( ptr_private->sz_fmt, sizeof(ptr_private->sz_fmt), "fmt=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_fmt;
+        break;
+
+    case e_PROP_PNG:
+        snprintf( ptr_private->sz_png, sizeof(ptr_private->sz_png), "png=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_png;
+        break;
+
+    case e_PROP_SCALE:
+        snprintf( ptr_private->sz_scale, sizeof(ptr_private->sz_scale), "scale=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_scale;
+        break;
+
+    case e_PROP_CROP:
+        snprintf( ptr_private->sz_crop, sizeof(ptr_private->sz_crop), "crop=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_crop;
+        break;
+
+    case e_PROP_REND:
+        snprintf( ptr_private->sz_rend, sizeof(ptr_private->sz_rend), "rend=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_rend;
+        break;
+
+    case e_PROP_QUEUE:
+        snprintf( ptr_private->sz_queue, sizeof(ptr_private->sz_queue), "queue=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_queue;
+        break;
+
+    case e_PROP_PRIO:
+        snprintf( ptr_private->sz_prio, sizeof(ptr_private->sz_prio), "prio=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_prio;
+        break;
+
+    case e_PROP_LOAD:
+        snprintf( ptr_private->sz_load, sizeof(ptr_private->sz_load), "load=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_load;
+        break;
+
+    case e_PROP_CPUS:
+        snprintf( ptr_private->sz_cpus, sizeof(ptr_private->sz_cpus), "cpus=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_cpus;
+        break;
+
+    case e_PROP_SCHED:
+        snprintf( ptr_private->sz_sched, sizeof(ptr_private->sz_sched), "sched=%s", g_value_get_string(value) );
+        psz_now = ptr_private->sz_sched;
+        break;
+
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -306,11 +405,67 @@ static void gst_frame_saver_plugin_get_property(GObject * object, guint prop_id,
             g_value_set_string(value, ptr_private->sz_path);
             break;
 
+        case e_PROP_POOL:
+            g_value_set_string(value, ptr_private->sz_pool);
+            break;
+
+        case e_PROP_PACE:
+            g_value_set_string(value, ptr_private->sz_pace);
+            break;
+
+        case e_PROP_FMT:
+            g_value_set_string(value, ptr_private->sz_fmt);
+            break;
+
+        case e_PROP_PNG:
+            g_value_set_string(value, ptr_private->sz_png);
+            break;
+
+        case e_PROP_SCALE:
+            g_value_set_string(value, ptr_private->sz_scale);
+            break;
+
+        case e_PROP_CROP:
+            g_value_set_string(value, ptr_private->sz_crop);
+            break;
+
+        case e_PROP_REND:
+            g_value_set_string(value, ptr_private->sz_rend);
+            break;
+
+        case e_PROP_QUEUE:
+            g_value_set_string(value, ptr_private->sz_queue);
+            break;
+
+        case e_PROP_PRIO:
+            g_value_set_string(value, ptr_private->sz_prio);
+            break;
+
+        case e_PROP_LOAD:
+            g_value_set_string(value, ptr_private->sz_load);
+            break;
+
+        case e_PROP_CPUS:
+            g_value_set_string(value, ptr_private->sz_cpus);
+            break;
+
+        case e_PROP_SCHED:
+            g_value_set_string(value, ptr_private->sz_sched);
+            break;
+
         case e_PROP_NOTE:
             g_value_set_string(value, ptr_private->sz_note);
             strcpy(ptr_private->sz_note, "note=none");
             break;
 
+        case e_PROP_STAT:
+            if (Frame_Saver_Filter_Get_Stats(GST_ELEMENT(ptr_filter), ptr_private->sz_stat, sizeof(ptr_private->sz_stat)) < 0)
+            {
+                strcpy(ptr_private->sz_stat, "stat=none");
+            }
+            g_value_set_string(value, ptr_private->sz_stat);
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
             break;
@@ -369,6 +524,18 @@ static gboolean KMS_frame_saver_plugin_start (GstBaseTransform * aTransPtr)
         Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_link, ptr_private->sz_link );
         Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_pads, ptr_private->sz_pads );
         Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_path, ptr_private->sz_path );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_pool, ptr_private->sz_pool );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_pace, ptr_private->sz_pace );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_fmt,  ptr_private->sz_fmt );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_png,  ptr_private->sz_png );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_scale, ptr_private->sz_scale );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_crop,  ptr_private->sz_crop );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_rend,  ptr_private->sz_rend );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_queue, ptr_private->sz_queue );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_prio,  ptr_private->sz_prio );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_load,  ptr_private->sz_load );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_cpus,  ptr_private->sz_cpus );
+        Frame_Saver_Filter_Set_Params( ptr_element, ptr_private->sz_sched, ptr_private->sz_sched );
 
         Frame_Saver_Filter_Transition( ptr_element, GST_STATE_CHANGE_NULL_TO_READY);
     }
@@ -407,11 +574,21 @@ static gboolean KMS_frame_saver_plugin_set_info ( GstVideoFilter  * aFilterPtr,
 
     gchar                      * psz_in_caps = in_caps_ptr ? gst_caps_to_string(in_caps_ptr) : NULL;
 
+    gboolean                  is_first_caps = (ptr_private->video_info.finfo == NULL) ||
+                                              (GST_VIDEO_INFO_FORMAT(&ptr_private->video_info) == GST_VIDEO_FORMAT_UNKNOWN);
+
     snprintf( ptr_private->sz_caps, sizeof(ptr_private->sz_caps), "%s", (psz_in_caps ? psz_in_caps : "") );
 
     g_free(psz_in_caps);
 
-    Frame_Saver_Filter_Transition( GST_ELEMENT(aFilterPtr), GST_STATE_CHANGE_NULL_TO_READY );
+    // frames snapped before a renegotiation keep their own copy of the video info
+    ptr_private->video_info = *in_info_ptr;
+
+    // possibly --- resolution changed mid-stream --- caching the new video info is enough
+    if (is_first_caps)
+    {
+        Frame_Saver_Filter_Transition( GST_ELEMENT(aFilterPtr), GST_STATE_CHANGE_NULL_TO_READY );
+    }
 
     GST_DEBUG_OBJECT (GST_FRAME_SAVER_PLUGIN(aFilterPtr), "set_info");
 
@@ -422,32 +599,33 @@ static gboolean KMS_frame_saver_plugin_set_info ( GstVideoFilter  * aFilterPtr,
 }
 
 
-static GstFlowReturn KMS_frame_saver_plugin_transform_frame_ip(GstVideoFilter * aFilterPtr, GstVideoFrame * aFramePtr)
+// called for every buffer --- in passthrough, hence the buffer is neither mapped nor copied
+static GstFlowReturn KMS_frame_saver_plugin_transform_ip(GstBaseTransform * aTransPtr, GstBuffer * aBufferPtr)
 {
-    GstFrameSaverPlugin        *  ptr_filter = GST_FRAME_SAVER_PLUGIN(aFilterPtr);
+    GstFrameSaverPlugin        *  ptr_filter = GST_FRAME_SAVER_PLUGIN(aTransPtr);
 
     GstFrameSaverPluginPrivate * ptr_private = GET_PRIVATE_STRUCT_PTR(ptr_filter);
 
-    if ( ptr_private->sz_caps[0] == 0 )
-    {
-        GstCaps * caps_ptr = gst_video_info_to_caps ( &aFramePtr->info );
-
-        gchar   * psz_caps = caps_ptr ? gst_caps_to_string(caps_ptr) : NULL;
+    ptr_private->num_buffs += 1;
 
-        g_free(caps_ptr);
+    DBG1_Print( e_DBG_RARE, __func__, ptr_private->num_buffs);
 
-        snprintf( ptr_private->sz_caps, sizeof(ptr_private->sz_caps), "%s", (psz_caps ? psz_caps : "") );
+    GstSegment * segment_ptr = &aTransPtr->segment;
 
-        g_free(psz_caps);
-    }
+    GstClockTime running_time = (segment_ptr->format != GST_FORMAT_TIME) ? GST_CLOCK_TIME_NONE :
+                                gst_segment_to_running_time(segment_ptr, GST_FORMAT_TIME, GST_BUFFER_PTS(aBufferPtr));
 
-    ptr_private->num_buffs += 1;
+    // the frame saver references the buffer when a snap is pending --- it is mapped read-only later
+    Frame_Saver_Filter_Receive_Buffer( GST_ELEMENT(aTransPtr), aBufferPtr, running_time, &ptr_private->video_info );
 
-    DBG1_Print( e_DBG_RARE, __func__, ptr_private->num_buffs);
+    return GST_FLOW_OK;
+}
 
-    Frame_Saver_Filter_Receive_Buffer( GST_ELEMENT(aFilterPtr), aFramePtr->buffer, ptr_private->sz_caps );
 
-    return GST_FLOW_OK;
+// never called while transform_ip is overriden --- GstVideoFilter needs it to call transform_ip on passthrough
+static GstFlowReturn KMS_frame_saver_plugin_transform_frame_ip(GstVideoFilter * aFilterPtr, GstVideoFrame * aFramePtr)
+{
+    return KMS_frame_saver_plugin_transform_ip( GST_BASE_TRANSFORM(aFilterPtr), aFramePtr->buffer );
 }
 
 
@@ -470,6 +648,10 @@ static void gst_frame_saver_plugin_class_init(GstFrameSaverPluginClass * klass)
     video_filter_class_ptr->set_info = GST_DEBUG_FUNCPTR (KMS_frame_saver_plugin_set_info);
     video_filter_class_ptr->transform_frame_ip = GST_DEBUG_FUNCPTR (KMS_frame_saver_plugin_transform_frame_ip);
 
+    // overrides GstVideoFilter's transform_ip, which maps every frame as read-write
+    base_transform_class_ptr->transform_ip = GST_DEBUG_FUNCPTR (KMS_frame_saver_plugin_transform_ip);
+    base_transform_class_ptr->transform_ip_on_passthrough = TRUE;
+
     gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
                                         gst_pad_template_new ("src",
                                                               GST_PAD_SRC,
@@ -522,6 +704,102 @@ static void gst_frame_saver_plugin_class_init(GstFrameSaverPluginClass * klass)
                                                         "auto",
                                                         param_flags));
 
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_POOL,
+                                    g_param_spec_string("pool",
+                                                        "pool=numberOfEncoderThreads",
+                                                        "threads shared by all filters to encode and save frames",
+                                                        "auto",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_PACE,
+                                    g_param_spec_string("pace",
+                                                        "pace=clock-or-stream-or-frames",
+                                                        "snaps are paced by system clock, stream running-time or frames count",
+                                                        "clock",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_FMT,
+                                    g_param_spec_string("fmt",
+                                                        "fmt=png-or-qoi-or-jpeg-or-gray-or-gray-jpeg,quality",
+                                                        "encoder of the saved images --- gray ones save the luma only --- quality (1..100) is for jpeg",
+                                                        "png",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_PNG,
+                                    g_param_spec_string("png",
+                                                        "png=level,filters,strategy,strips",
+                                                        "deflate level (0..9), row filters (e.g. sub+up), strategy (filtered, huffman, rle, fixed) and strips deflated in parallel (1..16) of png images",
+                                                        "auto,auto,auto,auto",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_SCALE,
+                                    g_param_spec_string("scale",
+                                                        "scale=maxcols,maxrows",
+                                                        "saved images are scaled down to fit maxcols x maxrows (0 is unbounded), keeping the aspect ratio --- off saves full-size images",
+                                                        "off",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_CROP,
+                                    g_param_spec_string("crop",
+                                                        "crop=left,top,cols,rows",
+                                                        "saved images are cropped to a rectangle (0 cols or rows reach the frame's edge) before scaling --- roi follows the region-of-interest meta of each frame, off saves whole frames",
+                                                        "off",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_REND,
+                                    g_param_spec_string("rend",
+                                                        "rend=format,quality,maxcols,maxrows,left,top,cols,rows+...",
+                                                        "up to 3 more images of each snap (e.g. jpeg,60,320 for a preview), encoded in parallel from the same mapped frame --- numbers are optional, off saves one image per snap",
+                                                        "off",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_QUEUE,
+                                    g_param_spec_string("queue",
+                                                        "queue=depth,policy,budgetmb",
+                                                        "pending frames of each image (0 is bounded by the pool), what a full queue drops (drop-newest, drop-oldest or latest) and megabytes of pending frames of all instances (0 is unbounded) --- drops are counted in stat",
+                                                        "auto,auto,auto",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_PRIO,
+                                    g_param_spec_string("prio",
+                                                        "prio=weight",
+                                                        "share of the shared encoder threads, 1..16 (auto is 1) --- an instance of weight 2 encodes twice the bytes of an instance of weight 1 when both have frames waiting, the waits are reported in stat",
+                                                        "auto",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_LOAD,
+                                    g_param_spec_string("load",
+                                                        "load=level,highms,lowms",
+                                                        "under overload the snaps are degraded step by step, down to level: effort (cheaper encoding), scale (half size), stretch (twice the snap interval) or shed (3 of 4 snaps skipped) --- steps up when the queues back up or an image takes over highms (auto is the snap interval), down when calm below lowms (auto is half of highms), the level is reported in stat, off disables",
+                                                        "off",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_CPUS,
+                                    g_param_spec_string("cpus",
+                                                        "cpus=list",
+                                                        "CPUs of the shared encoder threads, of all instances --- a list as 0-3,8 or nodeN for the CPUs of NUMA node N, whose memory then holds the encoders' buffers; all (default) runs them on the CPUs of the process",
+                                                        "all",
+                                                        param_flags));
+
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_SCHED,
+                                    g_param_spec_string("sched",
+                                                        "sched=class,nice",
+                                                        "scheduling of the shared encoder threads, of all instances --- normal (default) is the process's nice value, nice,N runs them at nice value N (1..19, default 10), idle runs them only when a CPU has nothing else to run; never real-time",
+                                                        "normal",
+                                                        param_flags));
+
     g_object_class_install_property(gobject_class_ptr,
                                     e_PROP_NOTE,
                                     g_param_spec_string("note",
@@ -530,6 +808,14 @@ static void gst_frame_saver_plugin_class_init(GstFrameSaverPluginClass * klass)
                                                         "none",
                                                         G_PARAM_READABLE));
 
+    g_object_class_install_property(gobject_class_ptr,
+                                    e_PROP_STAT,
+                                    g_param_spec_string("stat",
+                                                        "stat=countersOfFramesSnapsAndTimers",
+                                                        "frames and snaps counters, and lateness of snap timers",
+                                                        "none",
+                                                        G_PARAM_READABLE));
+
     g_object_class_install_property(gobject_class_ptr,
                                     e_PROP_SILENT,
                                     g_param_spec_boolean("silent",
@@ -600,9 +886,24 @@ static void initialize_instance(GstFrameSaverPlugin * aPluginPtr, GstFrameSaverP
     strcpy(aPrivatePtr->sz_link, "link=Live,auto,auto");
     strcpy(aPrivatePtr->sz_pads, "pads=auto,auto,auto");
     strcpy(aPrivatePtr->sz_path, "path=auto");
+    strcpy(aPrivatePtr->sz_pool, "pool=auto");
+    strcpy(aPrivatePtr->sz_pace, "pace=clock");
+    strcpy(aPrivatePtr->sz_fmt,  "fmt=png");
+    strcpy(aPrivatePtr->sz_png,  "png=auto,auto,auto,auto");
+    strcpy(aPrivatePtr->sz_scale, "scale=off");
+    strcpy(aPrivatePtr->sz_crop,  "crop=off");
+    strcpy(aPrivatePtr->sz_rend,  "rend=off");
+    strcpy(aPrivatePtr->sz_queue, "queue=auto,auto,auto");
+    strcpy(aPrivatePtr->sz_prio,  "prio=auto");
+    strcpy(aPrivatePtr->sz_load,  "load=off");
+    strcpy(aPrivatePtr->sz_cpus,  "cpus=all");
+    strcpy(aPrivatePtr->sz_sched, "sched=normal");
     strcpy(aPrivatePtr->sz_note, "note=none");
+    strcpy(aPrivatePtr->sz_stat, "stat=none");
     strcpy(aPrivatePtr->sz_caps, "");
 
+    gst_video_info_init(&aPrivatePtr->video_info);
+
     aPrivatePtr->num_buffs = 0;
     aPrivatePtr->num_drops = 0;
     aPrivatePtr->num_notes = 0;
@@ -705,12 +1006,17 @@ static GstFlowReturn gst_frame_saver_plugin_chain(GstPad * pad, GstObject * pare
 
             snpritf(ptr_private->sz_caps, sizeof(ptr_private->sz_caps), "%s", psz_caps ? psz_caps : "");
 
+            if (caps_ptr != NULL)
+            {
+                gst_video_info_from_caps(&ptr_private->video_info, caps_ptr);
+            }
+
             gst_object_unref(caps_ptr);
 
             g_free(psz_caps);
         }
 
-        Frame_Saver_Filter_Receive_Buffer(GST_ELEMENT(ptr_filter), buf, ptr_private->sz_caps);
+        Frame_Saver_Filter_Receive_Buffer(GST_ELEMENT(ptr_filter), buf, GST_CLOCK_TIME_NONE, &ptr_private->video_info);
     }
 
     return result;  // anythin except GST_FLOW_OK could halt flow in the pipeline
@@ -180,7 +180,7 @@ std::string FrameSaverVideoFilterImpl::getElementsNamesList()
 
 std::string FrameSaverVideoFilterImpl::getParamsList()
 {
-    static const char * names[] = { "wait", "snap", "link", "pads", "path", "note", NULL };
+    static const char * names[] = { "wait", "snap", "link", "pads", "path", "pool", "pace", "fmt", "png", "scale", "crop", "rend", "queue", "prio", "load", "cpus", "sched", "note", "stat", NULL };
 
     std::string  params_separated_by_tabs;
 